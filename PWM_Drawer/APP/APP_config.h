@@ -13,22 +13,172 @@
 
 /*Timers configurations-----------------------------------------------------*/
 #define APP_TIM_PWM_TIMx (TIM2)
-#define APP_TIM_PWM_CHx  (TIM_CH3)
+#define APP_TIM_PWM_CHx  (TIM_CH3)   // Sequences are played on SEQ_TIMx/SEQ_TIM_CHx, keep them the same
+
+/* Half-bridge output: TIM1 CH1 on PA8 and CH1N on PB13, break input on PB12. CH2 (PA9)
+ * and CH3 (PA10) are taken by USART1 and the GLCD. TIM1 also paces the analog sampling
+ * and times the autoset gates, which are refused while the half bridge runs. */
+#define APP_HB_TIMx  (TIM1)
+#define APP_HB_CHx   (TIM_CH1)
+#define APP_HB_BREAK (TIM_BREAK_ACTIVE_LOW)
 
 #define APP_TIM_IC_TIMx (TIM3)
 #define APP_TIM_IC_CH1  (TIM_CH1)
 #define APP_TIM_IC_CH2  (TIM_CH2)
 
+/*Interrupt priorities configurations------------------------------------------*/
+/* Preemption priorities only (NVIC_GROUP_PRE16_SUB1), 0 is the most urgent. The capture
+ * interrupts preempt the gate and the analog sampling and sequence DMA interrupts, so the
+ * edge latency does not depend on what the display is doing. TIM2 and TIM3 serve all
+ * their events on one line, a capture timer takes the capture priority. */
+#define APP_IRQ_PRIO_CAPTURE (1U)
+#define APP_IRQ_PRIO_GATE    (2U)
+#define APP_IRQ_PRIO_DMA     (3U)
+#define APP_IRQ_PRIO_TICK    (4U)       // Millisecond tick, only advances the scheduler time
+
+/*Scheduler configurations-----------------------------------------------------*/
+/* Periodic tasks run from APP_Run, called by the main loop */
+#define APP_DISPLAY_PERIOD_MS (100UL)   // GLCD refresh at 10 Hz, faster than the digits can be read
+#define APP_LOAD_PERIOD_MS    (1000UL)  // Interrupt load and overcaptures checked every second
+#define APP_TLM_PERIOD_MS     (10UL)    // Partial telemetry frames sent at least every 10 ms
+#define APP_SCREEN_PERIOD_MS  (10UL)    // A screenshot line sent every 10 ms, 80 ms per screenshot
+
+/*Telemetry configurations------------------------------------------------------*/
+/* Capture records of the measurement channels streamed in TLM frames on USART1 TX (PA9),
+ * decoded on the host by Tools/TlmDecode. 3 Mbit/s divides the 72 MHz APB2 clock exactly
+ * and carries about 30000 records per second. */
+#define APP_TLM_USARTx      (USART1)
+#define APP_TLM_BAUD        (3000000UL)
+#define APP_TLM_INFO_PERIOD (100U)     // Telemetry task runs between two information frames
+
+/*Screenshot configurations-----------------------------------------------------*/
+/* APP_Screenshot sends the GLCD lines, read from the shadow copy of the driver, in the same
+ * stream. Tools/TlmDecode writes each complete screenshot to a PBM file. */
+#define APP_SCREEN_LINE_COUNT (GLCD_LINE_7 + 1U)
+
+/*Load meter configurations-----------------------------------------------------*/
+/* The PWM view warns on APP_STATUS_LINE when a measurement channel lost captures (CCxOF)
+ * or the interrupts take APP_LOAD_WARN_PERMILLE or more of the core */
+#define APP_LOAD_WARN_PERMILLE (800U)
+#define APP_STATUS_LINE        (GLCD_LINE_4)
+#define APP_LOAD_VALUE_X       (63U)
+
+/*Measurement channels configurations------------------------------------------*/
+/* Every channel is a (timer, rising edge channel, falling edge channel) set measured
+ * concurrently. Channel APP_MEAS_MAIN_CH is shown on the PWM and histogram views.
+ * An indirect falling edge channel reads the pin of the rising edge channel.
+ * TIM1 paces the analog sampling (SCOPE_TRIG_TIMx), a { TIM1, TIM_CH1, TIM_CH2,
+ * CCS_IP_INDIRECT } channel on PA8 can be added when the analog view is not used. */
+#define APP_MEAS_CH_COUNT (2U)
+#define APP_MEAS_MAIN_CH  (0U)
+
+#define APP_MEAS_CH_CONFIG \
+{ \
+	{ APP_TIM_IC_TIMx, APP_TIM_IC_CH1, APP_TIM_IC_CH2, CCS_IP_DIRECT },   /* PA6, PA7 */ \
+	{ TIM3,            TIM_CH3,        TIM_CH4,        CCS_IP_INDIRECT }, /* PB0 */      \
+}
+
 /*GLCD configurations-----------------------------------------------------*/
 #define APP_GLCD_LOW_LINE  (GLCD_LINE_7)
 #define APP_GLCD_HIGH_LINE (GLCD_LINE_5)
 
-#define APP_GLCD_CYCLE_1_START_X  (7UL)
-#define APP_GLCD_CYCLE_2_START_X  (APP_GLCD_CYCLE_1_START_X + 60UL)
-#define APP_GLCD_CYCLE_2_END_X    (127UL)
 
 # define APP_GLCD_FREQ_LINE   (GLCD_LINE_0)
 # define APP_GLCD_DUTY_LINE   (GLCD_LINE_1)
 # define APP_GLCD_PERIOD_LINE (GLCD_LINE_2)
 
+#define APP_GLCD_WIDTH (128U)
+#define APP_GLCD_CHAR_WIDTH (7U)   // Pixels per character of the GLCD font
+
+/*Timebase configurations-----------------------------------------------------*/
+/* The PWM view maps the captured period and high time of the main channel to
+ * pixels: column x shows the time position + x * timePerDiv / APP_TIMEBASE_DIV_WIDTH
+ * after a rising edge. */
+#define APP_TIMEBASE_LINE       (GLCD_LINE_3)
+#define APP_TIMEBASE_DIV_WIDTH  (16U)       // Pixels per division, 8 divisions across the GLCD
+#define APP_TIMEBASE_DEFAULT_US (500UL)     // Time per division at start-up
+#define APP_TIMEBASE_MIN_US     (2UL)       // 125 ns per pixel
+#define APP_TIMEBASE_MAX_US     (100000UL)
+
+/*Autoset configurations-----------------------------------------------------*/
+/* APP_Autoset counts the main channel input edges over a probe gate (external clock on its
+ * rising edge channel, CH1 or CH2), then captures bursts of periods. The gate timer also
+ * times the gated mode; it paces the analog sampling too, so both cannot run together. */
+#define APP_AUTOSET_GATE_TIMx        (TIM1)
+#define APP_AUTOSET_PROBE_GATE_US    (10000UL)
+#define APP_AUTOSET_BURST_CAPTURES   (4UL)      // Periods captured before a burst ends early
+#define APP_AUTOSET_SLICE_US         (10000UL)  // Burst progress checked every slice
+#define APP_AUTOSET_BURST_TIMEOUT_US (500000UL) // Inputs below ~4 Hz are reported as no signal
+#define APP_AUTOSET_MAX_BURSTS       (2U)       // Autoset completes within about 1 s
+#define APP_AUTOSET_POLL_GUARD       (1000000UL)// Polling iterations before a gate is considered lost
+
+/*Split view configurations-----------------------------------------------------*/
+#define APP_SPLIT_LINES_PER_CH (8U / APP_MEAS_CH_COUNT)  // Text line + waveform line(s) per channel
+#define APP_SPLIT_CYCLE_WIDTH  (32U)                     // Width in pixels of a waveform cycle
+
+/*Phase view configurations-----------------------------------------------------*/
+/* Phase and delay are measured between two measurement channels captured on the same timer */
+#define APP_PHASE_CH_A (0U)    // Reference input
+#define APP_PHASE_CH_B (1U)
+
+#define APP_PHASE_DELAY_LINE  (GLCD_LINE_0)
+#define APP_PHASE_DEG_LINE    (GLCD_LINE_1)
+#define APP_PHASE_WAVE_A_LINE (GLCD_LINE_3)
+#define APP_PHASE_WAVE_B_LINE (GLCD_LINE_5)
+#define APP_PHASE_CYCLE_WIDTH (64U)
+
+/*Logic analyzer configurations-------------------------------------------------*/
+/* Raw edges of the main measurement channel input are recorded until the buffer is full */
+#define APP_LA_BUFFER_SIZE (256U)  // Number of edge time stamps (u16) recorded
+
+#define APP_LA_TITLE_LINE (GLCD_LINE_0)
+#define APP_LA_SPAN_LINE  (GLCD_LINE_1)
+#define APP_LA_HIGH_Y     (24U)    // Pixel row of the high level
+#define APP_LA_LOW_Y      (55U)    // Pixel row of the low level
+#define APP_LA_TRIG_MARK_Y (18U)   // Pixel row of the top of the trigger marker
+
+#define APP_LA_PRETRIGGER_PERCENT (50U)  // Share of the triggered record kept before the trigger
+
+#if (APP_MEAS_CH_COUNT > 4)
+#error "The split view fits at most 4 measurement channels"
+#endif
+
+/*Analog view configurations-----------------------------------------------------*/
+/* Frames of the SCOPE module (analog input on PA1) drawn as min/max spans per column */
+#define APP_SCOPE_TITLE_LINE (GLCD_LINE_0)
+#define APP_SCOPE_FIRST_LINE (GLCD_LINE_1)
+#define APP_SCOPE_TOP_Y      (8U)     // Pixel row of the full scale sample
+#define APP_SCOPE_BOTTOM_Y   (63U)    // Pixel row of the zero sample
+
+/*Sweep view configurations-----------------------------------------------------*/
+/* APP_SWEEP_Run needs the PWM output (PA2) wired to the main measurement channel input (PA6) */
+#define APP_SWEEP_TITLE_LINE (GLCD_LINE_0)
+#define APP_SWEEP_FIRST_LINE (GLCD_LINE_1)
+#define APP_SWEEP_ROWS       (7U)     // Points per page, one per line
+#define APP_SWEEP_DUTY_X     (42U)    // Columns of a row: frequency in Hz at 0, duty cycle in %,
+#define APP_SWEEP_COL1_X     (63U)    // frequency error or cycles per interrupt,
+#define APP_SWEEP_COL2_X     (98U)    // duty cycle error or missed periods
+
+/*Profiling view configurations--------------------------------------------------*/
+/* Two lines per region of DWT_config.h: its name and runs, then min, mean and max cycles */
+#define APP_PROF_FIRST_LINE (GLCD_LINE_0)
+#define APP_PROF_CALLS_X    (70U)
+#define APP_PROF_MEAN_X     (42U)
+#define APP_PROF_MAX_X      (84U)
+
+/*Histogram configurations-----------------------------------------------------*/
+#define APP_HIST_PERIOD_BINS      (32U)
+#define APP_HIST_PERIOD_MIN_TICKS (0UL)
+#define APP_HIST_PERIOD_BIN_TICKS (2048UL)  // 32 bins x 2048 ticks cover the whole 16-bit capture range
+
+#define APP_HIST_DUTY_BINS      (26U)
+#define APP_HIST_DUTY_MIN       (0UL)
+#define APP_HIST_DUTY_BIN_WIDTH (400UL)     // 26 bins x 4.00% (0.01% units) cover 0-100%
+
+#define APP_HIST_TITLE_LINE   (GLCD_LINE_0)
+#define APP_HIST_CHART_WIDTH  (128U)
+#define APP_HIST_CHART_TOP_Y  (8U)          // First pixel row of the bar chart (GLCD_LINE_1)
+#define APP_HIST_CHART_BOTTOM_Y (63U)       // Last pixel row of the bar chart
+#define APP_HIST_REDRAW_COUNT (64UL)        // New samples needed before the chart is redrawn
+
 #endif /* APP_CONFIG_H_ */
@@ -9,10 +9,70 @@
 #define APP_INTERFACE_H_
 
 #include "STD_TYPES.h"
+#include "../MCAL/TIM/TIM_interface.h"
+#include "../SERV/MEAS/MEAS_interface.h"
+#include "../SERV/PHASE/PHASE_interface.h"
+#include "../SERV/EDGE/EDGE_interface.h"
+#include "../SERV/SCOPE/SCOPE_interface.h"
+#include "../SERV/AUTO/AUTO_interface.h"
+#include "../SERV/SEQ/SEQ_interface.h"
+#include "../SERV/SWEEP/SWEEP_interface.h"
+#include "../SERV/SCHED/SCHED_interface.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef APP_View_t
+ * @brief Enumeration of the GLCD views.
+ */
+typedef enum
+{
+	APP_VIEW_PWM = 0,     /*!< Frequency, duty, period and PWM waveform */
+	APP_VIEW_HIST_PERIOD, /*!< Histogram of the captured periods */
+	APP_VIEW_HIST_DUTY,   /*!< Histogram of the captured duty cycles */
+	APP_VIEW_SPLIT,       /*!< Frequency, duty and waveform of all measurement channels */
+	APP_VIEW_PHASE,       /*!< Delay and phase between two measurement channels */
+	APP_VIEW_LA,          /*!< Raw edges recorded by the logic analyzer */
+	APP_VIEW_ANALOG,      /*!< Samples of the analog input */
+	APP_VIEW_SWEEP,       /*!< Results of the last loopback sweep */
+	APP_VIEW_PROF,        /*!< Cycle counts of the profiled regions */
+	APP_VIEW_LOAD         /*!< Interrupt load and overcaptures of the measurement channels */
+}APP_View_t;
+
+/**
+ * @typedef APP_SweepColumns_t
+ * @brief Enumeration of the result columns shown by the sweep view.
+ */
+typedef enum
+{
+	APP_SWEEP_COLS_ERROR = 0, /*!< Frequency error in ppm and duty cycle error in 0.01% */
+	APP_SWEEP_COLS_LOAD       /*!< Cycles per capture interrupt and missed periods */
+}APP_SweepColumns_t;
+
+/**
+ * @typedef APP_AutosetStatus_t
+ * @brief Enumeration of autoset results.
+ */
+typedef enum
+{
+	APP_AUTOSET_OK = 0,     /*!< Setting applied */
+	APP_AUTOSET_BUSY,       /*!< Analog sampling, logic analyzer or half bridge running, or gate timer used by a channel */
+	APP_AUTOSET_NO_SIGNAL   /*!< No period captured, default reciprocal setting applied */
+}APP_AutosetStatus_t;
+
+/**
+ * @typedef APP_Event_t
+ * @brief Enumeration of the events posted by the interrupts to the main loop.
+ */
+typedef enum
+{
+	APP_EVENT_CAPTURE = 0, /*!< Period captured on a measurement channel */
+	APP_EVENT_GATE,        /*!< Gated count of the main channel completed */
+	APP_EVENT_COUNT
+}APP_Event_t;
 
 /* Exported functions --------------------------------------------------------*/
 /**
- * @brief  Initializes the GLCD and timers used for PWM and input capture.
+ * @brief  Initializes the system clock, the GLCD and timers used for PWM and input capture.
  * @param  None
  * @retval None
  */
@@ -29,6 +89,57 @@ void APP_IC_Start(void);
  * @retval None
  */
 void APP_PWM_Start(u32 dutyCycle, u32 frequency);
+/**
+ * @brief  Starts the PWM output with a fine frequency and duty cycle.
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  duty : Desired high time in 0.01% units (0 to TIM_DUTY_FULL).
+ * @param  achieved : Pointer to the setting to be filled with the achieved values, may be 0.
+ * @retval 1 if started, 0 if the frequency is out of range
+ */
+u8 APP_PWM_StartFine(u32 frequency_mHz, u32 duty, TIM_PWM_Setting_t *achieved);
+/**
+ * @brief  Plays a table of compare values on the PWM output started by APP_PWM_StartFine, one per period.
+ * @param  compares : Table of compare values, see SEQ_DutyToCompare.
+ * @param  count : Number of steps in the table.
+ * @param  mode : SEQ_MODE_ONESHOT or SEQ_MODE_LOOP.
+ * @retval None
+ */
+void APP_PWM_StartSequence(const u16 *compares, u16 count, SEQ_Mode_t mode);
+/**
+ * @brief  Stops the sequence played on the PWM output, which keeps its last duty cycle.
+ * @param  None
+ * @retval None
+ */
+void APP_PWM_StopSequence(void);
+/**
+ * @brief  Starts the complementary half-bridge output pair with dead time and break input.
+ * @note   Refused while TIM1 is used by the analog sampling, the gated mode or a measurement channel.
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  duty : Desired duty cycle of the high side, dead time included, in 0.01% units.
+ * @param  deadTime_ns : Delay before each output turns on, up to 1008 TIM1 clock cycles.
+ * @param  achievedDeadTime_ns : Pointer to the achieved dead time in ns to be filled, may be 0.
+ * @retval 1 if started, 0 if TIM1 is busy or a value is out of range
+ */
+u8 APP_HB_Start(u32 frequency_mHz, u32 duty, u32 deadTime_ns, u32 *achievedDeadTime_ns);
+/**
+ * @brief  Stops the half-bridge output pair, both outputs are driven low.
+ * @param  None
+ * @retval None
+ */
+void APP_HB_Stop(void);
+/**
+ * @brief  Enables the half-bridge outputs again after a break.
+ * @param  None
+ * @retval 1 if the outputs are enabled, 0 if the break input is still active
+ */
+u8 APP_HB_Resume(void);
+/**
+ * @brief  Returns the dead time between the high side falling and the low side rising edges,
+ *         measured with the high side wired to APP_PHASE_CH_A and the low side to APP_PHASE_CH_B.
+ * @param  None
+ * @retval Dead time in ns, 0 if not measured
+ */
+u32 APP_HB_GetDeadTime_ns(void);
 /**
  * @brief  Prints on GLCD the initial frequency, duty, period, and draws initial PWM signal
  * @param  None
@@ -41,5 +152,166 @@ void APP_GLCD_Print_Init();
  * @retval None
  */
 void APP_GLCD_Update();
+/**
+ * @brief  Processes the posted events and runs the periodic tasks that are due (GLCD refresh),
+ *         then sleeps until the next interrupt when nothing is left to do. To be called from the main loop.
+ * @param  None
+ * @retval None
+ */
+void APP_Run(void);
+/**
+ * @brief  Selects the view shown on the GLCD and redraws the screen.
+ * @param  view : View to be shown (from @ref APP_View_t)
+ * @retval None
+ */
+void APP_SetView(APP_View_t view);
+/**
+ * @brief  Clears the period and duty cycle histograms.
+ * @param  None
+ * @retval None
+ */
+void APP_HIST_Reset(void);
+/**
+ * @brief  Returns a measurement channel, giving access to its results and ring buffer.
+ * @param  index : Index of the channel in APP_MEAS_CH_CONFIG
+ * @retval Pointer to the measurement channel, 0 if the index is out of range
+ */
+MEAS_Channel_t* APP_MEAS_GetChannel(u8 index);
+/**
+ * @brief  Returns the captures of a measurement channel overwritten before they were served.
+ * @param  index : Index of the channel in APP_MEAS_CH_CONFIG
+ * @retval Overcaptures of the rising edge channel since reset, 0 if the index is out of range
+ */
+u32 APP_MEAS_GetOvercaptures(u8 index);
+/**
+ * @brief  Returns the share of the core spent in the interrupt handlers over the last APP_LOAD_PERIOD_MS.
+ * @param  peak : Pointer to the highest share measured to be filled, may be 0
+ * @retval Load in 0.1%
+ */
+u16 APP_ISR_GetLoad(u16 *peak);
+/**
+ * @brief  Checks whether the measurements of the last APP_LOAD_PERIOD_MS can't be trusted:
+ *         captures were overwritten or the interrupt load reached APP_LOAD_WARN_PERMILLE.
+ * @param  None
+ * @retval 1 if overloaded, 0 otherwise
+ */
+u8 APP_IsOverloaded(void);
+/**
+ * @brief  Returns the phase/delay measurement between the APP_PHASE_CH_A and APP_PHASE_CH_B inputs.
+ * @param  None
+ * @retval Pointer to the phase measurement, 0 if the inputs are not captured on the same timer
+ */
+PHASE_t* APP_PHASE_GetMeasurement(void);
+/**
+ * @brief  Starts a logic analyzer record of the raw edges of the main measurement channel.
+ * @note   The main channel measurement is suspended until the record buffer is full.
+ * @param  None
+ * @retval None
+ */
+void APP_LA_Start(void);
+/**
+ * @brief  Starts a continuous logic analyzer record of the main measurement channel that is
+ *         frozen around the first edge meeting the trigger condition.
+ * @note   APP_LA_PRETRIGGER_PERCENT of the record is kept before the trigger edge.
+ *         The main channel measurement is suspended until the record is frozen.
+ * @param  trigger : Pointer to the trigger condition (times in timer ticks)
+ * @retval None
+ */
+void APP_LA_StartTriggered(const EDGE_Trigger_t *trigger);
+/**
+ * @brief  Returns the logic analyzer record.
+ * @param  None
+ * @retval Pointer to the edge capture record
+ */
+const EDGE_Capture_t* APP_LA_GetRecord(void);
+/**
+ * @brief  Starts the analog sampling shown on the analog view.
+ * @note   Refused if a measurement channel uses the SCOPE trigger timer, in gated mode, or while the half bridge runs.
+ * @param  sampleRate : Requested sample rate in Hz
+ * @retval Achieved sample rate in Hz, 0 if refused
+ */
+u32 APP_SCOPE_Start(u32 sampleRate);
+/**
+ * @brief  Stops the analog sampling.
+ * @param  None
+ * @retval None
+ */
+void APP_SCOPE_Stop(void);
+/**
+ * @brief  Sets the time per division of the PWM view.
+ * @param  timePerDiv_us : Time per division in us (APP_TIMEBASE_MIN_US to APP_TIMEBASE_MAX_US)
+ * @retval None
+ */
+void APP_SetTimebase(u32 timePerDiv_us);
+/**
+ * @brief  Sets the horizontal position of the PWM view.
+ * @param  positionTime_us : Time in us between a rising edge and the left border of the GLCD
+ * @retval None
+ */
+void APP_SetPosition(u32 positionTime_us);
+/**
+ * @brief  Returns the time per division of the PWM view.
+ * @param  None
+ * @retval Time per division in us
+ */
+u32 APP_GetTimebase(void);
+/**
+ * @brief  Probes the main measurement channel input and selects its capture prescaler,
+ *         measurement mode and the timebase of the PWM view, within about 1 s.
+ * @note   In gated mode only the frequency of the main channel is measured: the capture
+ *         interrupts of its timer are masked and the duty cycle reads 0.
+ * @param  result : Pointer to the setting to be filled, may be 0
+ * @retval Autoset status from @ref APP_AutosetStatus_t
+ */
+APP_AutosetStatus_t APP_Autoset(AUTO_Setting_t *result);
+/**
+ * @brief  Sweeps the PWM output across the SWEEP_FREQS_MHZ frequencies and SWEEP_DUTIES duty cycles
+ *         and measures every point on the main measurement channel, looped back to the output.
+ * @note   Blocking for about 0.2 s per point: every point runs APP_Autoset, then collects the
+ *         captures over SWEEP_WINDOW_US. The output keeps the last point.
+ * @param  None
+ * @retval Number of points measured, 0 if the analog sampling, logic analyzer or half bridge is running
+ */
+u8 APP_SWEEP_Run(void);
+/**
+ * @brief  Returns the results of the last sweep, to be exported with SWEEP_FormatCsv.
+ * @param  count : Pointer to the number of points to be filled (0 if no sweep ran).
+ * @retval Pointer to the first point
+ */
+const SWEEP_Point_t* APP_SWEEP_GetResults(u8 *count);
+/**
+ * @brief  Selects the page and columns of the sweep view, redrawn if shown.
+ * @param  page : Page of APP_SWEEP_ROWS points, wraps around after the last one
+ * @param  columns : Result columns (from @ref APP_SweepColumns_t)
+ * @retval None
+ */
+void APP_SWEEP_SetPage(u8 page, APP_SweepColumns_t columns);
+/**
+ * @brief  Starts streaming the capture records of the measurement channels on APP_TLM_USARTx,
+ *         an information frame is sent first and every APP_TLM_INFO_PERIOD task runs.
+ * @param  None
+ * @retval None
+ */
+void APP_TLM_Start(void);
+/**
+ * @brief  Stops adding records to the telemetry stream, the frames already closed are still sent.
+ * @param  None
+ * @retval None
+ */
+void APP_TLM_Stop(void);
+/**
+ * @brief  Returns the records dropped because the link could not keep up.
+ * @param  None
+ * @retval Records lost since APP_Init
+ */
+u32 APP_TLM_GetLost(void);
+/**
+ * @brief  Starts a screenshot: the GLCD lines are sent in TLM screen frames on APP_TLM_USARTx,
+ *         one every APP_SCREEN_PERIOD_MS when the link has room. The display is not refreshed
+ *         until the last line is sent.
+ * @param  None
+ * @retval 1 if the screenshot was started, 0 if one is being sent or the GLCD has no shadow copy
+ */
+u8 APP_Screenshot(void);
 
 #endif /* APP_INTERFACE_H_ */
@@ -8,26 +8,106 @@
 /* Includes ------------------------------------------------------------------*/
 #include "BIT_MATH.h"
 
+#include "../MCAL/RCC/RCC_interface.h"
+#include "../MCAL/NVIC/NVIC_interface.h"
+#include "../MCAL/DWT/DWT_interface.h"
+#include "../MCAL/STK/STK_interface.h"
 #include "../MCAL/TIM/TIM_interface.h"
+#include "../MCAL/USART/USART_interface.h"
 #include "../HAL/GLCD/GLCD_interface.h"
 #include "../MCAl/GPIO/GPIO_interface.h"
+#include "../SERV/HIST/HIST_interface.h"
+#include "../SERV/MEAS/MEAS_interface.h"
+#include "../SERV/PHASE/PHASE_interface.h"
+#include "../SERV/EDGE/EDGE_interface.h"
+#include "../SERV/SCOPE/SCOPE_interface.h"
+#include "../SERV/DECIM/DECIM_interface.h"
+#include "../SERV/AUTO/AUTO_interface.h"
+#include "../SERV/SEQ/SEQ_interface.h"
+#include "../SERV/SWEEP/SWEEP_interface.h"
+#include "../SERV/SCHED/SCHED_interface.h"
+#include "../SERV/TLM/TLM_interface.h"
 
 #include "APP_interface.h"
 #include "APP_config.h"
 
 /* Private functions prototypes ----------------------------------------------*/
 /**
- * @brief  Calculates frequency and duty cycle based on captured timer values.
+ * @brief  Capture event callback of a measurement channel, calculates its frequency and duty cycle.
+ * @param  context : Pointer to the measurement channel.
+ * @param  capture : Rising edge captured on the period channel.
+ * @retval None
+ */
+static void APP_IC_Capture_Callback(void *context, u32 capture);
+/**
+ * @brief  Gate timer update callback of the gated mode, counts the main channel edges of the last gate.
+ * @param  context : Unused.
+ * @param  value : Unused.
+ * @retval None
+ */
+static void APP_IC_Gate_Callback(void *context, u32 value);
+/**
+ * @brief  Checks whether a measurement channel is captured on a timer.
+ * @param  TIMx : Pointer to the timer peripheral.
+ * @retval 1 if the timer is used, 0 otherwise
+ */
+static u8 APP_IC_IsTimerUsed(volatile TIM_TypeDef *TIMx);
+/**
+ * @brief  Enables or disables the capture interrupts of the measurement channels of a timer.
+ * @param  TIMx : Pointer to the timer peripheral.
+ * @param  status : Interrupt status (TIM_INT_ENABLE or TIM_INT_DISABLE)
+ * @retval None
+ */
+static void APP_IC_SetCaptureInterrupts(volatile TIM_TypeDef *TIMx, TIM_INT_Status_t status);
+/**
+ * @brief  Applies a reciprocal mode setting to the timer of the main channel and the channels sharing it.
+ * @param  setting : Pointer to the setting
+ * @retval None
+ */
+static void APP_IC_ApplySetting(const AUTO_Setting_t *setting);
+/**
+ * @brief  Counts the main channel edges over gates of the gate timer.
+ * @param  setting : Pointer to a gated mode setting
+ * @retval None
+ */
+static void APP_IC_StartGated(const AUTO_Setting_t *setting);
+/**
+ * @brief  Stops the gated mode, the main channel timer is clocked internally again.
+ * @param  None
+ * @retval None
+ */
+static void APP_IC_StopGated(void);
+/**
+ * @brief  Returns to reciprocal mode capturing every rising edge of the main channel.
+ * @param  None
+ * @retval None
+ */
+static void APP_IC_ResetCapturePrescaler(void);
+/**
+ * @brief  Waits for the next update event of the gate timer, bounded by APP_AUTOSET_POLL_GUARD.
+ * @param  None
+ * @retval None
+ */
+static void APP_IC_WaitGate(void);
+/**
+ * @brief  Waits for APP_AUTOSET_BURST_CAPTURES new periods of the main channel, bounded by APP_AUTOSET_BURST_TIMEOUT_US.
+ * @param  captures : Number of captures of the main channel when the burst started
+ * @retval 1 if at least one period was captured, 0 otherwise
+ */
+static u8 APP_IC_WaitBurst(u32 captures);
+/**
+ * @brief  Draws the PWM signal of the main channel on the GLCD at the current timebase,
+ *         from its captured period and high time.
  * @param  None
  * @retval None
  */
-static void APP_IC_Calculate_Freq_Duty(void);
+static void APP_GLCD_DrawPWM(void);
 /**
- * @brief  Draws a PWM signal on the GLCD.
- * @param  duty: Duty cycle value (0-100)
+ * @brief  Prints the current time per division and horizontal position on the GLCD.
+ * @param  None
  * @retval None
  */
-static void APP_GLCD_DrawPWM(u32 duty);
+static void APP_GLCD_PrintTimebase(void);
 /**
  * @brief  Prints the current frequency value on the GLCD.
  * @param  None
@@ -61,350 +141,2376 @@ static f32 APP_IC_GetPeriod_ms();
 /**
  * @brief  Returns the current duty value .
  * @param  None
- * @retval Duty (0-100)
+ * @retval Duty in 0.01% units (0 to MEAS_DUTY_FULL)
  */
 static u32 APP_IC_GetDuty();
+/**
+ * @brief  Draws a histogram as a bar chart on the GLCD.
+ * @param  hist : Pointer to the histogram to be drawn
+ * @param  title : Title printed above the chart
+ * @retval None
+ */
+static void APP_GLCD_DrawHistogram(const HIST_t *hist, string title);
+/**
+ * @brief  Redraws the histogram of the current view if enough new samples were added.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_UpdateHistogram();
+/**
+ * @brief  Draws a PWM pulse train between two pixel rows across the whole GLCD width.
+ * @param  duty : Duty cycle in 0.01% units (0 to MEAS_DUTY_FULL)
+ * @param  yHigh : Pixel row of the high level
+ * @param  yLow : Pixel row of the low level
+ * @param  cycleWidth : Width of a single cycle in pixels
+ * @param  offset : Position of the first rising edge in pixels (0 to cycleWidth - 1)
+ * @retval None
+ */
+static void APP_GLCD_DrawPulseTrain(u32 duty, u8 yHigh, u8 yLow, u8 cycleWidth, u8 offset);
+/**
+ * @brief  Redraws the bands of the split view whose measurement changed.
+ * @param  force : Redraw all the bands if not zero
+ * @retval None
+ */
+static void APP_GLCD_UpdateSplit(u8 force);
+/**
+ * @brief  Redraws the phase view if the delay or phase changed.
+ * @param  force : Redraw the whole view if not zero
+ * @retval None
+ */
+static void APP_GLCD_UpdatePhase(u8 force);
+/**
+ * @brief  Draws the recorded edge sequence across the whole GLCD width.
+ * @param  capture : Pointer to the edge capture record
+ * @retval None
+ */
+static void APP_GLCD_DrawEdges(const EDGE_Capture_t *capture);
+/**
+ * @brief  Shows the logic analyzer progress, then the record once complete.
+ * @param  force : Redraw the whole view if not zero
+ * @retval None
+ */
+static void APP_GLCD_UpdateLA(u8 force);
+/**
+ * @brief  Draws the min/max span of each decimated column between two pixel rows,
+ *         a column being extended to join the previous one when they do not overlap.
+ * @param  decim : Pointer to the decimated record
+ * @param  yTop : Pixel row of the full scale value
+ * @param  yBottom : Pixel row of the zero value
+ * @param  fullScale : Value drawn on yTop
+ * @retval None
+ */
+static void APP_GLCD_DrawSpans(const DECIM_t *decim, u8 yTop, u8 yBottom, u16 fullScale);
+/**
+ * @brief  Shows the sample rate and peak to peak voltage, and draws the last analog frame.
+ * @param  force : Redraw the last frame if not zero
+ * @retval None
+ */
+static void APP_GLCD_UpdateAnalog(u8 force);
+/**
+ * @brief  Collects the periods of the main channel over SWEEP_WINDOW_US, timed by the gate timer.
+ * @param  acc : Pointer to the accumulator to be filled
+ * @retval None
+ */
+static void APP_SWEEP_Collect(SWEEP_Acc_t *acc);
+/**
+ * @brief  Prints a signed number with its sign.
+ * @param  num : Number to be printed
+ * @param  x : Column of the sign
+ * @param  y : Line
+ * @retval None
+ */
+static void APP_GLCD_PrintSigned(s32 num, u8 x, GLCD_LineNum_t y);
+/**
+ * @brief  Shows the selected page and columns of the sweep results.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_UpdateSweep(void);
+/**
+ * @brief  Shows the cycle counts of the profiled regions.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_UpdateProf(void);
+/**
+ * @brief  Shows the interrupt load and the overcaptures of the measurement channels.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_UpdateLoad(void);
+/**
+ * @brief  Prints the overload warning of the PWM view, or clears it.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_PrintStatus(void);
+/**
+ * @brief  Load task, measures the interrupt load and checks for lost captures.
+ * @param  None
+ * @retval None
+ */
+static void APP_LoadTask(void);
+/**
+ * @brief  Adds the last capture of a measurement channel to the telemetry stream.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  index : Index of the channel in APP_MEAS_CH_CONFIG
+ * @param  timestamp : Core cycle counter at the capture interrupt.
+ * @retval None
+ */
+static void APP_TLM_AddCapture(const MEAS_Channel_t *channel, u8 index, u32 timestamp);
+/**
+ * @brief  Sends the oldest complete telemetry frame if none is being sent.
+ * @note   To be called from the capture interrupts or with them masked.
+ * @param  None
+ * @retval None
+ */
+static void APP_TLM_Send(void);
+/**
+ * @brief  Transmission complete callback of the telemetry USART, sends the next frame.
+ * @param  None
+ * @retval None
+ */
+static void APP_TLM_TxCallback(void);
+/**
+ * @brief  Telemetry task, sends the partial frame and the periodic information frame.
+ * @param  None
+ * @retval None
+ */
+static void APP_TLM_Task(void);
+/**
+ * @brief  Screenshot task, adds the next GLCD line of a screenshot to the telemetry stream.
+ * @param  None
+ * @retval None
+ */
+static void APP_ScreenTask(void);
+/**
+ * @brief  Shows a clock failure on the GLCD and halts, nothing can be measured right.
+ * @param  status : Status returned by RCC_Init (from @ref RCC_Status_t)
+ * @retval None, never returns
+ */
+static void APP_ClockFault(RCC_Status_t status);
+/**
+ * @brief  Posts an event to the main loop, can be called from any interrupt.
+ * @param  event : Event to be posted (from @ref APP_Event_t)
+ * @retval None
+ */
+static void APP_PostEvent(APP_Event_t event);
+/**
+ * @brief  Checks whether an event is waiting to be processed.
+ * @param  None
+ * @retval 1 if an event is pending, 0 otherwise
+ */
+static u8 APP_IsEventPending(void);
+/**
+ * @brief  Takes and processes the pending events.
+ * @param  None
+ * @retval None
+ */
+static void APP_ProcessEvents(void);
+/**
+ * @brief  Display task, refreshes the GLCD when the shown data may have changed.
+ * @param  None
+ * @retval None
+ */
+static void APP_DisplayTask(void);
 
 /* Private variables --------------------------------------------------------*/
-static f32 frequency = 0;
-static u32 duty = 0;
+static const MEAS_Config_t measConfigs[APP_MEAS_CH_COUNT] = APP_MEAS_CH_CONFIG;
+static MEAS_Channel_t measChannels[APP_MEAS_CH_COUNT];
 
 static f32 oldFreq = 0;
-static f32 oldDuty = 0;
+static u32 oldDuty = 0;
 
-/* Private functions --------------------------------------------------------*/
+static u32 timebaseDiv_us = APP_TIMEBASE_DEFAULT_US;
+static u32 position_us = 0;
 
-/**
- * @brief  Calculates frequency and duty cycle based on captured timer values.
- * @param  None
- * @retval None
- */
-static void APP_IC_Calculate_Freq_Duty(void)
-{
-	// Flag to track if it's the first time a rising edge is captured
-	static u8 IsFirstCapture = 0;
+static APP_View_t currentView = APP_VIEW_PWM;
 
-	// Variables to store captured time stamps (CCR register values)
-	static u32 firstRisingEdgeCount = 0;
-	static u32 secondRisingEdgeCount = 0;
-	static u32 fallingEdgeCount = 0;
+static u16 periodHistBins[APP_HIST_PERIOD_BINS];
+static u16 dutyHistBins[APP_HIST_DUTY_BINS];
+static HIST_t periodHist;
+static HIST_t dutyHist;
+static u32 histDrawnTotal = 0;
+static u8 histForceRedraw = 0;
 
-	// Variables to calculate differences between time stamps
-	static u32 risingFallingEdgeDifference = 0;
-	static u32 risingEdgeDifference = 0;
+static f32 oldSplitFreq[APP_MEAS_CH_COUNT];
+static u32 oldSplitDuty[APP_MEAS_CH_COUNT];
 
-	// Variables to hold captured CCR register values for frequency and duty cycle calculation
-	u32 TIMx_Freq_CCRx = 0;
-	u32 TIMx_Duty_CCRx = 0;
+static PHASE_t phaseMeas;
+static u8 phaseEnabled = 0;
+static f32 oldPhaseDelay = 0;
+static f32 oldPhaseDeg = 0;
 
-	// Determine the capture channel for frequency measurement
-	switch ( APP_TIM_IC_CH1)
-	{
-	case TIM_CH1:
-		TIMx_Freq_CCRx =  APP_TIM_IC_TIMx->CCR1;
-		break;
+static u16 laTimes[APP_LA_BUFFER_SIZE];
+static EDGE_Capture_t laCapture;
+static u16 oldLaCount = 0;
+static u8 laDrawn = 0;
 
-	case TIM_CH2:
-		TIMx_Freq_CCRx =  APP_TIM_IC_TIMx->CCR2;
-		break;
+static u16 displayMins[APP_GLCD_WIDTH];
+static u16 displayMaxs[APP_GLCD_WIDTH];
+static DECIM_t displayDecim;  // Columns of the record shown by the analog or logic analyzer view
 
-	case TIM_CH3:
-		TIMx_Freq_CCRx =  APP_TIM_IC_TIMx->CCR3;
-		break;
+static u8 scopeHasFrame = 0;
 
-	case TIM_CH4:
-		TIMx_Freq_CCRx =  APP_TIM_IC_TIMx->CCR4;
-		break;
-	}
+static AUTO_Mode_t measMode = AUTO_MODE_RECIPROCAL;
+static u32 gateTime_us = 0;
+static u32 gateLastCount = 0;
+static volatile f32 gatedFreq = 0;
 
-	// Determine the capture channel for duty cycle measurement
-	switch ( APP_TIM_IC_CH2)
-	{
-	case TIM_CH1:
-		TIMx_Duty_CCRx =  APP_TIM_IC_TIMx->CCR1;
-		break;
+static u8 hbRunning = 0;
 
-	case TIM_CH2:
-		TIMx_Duty_CCRx =  APP_TIM_IC_TIMx->CCR2;
-		break;
+static volatile u32 icIsrCycles = 0;  // Core cycles spent in the capture interrupts, wrapping
+static volatile u32 icIsrCalls = 0;
 
-	case TIM_CH3:
-		TIMx_Duty_CCRx =  APP_TIM_IC_TIMx->CCR3;
-		break;
+static SCHED_t appSched;
 
-	case TIM_CH4:
-		TIMx_Duty_CCRx =  APP_TIM_IC_TIMx->CCR4;
-		break;
-	}
+static volatile u8 appEvents[APP_EVENT_COUNT];  // One flag per event, a byte store needs no lock to be posted
+static u8 displayStale = 1;                      // Data changed since the last GLCD refresh
+
+static u32 loadLastTicks = 0;
+static u32 loadLastIsrCycles = 0;
+static u32 loadLastOvercaptures[APP_MEAS_CH_COUNT];
+static u16 isrLoad = 0;       // In 0.1% of the core
+static u16 isrLoadPeak = 0;
+static u8 overloaded = 0;
+static u8 statusShown = 0;    // Overload warning shown on the PWM view
+
+static TLM_t tlm;
+static u8 tlmRunning = 0;
+static volatile u8 tlmSending = 0;   // A frame is on the link, released by the transmission callback
+static u8 tlmInfoCountdown = 0;
+static u8 screenNextLine = APP_SCREEN_LINE_COUNT;   // Next line of the screenshot being sent, none when past the last
+
+static SWEEP_Point_t sweepPoints[SWEEP_POINT_COUNT];
+static u8 sweepCount = 0;
+static u8 sweepPage = 0;
+static APP_SweepColumns_t sweepColumns = APP_SWEEP_COLS_ERROR;
+
+/* Private functions --------------------------------------------------------*/
 
-	// Check if it's the first capture
-	if (IsFirstCapture == 0)
+/**
+ * @brief  Capture event callback of a measurement channel, calculates its frequency and duty cycle.
+ * @param  context : Pointer to the measurement channel.
+ * @param  capture : Rising edge captured on the period channel.
+ * @retval None
+ */
+static void APP_IC_Capture_Callback(void *context, u32 capture)
+{
+	u32 start = DWT_GetCycles();
+	MEAS_Channel_t *channel = (MEAS_Channel_t *)context;
+	u8 i = (u8)(channel - measChannels);
+
+	// The logic analyzer owns the main channel capture while recording
+	if (i == APP_MEAS_MAIN_CH && laCapture.state == EDGE_ARMED)
 	{
-		firstRisingEdgeCount = TIMx_Freq_CCRx;
-		IsFirstCapture = 1;
+		if (EDGE_Capture(&laCapture, (u16)capture))
+		{
+			MEAS_Resync(channel);
+		}
 	}
 	else
 	{
-		// Second rising edge captured implies falling edge was also captured
-		secondRisingEdgeCount = TIMx_Freq_CCRx;
-		fallingEdgeCount = TIMx_Duty_CCRx;
-
-		//Calculate the difference between rising edges (handling counter overflow)
-		if (secondRisingEdgeCount > firstRisingEdgeCount)
+		if (MEAS_Capture(channel, capture))
 		{
-			risingEdgeDifference = secondRisingEdgeCount - firstRisingEdgeCount;
-		}
-		else
-		{
-			risingEdgeDifference = (TIM_MAX_PERIOD - firstRisingEdgeCount) + secondRisingEdgeCount;
-		}
+			if (i == APP_MEAS_MAIN_CH)
+			{
+				// Accumulate the distribution of periods and duty cycles of the main channel
+				HIST_Add(&periodHist, channel->periodTicks);
+				HIST_Add(&dutyHist, MEAS_GetDuty(channel));
+			}
 
-		// Calculate the difference between rising and falling edges (handling counter overflow)
-		if (fallingEdgeCount > firstRisingEdgeCount)
-		{
-			risingFallingEdgeDifference = fallingEdgeCount - firstRisingEdgeCount;
+			if (tlmRunning)
+			{
+				APP_TLM_AddCapture(channel, i, start);
+			}
 		}
-		else
+
+		// Rising edges of the phase inputs share the same counter
+		if (phaseEnabled && i == APP_PHASE_CH_A)
 		{
-			risingFallingEdgeDifference = (TIM_MAX_PERIOD - firstRisingEdgeCount) + fallingEdgeCount;
+			PHASE_EdgeA(&phaseMeas, channel->lastRisingEdge);
 		}
-
-		// Calculating the frequency and duty only if rising edge difference is significant
-		if (risingEdgeDifference > 1)
+		else if (phaseEnabled && i == APP_PHASE_CH_B)
 		{
-			frequency = (float)TIM_CLK / (float)risingEdgeDifference;
-			duty = (risingFallingEdgeDifference * 100 ) / (float)risingEdgeDifference;
-			IsFirstCapture = 0;
+			PHASE_EdgeB(&phaseMeas, channel->lastRisingEdge);
 		}
 	}
+
+	APP_PostEvent(APP_EVENT_CAPTURE);
+
+	start = DWT_GetCycles() - start;
+	DWT_PROF_ADD(DWT_PROF_IC_CAPTURE, start);
+
+	icIsrCycles += start;
+	icIsrCalls++;
 }
 
 /**
- * @brief  Draws a PWM signal on the GLCD.
- * @param  duty: Duty cycle value (0-100)
+ * @brief  Gate timer update callback of the gated mode, counts the main channel edges of the last gate.
+ * @param  context : Unused.
+ * @param  value : Unused.
  * @retval None
  */
-static void APP_GLCD_DrawPWM(u32 duty)
+static void APP_IC_Gate_Callback(void *context, u32 value)
 {
-	// Validate the duty cycle parameter
-	if (duty < 0 || duty > 100)
-	{
-		// Duty cycle out of range, do not proceed with drawing
-	    return;
-	}
-
-	//Clear the lines where the PWM will be drawn
-	for (int i=APP_GLCD_HIGH_LINE ; i<=APP_GLCD_LOW_LINE ; ++i)
-	{
-		GLCD_ClearLine(i);
-	}
-
-	// Calculate the pixel range of the duty cycle
-	int dutyXrange = (duty * 60) / 100;
+	u32 count;
 
+	(void)context;
+	(void)value;
 
-	// Draw the baseline for the entire graph
-	GLCD_DrawHLine(0, APP_GLCD_CYCLE_1_START_X, APP_GLCD_LOW_LINE);
+	// The main channel timer counts the input edges, the difference modulo the counter period handles the overflow
+	count = TIM_GetCounter(measConfigs[APP_MEAS_MAIN_CH].TIMx);
+	gatedFreq = ((f32)((count - gateLastCount) & TIM_MAX_PERIOD) * 1000000.0f) / (f32)gateTime_us;
+	gateLastCount = count;
 
-	// Drawing the first cycle
-	// Vertical line representing rising edge
-	GLCD_DrawVLine(APP_GLCD_HIGH_LINE, APP_GLCD_LOW_LINE, APP_GLCD_CYCLE_1_START_X);
-	// Top horizontal line representing duty cycle (on)
-	GLCD_DrawHLine(APP_GLCD_CYCLE_1_START_X + 1, (APP_GLCD_CYCLE_1_START_X + dutyXrange), APP_GLCD_HIGH_LINE);
-	// Vertical line representing falling edge
-	GLCD_DrawVLine(APP_GLCD_HIGH_LINE, APP_GLCD_LOW_LINE, APP_GLCD_CYCLE_1_START_X + dutyXrange);
-	// Lower horizontal line representing duty cycle (off)
-	GLCD_DrawHLine(APP_GLCD_CYCLE_1_START_X + dutyXrange, APP_GLCD_CYCLE_2_START_X, APP_GLCD_LOW_LINE);
-
-	// Drawing the second cycle
-	// Vertical line representing rising edge
-	GLCD_DrawVLine(APP_GLCD_HIGH_LINE, APP_GLCD_LOW_LINE, APP_GLCD_CYCLE_2_START_X);
-	// Top horizontal line representing duty cycle (on)
-	GLCD_DrawHLine(APP_GLCD_CYCLE_2_START_X + 1, (APP_GLCD_CYCLE_2_START_X + dutyXrange), APP_GLCD_HIGH_LINE);
-	// Vertical line representing falling edge
-	GLCD_DrawVLine(APP_GLCD_HIGH_LINE, APP_GLCD_LOW_LINE, APP_GLCD_CYCLE_2_START_X + dutyXrange);
-	// Lower horizontal line representing duty cycle (off)
-	GLCD_DrawHLine(APP_GLCD_CYCLE_2_START_X + dutyXrange, APP_GLCD_CYCLE_2_END_X, APP_GLCD_LOW_LINE);
+	APP_PostEvent(APP_EVENT_GATE);
 }
 
 /**
- * @brief  Prints the current frequency value on the GLCD.
- * @param  None
- * @retval None
+ * @brief  Checks whether a measurement channel is captured on a timer.
+ * @param  TIMx : Pointer to the timer peripheral.
+ * @retval 1 if the timer is used, 0 otherwise
  */
-static void APP_GLCD_PrintFreq()
+static u8 APP_IC_IsTimerUsed(volatile TIM_TypeDef *TIMx)
 {
-	GLCD_ClearLine(APP_GLCD_FREQ_LINE);
-	f32 glcdFreq = APP_IC_GetFreq_KHZ();
-	GLCD_PrintString("FREQ:", 0, APP_GLCD_FREQ_LINE);
-	GLCD_PrintFloat(glcdFreq, 35, APP_GLCD_FREQ_LINE);
-	GLCD_PrintString("KHZ", 90, APP_GLCD_FREQ_LINE);
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+	{
+		if (measConfigs[i].TIMx == TIMx)
+		{
+			return 1;
+		}
+	}
+
+	return 0;
 }
+
 /**
- * @brief  Prints the current duty cycle value on the GLCD.
- * @param  None
+ * @brief  Enables or disables the capture interrupts of the measurement channels of a timer.
+ * @param  TIMx : Pointer to the timer peripheral.
+ * @param  status : Interrupt status (TIM_INT_ENABLE or TIM_INT_DISABLE)
  * @retval None
  */
-static void APP_GLCD_PrintDuty()
+static void APP_IC_SetCaptureInterrupts(volatile TIM_TypeDef *TIMx, TIM_INT_Status_t status)
 {
-	GLCD_ClearLine(APP_GLCD_DUTY_LINE);
-	u32 glcdDuty = APP_IC_GetDuty();
-	GLCD_PrintString("DUTY:", 0, APP_GLCD_DUTY_LINE);
-	GLCD_PrintNum(glcdDuty, 35, APP_GLCD_DUTY_LINE);
-	GLCD_PrintString("%", 55, APP_GLCD_DUTY_LINE);
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+	{
+		if (measConfigs[i].TIMx == TIMx)
+		{
+			TIM_IC_SetInterrupt(TIMx, measConfigs[i].periodCh, status);
+			MEAS_Resync(&measChannels[i]);
+		}
+	}
 }
+
 /**
- * @brief  Prints the current period value on the GLCD.
- * @param  None
+ * @brief  Applies a reciprocal mode setting to the timer of the main channel and the channels sharing it.
+ * @param  setting : Pointer to the setting
  * @retval None
  */
-static void APP_GLCD_PrintPeriod()
+static void APP_IC_ApplySetting(const AUTO_Setting_t *setting)
 {
-	GLCD_ClearLine(APP_GLCD_PERIOD_LINE);
-	f32 glcdPeriod = APP_IC_GetPeriod_ms();
-	GLCD_PrintString("PERIOD:", 0, APP_GLCD_PERIOD_LINE);
-	GLCD_PrintFloat(glcdPeriod, 50, APP_GLCD_PERIOD_LINE);
-	GLCD_PrintString("ms", 100, APP_GLCD_PERIOD_LINE);
-}
+	volatile TIM_TypeDef *TIMx = measConfigs[APP_MEAS_MAIN_CH].TIMx;
+	u32 tickRate = AUTO_GetTickRate(setting);
 
-/**
- * @brief  Returns the current frequency value in KHZ.
- * @param  None
- * @retval Frequency in KHZ
- */
-static f32 APP_IC_GetFreq_KHZ()
-{
-	return frequency / 1000;
+	TIM_SetPrescaler(TIMx, setting->timerDivider - 1);
+	TIM_IC_SetPrescaler(TIMx, measConfigs[APP_MEAS_MAIN_CH].periodCh, AUTO_GetCapturePrescaler(setting));
+
+	// The other channels of the timer share its counter clock but capture every edge
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+	{
+		if (measConfigs[i].TIMx == TIMx)
+		{
+			MEAS_SetTiming(&measChannels[i], tickRate, (i == APP_MEAS_MAIN_CH) ? setting->capturePrescaler : 1);
+		}
+	}
+
+	if (phaseEnabled && measConfigs[APP_PHASE_CH_A].TIMx == TIMx)
+	{
+		PHASE_SetTiming(&phaseMeas, tickRate, measChannels[APP_PHASE_CH_A].eventsPerCapture);
+	}
 }
 
 /**
- * @brief  Returns the current period value in ms.
- * @param  None
- * @retval period in ms
+ * @brief  Counts the main channel edges over gates of the gate timer.
+ * @param  setting : Pointer to a gated mode setting
+ * @retval None
  */
-static f32 APP_IC_GetPeriod_ms()
+static void APP_IC_StartGated(const AUTO_Setting_t *setting)
 {
-	int currFreq = frequency;
+	const MEAS_Config_t *mainConfig = &measConfigs[APP_MEAS_MAIN_CH];
 
-	// Ensure non-zero frequency to avoid division by zero
-	if (frequency == 0)
-		currFreq = 1;
+	// The counter counts edges, the captures of its channels are meaningless meanwhile
+	APP_IC_SetCaptureInterrupts(mainConfig->TIMx, TIM_INT_DISABLE);
+	TIM_SetPrescaler(mainConfig->TIMx, 0);
+	TIM_IC_SetPrescaler(mainConfig->TIMx, mainConfig->periodCh, TIM_IC_PSC_DIV1);
+	TIM_ExtClock_Start(mainConfig->TIMx, mainConfig->periodCh);
 
-	return ((1.0 / (currFreq)) * 1000);
-}
+	measMode = AUTO_MODE_GATED;
+	gateTime_us = setting->gateTime_us;
+	gatedFreq = setting->frequency_Hz;
+	gateLastCount = TIM_GetCounter(mainConfig->TIMx);
 
-/**
- * @brief  Returns the current duty value .
- * @param  None
- * @retval Duty (0-100)
- */
-static u32 APP_IC_GetDuty()
-{
-	return duty;
+	TIM_SetEventCallback(APP_AUTOSET_GATE_TIMx, TIM_EVENT_UPDATE, APP_IC_Gate_Callback, 0);
+	TIM_Gate_Start(APP_AUTOSET_GATE_TIMx, gateTime_us, TIM_INT_ENABLE);
 }
 
-/* Public functions --------------------------------------------------------*/
-
 /**
- * @brief  Initializes the GLCD and timers used for PWM and input capture.
+ * @brief  Stops the gated mode, the main channel timer is clocked internally again.
  * @param  None
  * @retval None
  */
-void APP_Init(void)
+static void APP_IC_StopGated(void)
 {
-	GLCD_Init();
-	TIM_Init(APP_TIM_PWM_TIMx);
-	TIM_Init( APP_TIM_IC_TIMx);
+	volatile TIM_TypeDef *TIMx = measConfigs[APP_MEAS_MAIN_CH].TIMx;
+
+	TIM_Gate_Stop(APP_AUTOSET_GATE_TIMx);
+	TIM_SetEventCallback(APP_AUTOSET_GATE_TIMx, TIM_EVENT_UPDATE, 0, 0);
+	TIM_ExtClock_Stop(TIMx);
+
+	measMode = AUTO_MODE_RECIPROCAL;
+	gatedFreq = 0;
+
+	APP_IC_SetCaptureInterrupts(TIMx, TIM_INT_ENABLE);
 }
 
 /**
- * @brief Starts the input capture timer for frequency and duty cycle calculations.
+ * @brief  Returns to reciprocal mode capturing every rising edge of the main channel.
  * @param  None
  * @retval None
  */
-void APP_IC_Start()
+static void APP_IC_ResetCapturePrescaler(void)
 {
-	TIM_IC_Start( APP_TIM_IC_TIMx,  APP_TIM_IC_CH1, CCS_IP_DIRECT, TIM_IC_RISING_EDGE , TIM_INT_ENABLE);
-
-	TIM_IC_INT_Enable( APP_TIM_IC_TIMx);
-
-	if ( APP_TIM_IC_TIMx == TIM1)
-	{
-		TIM1_CC_SetCallback(APP_IC_Calculate_Freq_Duty);
-	}
+	AUTO_Setting_t setting = { AUTO_MODE_RECIPROCAL, 1, 1, 0, 0, 0 };
 
-	else if ( APP_TIM_IC_TIMx == TIM2)
+	if (measMode == AUTO_MODE_GATED)
 	{
-		TIM2_SetCallback(APP_IC_Calculate_Freq_Duty);
+		APP_IC_StopGated();
 	}
-	else if ( APP_TIM_IC_TIMx == TIM3)
+	else
 	{
-		TIM3_SetCallback(APP_IC_Calculate_Freq_Duty);
+		// Keep the timer divider, only the capture prescaler is reset
+		setting.timerDivider = TIM_CLK / measChannels[APP_MEAS_MAIN_CH].tickRate;
 	}
 
-	TIM_IC_Start(APP_TIM_IC_TIMx,  APP_TIM_IC_CH2, CCS_IP_DIRECT, TIM_IC_FALLING_EDGE ,  TIM_INT_DISABLE);
-
+	APP_IC_ApplySetting(&setting);
 }
 
 /**
- * @brief Starts the timer in PWM output mode.
+ * @brief  Waits for the next update event of the gate timer, bounded by APP_AUTOSET_POLL_GUARD.
+ * @param  None
+ * @retval None
+ */
+static void APP_IC_WaitGate(void)
+{
+	for (u32 guard = 0; guard < APP_AUTOSET_POLL_GUARD; guard++)
+	{
+		if (TIM_Gate_IsElapsed(APP_AUTOSET_GATE_TIMx))
+		{
+			return;
+		}
+	}
+}
+
+/**
+ * @brief  Waits for APP_AUTOSET_BURST_CAPTURES new periods of the main channel, bounded by APP_AUTOSET_BURST_TIMEOUT_US.
+ * @param  captures : Number of captures of the main channel when the burst started
+ * @retval 1 if at least one period was captured, 0 otherwise
+ */
+static u8 APP_IC_WaitBurst(u32 captures)
+{
+	const MEAS_Channel_t *mainChannel = &measChannels[APP_MEAS_MAIN_CH];
+
+	TIM_Gate_Start(APP_AUTOSET_GATE_TIMx, APP_AUTOSET_SLICE_US, TIM_INT_DISABLE);
+
+	for (u32 slice = 0; slice < APP_AUTOSET_BURST_TIMEOUT_US / APP_AUTOSET_SLICE_US; slice++)
+	{
+		if (mainChannel->captures - captures >= APP_AUTOSET_BURST_CAPTURES)
+		{
+			break;
+		}
+		APP_IC_WaitGate();
+	}
+
+	TIM_Gate_Stop(APP_AUTOSET_GATE_TIMx);
+
+	return mainChannel->captures != captures;
+}
+
+/**
+ * @brief  Draws the PWM signal of the main channel on the GLCD at the current timebase,
+ *         from its captured period and high time.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_DrawPWM(void)
+{
+	u32 tickRate = measChannels[APP_MEAS_MAIN_CH].tickRate;
+	u32 period = measChannels[APP_MEAS_MAIN_CH].periodTicks;
+	u32 high = measChannels[APP_MEAS_MAIN_CH].highTicks;
+	u8 edgesOnly = 0;
+	u64 divTicks, positionTicks, columnStart, columnTicks, phaseEnd;
+	u32 phaseStart;
+	u8 yHigh = APP_GLCD_HIGH_LINE * 8;
+	u8 yLow = APP_GLCD_LOW_LINE * 8;
+	u8 yLevel;
+	DWT_PROF_BEGIN(DWT_PROF_DRAW_PWM);
+
+	if (measMode == AUTO_MODE_GATED)
+	{
+		// Only the frequency is known, the rising edges are drawn at the timer clock rate
+		tickRate = TIM_CLK;
+		period = (gatedFreq > 0) ? (u32)((f32)TIM_CLK / gatedFreq) : 0;
+		high = (period != 0) ? 1 : 0;
+		edgesOnly = 1;
+	}
+
+	divTicks = ((u64)timebaseDiv_us * tickRate) / 1000000UL;
+	positionTicks = ((u64)position_us * tickRate) / 1000000UL;
+
+	//Clear the lines where the PWM will be drawn
+	for (int i=APP_GLCD_HIGH_LINE ; i<=APP_GLCD_LOW_LINE ; ++i)
+	{
+		GLCD_ClearLine(i);
+	}
+
+	if (period == 0 || high == 0 || high >= period)
+	{
+		// No signal or constant level
+		yLevel = (period != 0 && high != 0) ? yHigh : yLow;
+		for (u8 x = 0; x < APP_GLCD_WIDTH; x++)
+		{
+			GLCD_DrawColumn(x, yLevel, yLevel);
+		}
+		DWT_PROF_END(DWT_PROF_DRAW_PWM);
+		return;
+	}
+
+	for (u8 x = 0; x < APP_GLCD_WIDTH; x++)
+	{
+		// Time window of the column, only the visible window is computed
+		columnStart = positionTicks + (x * divTicks) / APP_TIMEBASE_DIV_WIDTH;
+		columnTicks = positionTicks + ((x + 1) * divTicks) / APP_TIMEBASE_DIV_WIDTH - columnStart;
+
+		// Position of the column in the cycle, 0 being the rising edge
+		phaseStart = (u32)(columnStart % period);
+		phaseEnd = phaseStart + columnTicks;
+
+		// An edge on a column boundary is drawn in the column it starts, like the rising edge
+		if (columnTicks >= period || phaseStart == 0 || phaseEnd > period ||
+			(!edgesOnly && phaseStart <= high && phaseEnd > high))
+		{
+			// Rising or falling edge(s) within the column
+			GLCD_DrawColumn(x, yHigh, yLow);
+		}
+		else if (edgesOnly)
+		{
+			// Unknown level between the rising edges
+			continue;
+		}
+		else if (phaseStart < high)
+		{
+			// High level
+			GLCD_DrawColumn(x, yHigh, yHigh);
+		}
+		else
+		{
+			// Low level
+			GLCD_DrawColumn(x, yLow, yLow);
+		}
+	}
+
+	DWT_PROF_END(DWT_PROF_DRAW_PWM);
+}
+
+/**
+ * @brief  Prints the current time per division and horizontal position on the GLCD.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_PrintTimebase(void)
+{
+	GLCD_ClearLine(APP_TIMEBASE_LINE);
+	GLCD_PrintString("T:", 0, APP_TIMEBASE_LINE);
+	GLCD_PrintNum(timebaseDiv_us, 14, APP_TIMEBASE_LINE);
+	GLCD_PrintString("us", 56, APP_TIMEBASE_LINE);
+	GLCD_PrintString("P:", 72, APP_TIMEBASE_LINE);
+	GLCD_PrintNum(position_us, 86, APP_TIMEBASE_LINE);
+}
+
+/**
+ * @brief  Prints the current frequency value on the GLCD.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_PrintFreq()
+{
+	GLCD_ClearLine(APP_GLCD_FREQ_LINE);
+	f32 glcdFreq = APP_IC_GetFreq_KHZ();
+	GLCD_PrintString("FREQ:", 0, APP_GLCD_FREQ_LINE);
+	GLCD_PrintFloat(glcdFreq, 35, APP_GLCD_FREQ_LINE);
+	GLCD_PrintString("KHZ", 90, APP_GLCD_FREQ_LINE);
+}
+/**
+ * @brief  Prints the current duty cycle value on the GLCD.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_PrintDuty()
+{
+	GLCD_ClearLine(APP_GLCD_DUTY_LINE);
+	u32 glcdDuty = APP_IC_GetDuty();
+	GLCD_PrintString("DUTY:", 0, APP_GLCD_DUTY_LINE);
+	GLCD_PrintFixed(glcdDuty, 2, 35, APP_GLCD_DUTY_LINE);
+	GLCD_PrintString("%", 84, APP_GLCD_DUTY_LINE);
+}
+/**
+ * @brief  Prints the current period value on the GLCD.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_PrintPeriod()
+{
+	GLCD_ClearLine(APP_GLCD_PERIOD_LINE);
+	f32 glcdPeriod = APP_IC_GetPeriod_ms();
+	GLCD_PrintString("PERIOD:", 0, APP_GLCD_PERIOD_LINE);
+	GLCD_PrintFloat(glcdPeriod, 50, APP_GLCD_PERIOD_LINE);
+	GLCD_PrintString("ms", 100, APP_GLCD_PERIOD_LINE);
+}
+
+/**
+ * @brief  Returns the current frequency value in KHZ.
+ * @param  None
+ * @retval Frequency in KHZ
+ */
+static f32 APP_IC_GetFreq_KHZ()
+{
+	if (measMode == AUTO_MODE_GATED)
+	{
+		return gatedFreq / 1000;
+	}
+
+	return MEAS_GetFreq_HZ(&measChannels[APP_MEAS_MAIN_CH]) / 1000;
+}
+
+/**
+ * @brief  Returns the current period value in ms.
+ * @param  None
+ * @retval period in ms
+ */
+static f32 APP_IC_GetPeriod_ms()
+{
+	f32 frequency = APP_IC_GetFreq_KHZ() * 1000;
+	int currFreq = frequency;
+
+	// Ensure non-zero frequency to avoid division by zero
+	if (currFreq == 0)
+		currFreq = 1;
+
+	return ((1.0 / (currFreq)) * 1000);
+}
+
+/**
+ * @brief  Returns the current duty value .
+ * @param  None
+ * @retval Duty in 0.01% units (0 to MEAS_DUTY_FULL)
+ */
+static u32 APP_IC_GetDuty()
+{
+	// Edges counting does not give the duty cycle
+	if (measMode == AUTO_MODE_GATED)
+	{
+		return 0;
+	}
+
+	return MEAS_GetDuty(&measChannels[APP_MEAS_MAIN_CH]);
+}
+
+/**
+ * @brief  Draws a histogram as a bar chart on the GLCD.
+ * @param  hist : Pointer to the histogram to be drawn
+ * @param  title : Title printed above the chart
+ * @retval None
+ */
+static void APP_GLCD_DrawHistogram(const HIST_t *hist, string title)
+{
+	u32 chartHeight = APP_HIST_CHART_BOTTOM_Y - APP_HIST_CHART_TOP_Y + 1;
+	u32 barWidth = APP_HIST_CHART_WIDTH / hist->binCount;
+	u32 barHeight;
+	u16 peak = HIST_GetPeak(hist);
+
+	// Print the title and the number of samples
+	GLCD_ClearLine(APP_HIST_TITLE_LINE);
+	GLCD_PrintString(title, 0, APP_HIST_TITLE_LINE);
+	GLCD_PrintNum(hist->total, 70, APP_HIST_TITLE_LINE);
+
+	// Clear the lines where the chart will be drawn
+	for (int i = APP_HIST_CHART_TOP_Y / 8; i <= APP_HIST_CHART_BOTTOM_Y / 8; ++i)
+	{
+		GLCD_ClearLine(i);
+	}
+
+	// Nothing to draw for an empty histogram
+	if (peak == 0)
+	{
+		return;
+	}
+
+	for (u16 bin = 0; bin < hist->binCount; bin++)
+	{
+		if (hist->bins[bin] == 0)
+		{
+			continue;
+		}
+
+		// Scale the bin count to the chart height, keeping non-empty bins visible
+		barHeight = (hist->bins[bin] * chartHeight) / peak;
+		if (barHeight == 0)
+		{
+			barHeight = 1;
+		}
+
+		// Draw the bar, leaving one empty column between neighbouring bars
+		for (u32 x = bin * barWidth; x < (bin + 1) * barWidth - (barWidth > 1); x++)
+		{
+			GLCD_DrawColumn(x, APP_HIST_CHART_BOTTOM_Y + 1 - barHeight, APP_HIST_CHART_BOTTOM_Y);
+		}
+	}
+}
+
+/**
+ * @brief  Redraws the histogram of the current view if enough new samples were added.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_UpdateHistogram()
+{
+	const HIST_t *hist = (currentView == APP_VIEW_HIST_PERIOD) ? &periodHist : &dutyHist;
+	u32 total = hist->total;
+
+	if (histForceRedraw || (total - histDrawnTotal) >= APP_HIST_REDRAW_COUNT)
+	{
+		histForceRedraw = 0;
+		histDrawnTotal = total;
+		APP_GLCD_DrawHistogram(hist, (currentView == APP_VIEW_HIST_PERIOD) ? "PERIOD N:" : "DUTY N:");
+	}
+}
+
+/**
+ * @brief  Draws a PWM pulse train between two pixel rows across the whole GLCD width.
+ * @param  duty : Duty cycle in 0.01% units (0 to MEAS_DUTY_FULL)
+ * @param  yHigh : Pixel row of the high level
+ * @param  yLow : Pixel row of the low level
+ * @param  cycleWidth : Width of a single cycle in pixels
+ * @param  offset : Position of the first rising edge in pixels (0 to cycleWidth - 1)
+ * @retval None
+ */
+static void APP_GLCD_DrawPulseTrain(u32 duty, u8 yHigh, u8 yLow, u8 cycleWidth, u8 offset)
+{
+	u8 dutyWidth = (duty * cycleWidth) / MEAS_DUTY_FULL;
+	u8 phase;
+
+	for (u8 x = 0; x < APP_GLCD_WIDTH; x++)
+	{
+		phase = (x + cycleWidth - offset) % cycleWidth;
+
+		if (phase == 0 || phase == dutyWidth)
+		{
+			// Rising or falling edge
+			GLCD_DrawColumn(x, yHigh, yLow);
+		}
+		else if (phase < dutyWidth)
+		{
+			// High level
+			GLCD_DrawColumn(x, yHigh, yHigh);
+		}
+		else
+		{
+			// Low level
+			GLCD_DrawColumn(x, yLow, yLow);
+		}
+	}
+}
+
+/**
+ * @brief  Redraws the bands of the split view whose measurement changed.
+ * @param  force : Redraw all the bands if not zero
+ * @retval None
+ */
+static void APP_GLCD_UpdateSplit(u8 force)
+{
+	GLCD_LineNum_t textLine;
+	u8 waveTop;
+	f32 freq;
+	u32 chDuty;
+
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+	{
+		freq = MEAS_GetFreq_HZ(&measChannels[i]) / 1000;
+		chDuty = MEAS_GetDuty(&measChannels[i]);
+
+		if (!force && freq == oldSplitFreq[i] && chDuty == oldSplitDuty[i])
+		{
+			continue;
+		}
+		oldSplitFreq[i] = freq;
+		oldSplitDuty[i] = chDuty;
+
+		// Each channel owns a band of lines: a text line followed by its waveform
+		textLine = i * APP_SPLIT_LINES_PER_CH;
+		waveTop = (textLine + 1) * 8;
+
+		GLCD_ClearLine(textLine);
+		GLCD_PrintNum(i + 1, 0, textLine);
+		GLCD_PrintFloat(freq, 14, textLine);
+		GLCD_PrintString("K", 70, textLine);
+		GLCD_PrintFixed(chDuty / 10, 1, 84, textLine);   // 0.1% fits the band width
+		GLCD_PrintString("%", 119, textLine);
+
+		APP_GLCD_DrawPulseTrain(chDuty, waveTop + 1, waveTop + 6, APP_SPLIT_CYCLE_WIDTH, 0);
+	}
+}
+
+/**
+ * @brief  Redraws the phase view if the delay or phase changed.
+ * @param  force : Redraw the whole view if not zero
+ * @retval None
+ */
+static void APP_GLCD_UpdatePhase(u8 force)
+{
+	f32 delay = PHASE_GetDelay_us(&phaseMeas);
+	f32 degrees = PHASE_GetPhase_deg(&phaseMeas);
+	u8 offset;
+
+	if (!force && delay == oldPhaseDelay && degrees == oldPhaseDeg)
+	{
+		return;
+	}
+	oldPhaseDelay = delay;
+	oldPhaseDeg = degrees;
+
+	GLCD_ClearLine(APP_PHASE_DELAY_LINE);
+	GLCD_PrintString("DELAY:", 0, APP_PHASE_DELAY_LINE);
+	GLCD_PrintFloat(delay, 42, APP_PHASE_DELAY_LINE);
+	GLCD_PrintString("us", 105, APP_PHASE_DELAY_LINE);
+
+	GLCD_ClearLine(APP_PHASE_DEG_LINE);
+	GLCD_PrintString("PHASE:", 0, APP_PHASE_DEG_LINE);
+	GLCD_PrintFloat(degrees, 42, APP_PHASE_DEG_LINE);
+	GLCD_PrintString("deg", 98, APP_PHASE_DEG_LINE);
+
+	// Draw input A as reference and input B shifted by the measured phase
+	offset = (u8)((degrees * APP_PHASE_CYCLE_WIDTH) / 360) % APP_PHASE_CYCLE_WIDTH;
+	APP_GLCD_DrawPulseTrain(MEAS_GetDuty(&measChannels[APP_PHASE_CH_A]),
+			APP_PHASE_WAVE_A_LINE * 8 + 1, APP_PHASE_WAVE_A_LINE * 8 + 6, APP_PHASE_CYCLE_WIDTH, 0);
+	APP_GLCD_DrawPulseTrain(MEAS_GetDuty(&measChannels[APP_PHASE_CH_B]),
+			APP_PHASE_WAVE_B_LINE * 8 + 1, APP_PHASE_WAVE_B_LINE * 8 + 6, APP_PHASE_CYCLE_WIDTH, offset);
+}
+
+/**
+ * @brief  Draws the recorded edge sequence across the whole GLCD width.
+ * @param  capture : Pointer to the edge capture record
+ * @retval None
+ */
+static void APP_GLCD_DrawEdges(const EDGE_Capture_t *capture)
+{
+	u32 span, columnEnd;
+	u32 edgeTime = 0;   // Time of the next edge since the first edge
+	u16 edge = 0;       // Index of the next edge
+	u16 triggerEdge = EDGE_GetTriggerIndex(capture);
+	u8 level = !EDGE_IsFirstRising(capture);  // Level before the first edge
+	u8 triggerX = APP_GLCD_WIDTH;             // Column of the trigger edge, none by default
+
+	// Clear the lines where the edges and the trigger marker will be drawn
+	for (int i = APP_LA_TRIG_MARK_Y / 8; i <= APP_LA_LOW_Y / 8; ++i)
+	{
+		GLCD_ClearLine(i);
+	}
+
+	if (capture->count < 2)
+	{
+		return;
+	}
+
+	span = EDGE_GetElapsed(capture, capture->count - 1);
+
+	// The display columns now hold the edges, not the last analog frame
+	scopeHasFrame = 0;
+	DECIM_Begin(&displayDecim, 0);
+
+	for (u8 x = 0; x < APP_GLCD_WIDTH; x++)
+	{
+		columnEnd = ((x + 1) * span) / APP_GLCD_WIDTH;
+
+		// Level entering the column
+		DECIM_AddAt(&displayDecim, x, level);
+
+		// Consume all the edges falling in this column, the last column takes the last edge;
+		// a column with edges spans both levels so narrow pulses stay visible
+		while (edge < capture->count && (edgeTime < columnEnd || x == APP_GLCD_WIDTH - 1))
+		{
+			if (edge == triggerEdge)
+			{
+				triggerX = x;
+			}
+			level = !level;
+			DECIM_AddAt(&displayDecim, x, level);
+			edge++;
+
+			if (edge < capture->count)
+			{
+				edgeTime += (EDGE_GetTime(capture, edge) - EDGE_GetTime(capture, edge - 1)) & TIM_MAX_PERIOD;
+			}
+		}
+	}
+	DECIM_End(&displayDecim);
+
+	// Mark the trigger position above the waveform
+	if (triggerX < APP_GLCD_WIDTH)
+	{
+		GLCD_DrawColumn(triggerX, APP_LA_TRIG_MARK_Y, APP_LA_HIGH_Y - 3);
+	}
+
+	APP_GLCD_DrawSpans(&displayDecim, APP_LA_HIGH_Y, APP_LA_LOW_Y, 1);
+}
+
+/**
+ * @brief  Shows the logic analyzer progress, then the record once complete.
+ * @param  force : Redraw the whole view if not zero
+ * @retval None
+ */
+static void APP_GLCD_UpdateLA(u8 force)
+{
+	u16 count = laCapture.count;
+
+	if (force || count != oldLaCount)
+	{
+		oldLaCount = count;
+		GLCD_ClearLine(APP_LA_TITLE_LINE);
+		if (laCapture.state == EDGE_ARMED)
+		{
+			GLCD_PrintString((laCapture.mode == EDGE_MODE_TRIGGER && !laCapture.triggered) ? "LA WAIT" : "LA ARMED", 0, APP_LA_TITLE_LINE);
+		}
+		else
+		{
+			GLCD_PrintString(laCapture.triggered ? "LA TRIG" : "LA EDGES", 0, APP_LA_TITLE_LINE);
+		}
+		GLCD_PrintNum(count, 70, APP_LA_TITLE_LINE);
+	}
+
+	if (laCapture.state == EDGE_DONE && (force || !laDrawn))
+	{
+		laDrawn = 1;
+
+		GLCD_ClearLine(APP_LA_SPAN_LINE);
+		GLCD_PrintString("SPAN:", 0, APP_LA_SPAN_LINE);
+		GLCD_PrintFloat(((f32)EDGE_GetElapsed(&laCapture, count - 1) * 1000000.0f) / (f32)measChannels[APP_MEAS_MAIN_CH].tickRate, 35, APP_LA_SPAN_LINE);
+		GLCD_PrintString("us", 105, APP_LA_SPAN_LINE);
+
+		APP_GLCD_DrawEdges(&laCapture);
+	}
+}
+
+/**
+ * @brief  Draws the min/max span of each decimated column between two pixel rows,
+ *         a column being extended to join the previous one when they do not overlap.
+ * @param  decim : Pointer to the decimated record
+ * @param  yTop : Pixel row of the full scale value
+ * @param  yBottom : Pixel row of the zero value
+ * @param  fullScale : Value drawn on yTop
+ * @retval None
+ */
+static void APP_GLCD_DrawSpans(const DECIM_t *decim, u8 yTop, u8 yBottom, u16 fullScale)
+{
+	u8 top, bottom, spanTop, spanBottom;
+	u8 prevTop = 0, prevBottom = 0;
+
+	for (u16 x = 0; x < decim->filled && x < APP_GLCD_WIDTH; x++)
+	{
+		top = DECIM_ValueToRow(decim->maxs[x], fullScale, yTop, yBottom);
+		bottom = DECIM_ValueToRow(decim->mins[x], fullScale, yTop, yBottom);
+		spanTop = top;
+		spanBottom = bottom;
+
+		if (x != 0 && top > prevBottom)
+		{
+			spanTop = prevBottom;      // Below the previous column
+		}
+		else if (x != 0 && bottom < prevTop)
+		{
+			spanBottom = prevTop;      // Above the previous column
+		}
+
+		GLCD_DrawColumn(x, spanTop, spanBottom);
+
+		prevTop = top;
+		prevBottom = bottom;
+	}
+}
+
+/**
+ * @brief  Shows the sample rate and peak to peak voltage, and draws the last analog frame.
+ * @param  force : Redraw the last frame if not zero
+ * @retval None
+ */
+static void APP_GLCD_UpdateAnalog(u8 force)
+{
+	if (SCOPE_DecimateFrame(&displayDecim))
+	{
+		scopeHasFrame = 1;
+	}
+	else if (!force)
+	{
+		return;
+	}
+
+	GLCD_ClearLine(APP_SCOPE_TITLE_LINE);
+	if (!SCOPE_IsRunning())
+	{
+		GLCD_PrintString("ADC OFF", 0, APP_SCOPE_TITLE_LINE);
+	}
+	else
+	{
+		GLCD_PrintString("F:", 0, APP_SCOPE_TITLE_LINE);
+		GLCD_PrintNum(SCOPE_GetSampleRate(), 14, APP_SCOPE_TITLE_LINE);
+	}
+
+	for (u8 line = APP_SCOPE_FIRST_LINE; line <= GLCD_LINE_7; line++)
+	{
+		GLCD_ClearLine(line);
+	}
+
+	if (!scopeHasFrame)
+	{
+		return;
+	}
+
+	GLCD_PrintString("P:", 63, APP_SCOPE_TITLE_LINE);
+	GLCD_PrintNum(SCOPE_ToMillivolts(displayDecim.max) - SCOPE_ToMillivolts(displayDecim.min), 77, APP_SCOPE_TITLE_LINE);
+	GLCD_PrintString("mV", 112, APP_SCOPE_TITLE_LINE);
+
+	APP_GLCD_DrawSpans(&displayDecim, APP_SCOPE_TOP_Y, APP_SCOPE_BOTTOM_Y, ADC_RESOLUTION_MAX);
+}
+
+/**
+ * @brief  Collects the periods of the main channel over SWEEP_WINDOW_US, timed by the gate timer.
+ * @param  acc : Pointer to the accumulator to be filled
+ * @retval None
+ */
+static void APP_SWEEP_Collect(SWEEP_Acc_t *acc)
+{
+	MEAS_Channel_t *mainChannel = &measChannels[APP_MEAS_MAIN_CH];
+	MEAS_Record_t record;
+	u32 cycles, calls, mask;
+
+	SWEEP_ResetAcc(acc);
+
+	// Drop the periods captured by the autoset, the window starts empty
+	while (MEAS_Read(mainChannel, &record))
+	{
+	}
+	mask = NVIC_RaiseBasePriority(APP_IRQ_PRIO_CAPTURE);  // Both counters from the same interrupt
+	cycles = icIsrCycles;
+	calls = icIsrCalls;
+	NVIC_RestoreBasePriority(mask);
+
+	// The ring is drained while waiting, so that it only overruns if the reader falls behind
+	TIM_Gate_Start(APP_AUTOSET_GATE_TIMx, SWEEP_WINDOW_US, TIM_INT_DISABLE);
+	for (u32 guard = 0; guard < APP_AUTOSET_POLL_GUARD; guard++)
+	{
+		while (MEAS_Read(mainChannel, &record))
+		{
+			SWEEP_Accumulate(acc, &record);
+		}
+
+		if (TIM_Gate_IsElapsed(APP_AUTOSET_GATE_TIMx))
+		{
+			break;
+		}
+	}
+	TIM_Gate_Stop(APP_AUTOSET_GATE_TIMx);
+
+	mask = NVIC_RaiseBasePriority(APP_IRQ_PRIO_CAPTURE);
+	acc->isrCycles = icIsrCycles - cycles;
+	acc->isrCalls = icIsrCalls - calls;
+	NVIC_RestoreBasePriority(mask);
+}
+
+/**
+ * @brief  Prints a signed number with its sign.
+ * @param  num : Number to be printed
+ * @param  x : Column of the sign
+ * @param  y : Line
+ * @retval None
+ */
+static void APP_GLCD_PrintSigned(s32 num, u8 x, GLCD_LineNum_t y)
+{
+	GLCD_PrintChar((num < 0) ? '-' : '+', x, y);
+	GLCD_PrintNum((num < 0) ? (u32)(-(s64)num) : (u32)num, x + APP_GLCD_CHAR_WIDTH, y);
+}
+
+/**
+ * @brief  Shows the selected page and columns of the sweep results.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_UpdateSweep(void)
+{
+	u8 pages = (sweepCount + APP_SWEEP_ROWS - 1U) / APP_SWEEP_ROWS;
+	u8 first, line;
+	const SWEEP_Point_t *point;
+
+	for (line = APP_SWEEP_TITLE_LINE; line <= GLCD_LINE_7; line++)
+	{
+		GLCD_ClearLine(line);
+	}
+
+	if (sweepCount == 0)
+	{
+		GLCD_PrintString("NO SWEEP", 0, APP_SWEEP_TITLE_LINE);
+		return;
+	}
+
+	sweepPage %= pages;
+	first = sweepPage * APP_SWEEP_ROWS;
+
+	GLCD_PrintString("SWEEP", 0, APP_SWEEP_TITLE_LINE);
+	GLCD_PrintNum(sweepPage + 1U, APP_SWEEP_DUTY_X, APP_SWEEP_TITLE_LINE);
+	GLCD_PrintChar('/', APP_SWEEP_DUTY_X + APP_GLCD_CHAR_WIDTH, APP_SWEEP_TITLE_LINE);
+	GLCD_PrintNum(pages, APP_SWEEP_DUTY_X + 2U * APP_GLCD_CHAR_WIDTH, APP_SWEEP_TITLE_LINE);
+	GLCD_PrintString((sweepColumns == APP_SWEEP_COLS_ERROR) ? "ppm" : "cyc", APP_SWEEP_COL1_X, APP_SWEEP_TITLE_LINE);
+	GLCD_PrintString((sweepColumns == APP_SWEEP_COLS_ERROR) ? "dD" : "mis", APP_SWEEP_COL2_X, APP_SWEEP_TITLE_LINE);
+
+	for (line = 0; line < APP_SWEEP_ROWS && first + line < sweepCount; line++)
+	{
+		point = &sweepPoints[first + line];
+
+		GLCD_PrintNum(point->frequency_mHz / 1000UL, 0, APP_SWEEP_FIRST_LINE + line);
+		GLCD_PrintNum(point->duty / 100UL, APP_SWEEP_DUTY_X, APP_SWEEP_FIRST_LINE + line);
+
+		if (point->status != SWEEP_POINT_OK)
+		{
+			GLCD_PrintString((point->status == SWEEP_POINT_NO_SIGNAL) ? "NO SIG" : "SKIP", APP_SWEEP_COL1_X, APP_SWEEP_FIRST_LINE + line);
+		}
+		else if (sweepColumns == APP_SWEEP_COLS_ERROR)
+		{
+			APP_GLCD_PrintSigned(point->frequencyError_ppm, APP_SWEEP_COL1_X, APP_SWEEP_FIRST_LINE + line);
+			APP_GLCD_PrintSigned(point->dutyError, APP_SWEEP_COL2_X, APP_SWEEP_FIRST_LINE + line);
+		}
+		else
+		{
+			GLCD_PrintNum(point->isrCycles, APP_SWEEP_COL1_X, APP_SWEEP_FIRST_LINE + line);
+			GLCD_PrintNum(point->missed, APP_SWEEP_COL2_X, APP_SWEEP_FIRST_LINE + line);
+		}
+	}
+}
+
+/**
+ * @brief  Shows the cycle counts of the profiled regions.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_UpdateProf(void)
+{
+#if DWT_PROF_ENABLE
+	DWT_ProfStats_t stats;
+	u8 line = APP_PROF_FIRST_LINE;
+
+	for (u8 region = 0; region < DWT_PROF_REGION_COUNT && line < GLCD_LINE_7; region++, line += 2U)
+	{
+		DWT_PROF_GetStats(region, &stats);
+
+		GLCD_ClearLine(line);
+		GLCD_ClearLine(line + 1U);
+		GLCD_PrintString((string)DWT_PROF_GetName(region), 0, line);
+		GLCD_PrintNum(stats.calls, APP_PROF_CALLS_X, line);
+
+		if (stats.calls != 0)
+		{
+			GLCD_PrintNum(stats.min, 0, line + 1U);
+			GLCD_PrintNum((u32)(stats.total / stats.calls), APP_PROF_MEAN_X, line + 1U);
+			GLCD_PrintNum(stats.max, APP_PROF_MAX_X, line + 1U);
+		}
+	}
+#else
+	GLCD_ClearLine(APP_PROF_FIRST_LINE);
+	GLCD_PrintString("PROFILING OFF", 0, APP_PROF_FIRST_LINE);
+#endif
+}
+
+/**
+ * @brief  Shows the interrupt load and the overcaptures of the measurement channels.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_UpdateLoad(void)
+{
+	u8 line = GLCD_LINE_3;
+
+	GLCD_ClearLine(GLCD_LINE_0);
+	GLCD_PrintString("ISR LOAD", 0, GLCD_LINE_0);
+	GLCD_PrintFixed(isrLoad, 1, APP_LOAD_VALUE_X, GLCD_LINE_0);
+
+	GLCD_ClearLine(GLCD_LINE_1);
+	GLCD_PrintString("PEAK", 0, GLCD_LINE_1);
+	GLCD_PrintFixed(isrLoadPeak, 1, APP_LOAD_VALUE_X, GLCD_LINE_1);
+
+	GLCD_ClearLine(GLCD_LINE_2);
+	GLCD_PrintString("OVERCAPTURES", 0, GLCD_LINE_2);
+
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT && line <= GLCD_LINE_7; i++, line++)
+	{
+		GLCD_ClearLine(line);
+		GLCD_PrintString("CH", 0, line);
+		GLCD_PrintNum(i, 2U * APP_GLCD_CHAR_WIDTH, line);
+		GLCD_PrintNum(APP_MEAS_GetOvercaptures(i), APP_LOAD_VALUE_X, line);
+	}
+}
+
+/**
+ * @brief  Prints the overload warning of the PWM view, or clears it.
+ * @param  None
+ * @retval None
+ */
+static void APP_GLCD_PrintStatus(void)
+{
+	GLCD_ClearLine(APP_STATUS_LINE);
+	if (overloaded)
+	{
+		GLCD_PrintString("OVERLOAD", 0, APP_STATUS_LINE);
+	}
+	statusShown = overloaded;
+}
+
+/**
+ * @brief  Posts an event to the main loop, can be called from any interrupt.
+ * @param  event : Event to be posted (from @ref APP_Event_t)
+ * @retval None
+ */
+static void APP_PostEvent(APP_Event_t event)
+{
+	appEvents[event] = 1;
+}
+
+/**
+ * @brief  Checks whether an event is waiting to be processed.
+ * @param  None
+ * @retval 1 if an event is pending, 0 otherwise
+ */
+static u8 APP_IsEventPending(void)
+{
+	for (u8 event = 0; event < APP_EVENT_COUNT; event++)
+	{
+		if (appEvents[event])
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Takes and processes the pending events.
+ * @param  None
+ * @retval None
+ */
+static void APP_ProcessEvents(void)
+{
+	for (u8 event = 0; event < APP_EVENT_COUNT; event++)
+	{
+		if (!appEvents[event])
+		{
+			continue;
+		}
+
+		// Posted again meanwhile is merged into this one: the handlers read the latest state
+		appEvents[event] = 0;
+
+		switch (event)
+		{
+		case APP_EVENT_CAPTURE:
+		case APP_EVENT_GATE:
+			// New measurements, redrawn at the next display period
+			displayStale = 1;
+			break;
+		default:
+			break;
+		}
+	}
+}
+
+/**
+ * @brief  Display task, refreshes the GLCD when the shown data may have changed.
+ * @param  None
+ * @retval None
+ */
+static void APP_DisplayTask(void)
+{
+	// The lines of a screenshot are read when sent, the screen is held until the last one
+	if (screenNextLine < APP_SCREEN_LINE_COUNT)
+	{
+		return;
+	}
+
+	// The measurement views only change with new captures, the analog frames come from the DMA
+	// and the profiling results from every refresh
+	if (displayStale || currentView == APP_VIEW_ANALOG || currentView == APP_VIEW_PROF)
+	{
+		displayStale = 0;
+		APP_GLCD_Update();
+	}
+}
+
+/**
+ * @brief  Load task, measures the interrupt load and checks for lost captures.
+ * @param  None
+ * @retval None
+ */
+static void APP_LoadTask(void)
+{
+	u32 isrCycles = DWT_ISR_GetCycles();
+	u32 ticks = STK_GetTicks();
+	u32 overcaptures;
+	u8 lost = 0;
+
+	// Measured against the elapsed time, a late run of the task does not bias the load.
+	// CYCCNT may stop while the core sleeps in WFI, it only counts the cycles of the interrupts.
+	if (ticks != loadLastTicks)
+	{
+		isrLoad = (u16)(((u64)(isrCycles - loadLastIsrCycles) * 1000UL) / ((u64)(ticks - loadLastTicks) * (FCPU / 1000UL)));
+	}
+	if (isrLoad > isrLoadPeak)
+	{
+		isrLoadPeak = isrLoad;
+	}
+	loadLastIsrCycles = isrCycles;
+	loadLastTicks = ticks;
+
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+	{
+		overcaptures = APP_MEAS_GetOvercaptures(i);
+		if (overcaptures != loadLastOvercaptures[i])
+		{
+			lost = 1;
+		}
+		loadLastOvercaptures[i] = overcaptures;
+	}
+
+	overloaded = lost || (isrLoad >= APP_LOAD_WARN_PERMILLE);
+
+	// The warning and the load view are redrawn by the display task
+	if (overloaded != statusShown || currentView == APP_VIEW_LOAD)
+	{
+		displayStale = 1;
+	}
+}
+
+/**
+ * @brief  Adds the last capture of a measurement channel to the telemetry stream.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  index : Index of the channel in APP_MEAS_CH_CONFIG
+ * @param  timestamp : Core cycle counter at the capture interrupt.
+ * @retval None
+ */
+static void APP_TLM_AddCapture(const MEAS_Channel_t *channel, u8 index, u32 timestamp)
+{
+	TLM_Record_t record;
+
+	// Both times are differences modulo the 16-bit counter period
+	record.timestamp = timestamp;
+	record.periodTicks = (u16)channel->periodTicks;
+	record.highTicks = (u16)channel->highTicks;
+	record.flags = (index & TLM_FLAG_CH_MASK) | (overloaded ? TLM_FLAG_OVERLOAD : 0U);
+
+	if (TLM_AddRecord(&tlm, &record))
+	{
+		APP_TLM_Send();
+	}
+}
+
+/**
+ * @brief  Sends the oldest complete telemetry frame if none is being sent.
+ * @note   To be called from the capture interrupts or with them masked.
+ * @param  None
+ * @retval None
+ */
+static void APP_TLM_Send(void)
+{
+	const u8 *frame;
+	u16 size;
+
+	if (tlmSending)
+	{
+		return;
+	}
+
+	frame = TLM_Peek(&tlm, &size);
+	if (frame != 0 && USART_SendDMA(APP_TLM_USARTx, frame, size))
+	{
+		tlmSending = 1;
+	}
+}
+
+/**
+ * @brief  Transmission complete callback of the telemetry USART, sends the next frame.
+ * @param  None
+ * @retval None
+ */
+static void APP_TLM_TxCallback(void)
+{
+	// The capture interrupts add records and send frames too
+	u32 state = NVIC_RaiseBasePriority(APP_IRQ_PRIO_CAPTURE);
+
+	tlmSending = 0;
+	TLM_Release(&tlm);
+	APP_TLM_Send();
+
+	NVIC_RestoreBasePriority(state);
+}
+
+/**
+ * @brief  Telemetry task, sends the partial frame and the periodic information frame.
+ * @param  None
+ * @retval None
+ */
+static void APP_TLM_Task(void)
+{
+	TLM_Info_t info;
+	u32 state;
+	u8 infoDue;
+
+	if (!tlmRunning)
+	{
+		return;
+	}
+
+	infoDue = (tlmInfoCountdown == 0);
+	if (infoDue)
+	{
+		info.clockHz = FCPU;
+		info.isrLoad = isrLoad;
+		info.channelCount = APP_MEAS_CH_COUNT;
+		for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+		{
+			info.tickRates[i] = measChannels[i].tickRate;
+			info.overcaptures[i] = APP_MEAS_GetOvercaptures(i);
+		}
+		tlmInfoCountdown = APP_TLM_INFO_PERIOD;
+	}
+	tlmInfoCountdown--;
+
+	// Low capture rates still reach the host within a task period
+	state = NVIC_RaiseBasePriority(APP_IRQ_PRIO_CAPTURE);
+	if (infoDue)
+	{
+		TLM_AddInfo(&tlm, &info);
+	}
+	else
+	{
+		TLM_Flush(&tlm);
+	}
+	APP_TLM_Send();
+	NVIC_RestoreBasePriority(state);
+}
+
+/**
+ * @brief  Screenshot task, adds the next GLCD line of a screenshot to the telemetry stream.
+ * @param  None
+ * @retval None
+ */
+static void APP_ScreenTask(void)
+{
+	u32 state;
+
+	if (screenNextLine >= APP_SCREEN_LINE_COUNT)
+	{
+		return;
+	}
+
+	// Room for the partial record frame closed first and the line, the records keep their
+	// frames otherwise and the line waits for the next run
+	state = NVIC_RaiseBasePriority(APP_IRQ_PRIO_CAPTURE);
+	if (TLM_GetFreeFrames(&tlm) >= 2U &&
+			TLM_AddScreenPage(&tlm, screenNextLine, APP_SCREEN_LINE_COUNT, GLCD_GetLine(screenNextLine), APP_GLCD_WIDTH))
+	{
+		screenNextLine++;
+	}
+	APP_TLM_Send();
+	NVIC_RestoreBasePriority(state);
+}
+
+/**
+ * @brief  Shows a clock failure on the GLCD and halts, nothing can be measured right.
+ * @param  status : Status returned by RCC_Init (from @ref RCC_Status_t)
+ * @retval None, never returns
+ */
+static void APP_ClockFault(RCC_Status_t status)
+{
+	// Still on HSI, the GLCD bus only gets slower than configured
+	GLCD_Init();
+	GLCD_ClearScreen();
+	GLCD_PrintString("CLOCK FAILURE", 0, GLCD_LINE_0);
+
+	switch (status)
+	{
+	case RCC_ERR_HSE:
+		GLCD_PrintString("HSE not started", 0, GLCD_LINE_2);
+		break;
+	case RCC_ERR_PLL:
+		GLCD_PrintString("PLL not locked", 0, GLCD_LINE_2);
+		break;
+	default:
+		GLCD_PrintString("Switch failed", 0, GLCD_LINE_2);
+		break;
+	}
+
+	while (1)
+	{
+	}
+}
+
+/* Public functions --------------------------------------------------------*/
+
+/**
+ * @brief  Initializes the system clock, the GLCD and timers used for PWM and input capture.
+ * @param  None
+ * @retval None
+ */
+void APP_Init(void)
+{
+	// Every clock constant (FCPU, TIM_CLK, RCC_PCLK2_HZ) assumes the configured tree,
+	// on HSI all frequencies, times and the baud rate would be wrong by the clock ratio
+	RCC_Status_t clockStatus = RCC_Init();
+
+	if (clockStatus != RCC_OK)
+	{
+		APP_ClockFault(clockStatus);
+	}
+	DWT_Init();
+
+	// Priorities set before any interrupt is enabled, the capture lines last as they may share a line
+	NVIC_SetPriorityGrouping(NVIC_GROUP_PRE16_SUB1);
+	NVIC_SetPriority(DMA_GetIRQn(SCOPE_DMA_CH), APP_IRQ_PRIO_DMA, 0);
+	NVIC_SetPriority(DMA_GetIRQn(SEQ_DMA_CH), APP_IRQ_PRIO_DMA, 0);
+	NVIC_SetPriority(USART_GetIRQn(APP_TLM_USARTx), APP_IRQ_PRIO_DMA, 0);
+	NVIC_SetPriority(TIM_GetIRQn(APP_AUTOSET_GATE_TIMx, TIM_EVENT_UPDATE), APP_IRQ_PRIO_GATE, 0);
+	NVIC_SetPriority(SysTick_IRQn, APP_IRQ_PRIO_TICK, 0);
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+	{
+		NVIC_SetPriority(TIM_GetIRQn(measConfigs[i].TIMx, TIM_EVENT_CCx(measConfigs[i].periodCh)), APP_IRQ_PRIO_CAPTURE, 0);
+	}
+
+	GLCD_Init();
+
+	DECIM_Init(&displayDecim, displayMins, displayMaxs, APP_GLCD_WIDTH);
+
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+	{
+		MEAS_Init(&measChannels[i], &measConfigs[i]);
+		TIM_Init(measConfigs[i].TIMx);
+	}
+
+	EDGE_Init(&laCapture, measConfigs[APP_MEAS_MAIN_CH].TIMx, measConfigs[APP_MEAS_MAIN_CH].periodCh, laTimes, APP_LA_BUFFER_SIZE);
+
+	// Phase needs both inputs captured from the same counter
+	PHASE_Init(&phaseMeas);
+	phaseEnabled = (measConfigs[APP_PHASE_CH_A].TIMx == measConfigs[APP_PHASE_CH_B].TIMx);
+
+	HIST_Init(&periodHist, periodHistBins, APP_HIST_PERIOD_BINS, APP_HIST_PERIOD_MIN_TICKS, APP_HIST_PERIOD_BIN_TICKS);
+	HIST_Init(&dutyHist, dutyHistBins, APP_HIST_DUTY_BINS, APP_HIST_DUTY_MIN, APP_HIST_DUTY_BIN_WIDTH);
+	TIM_Init(APP_TIM_PWM_TIMx);
+
+	SCHED_Init(&appSched);
+	SCHED_AddTask(&appSched, APP_DisplayTask, APP_DISPLAY_PERIOD_MS, 0);
+	TLM_Init(&tlm);
+	USART_Init(APP_TLM_USARTx, APP_TLM_BAUD);
+	USART_SetTxCompleteCallback(APP_TLM_USARTx, APP_TLM_TxCallback);
+
+	SCHED_AddTask(&appSched, APP_LoadTask, APP_LOAD_PERIOD_MS, APP_LOAD_PERIOD_MS);
+	SCHED_AddTask(&appSched, APP_TLM_Task, APP_TLM_PERIOD_MS, APP_TLM_PERIOD_MS);
+	SCHED_AddTask(&appSched, APP_ScreenTask, APP_SCREEN_PERIOD_MS, APP_SCREEN_PERIOD_MS / 2U);
+	STK_Init();
+}
+
+/**
+ * @brief Starts the input capture timer for frequency and duty cycle calculations.
+ * @param  None
+ * @retval None
+ */
+void APP_IC_Start()
+{
+	volatile TIM_TypeDef *TIMx;
+
+	for (u8 i = 0; i < APP_MEAS_CH_COUNT; i++)
+	{
+		TIMx = measChannels[i].config.TIMx;
+
+		// Route the capture event before the capture interrupt is enabled
+		TIM_SetEventCallback(TIMx, TIM_EVENT_CCx(measChannels[i].config.periodCh), APP_IC_Capture_Callback, &measChannels[i]);
+
+		MEAS_Start(&measChannels[i]);
+
+		TIM_IC_INT_Enable(TIMx);
+	}
+}
+
+/**
+ * @brief Starts the timer in PWM output mode.
  * @param  None
  * @retval None
  */
 void APP_PWM_Start(u32 dutyCycle, u32 frequency)
 {
 
-	TIM_PWM_Start(APP_TIM_PWM_TIMx, APP_TIM_PWM_CHx, dutyCycle, frequency);
+	TIM_PWM_Start(APP_TIM_PWM_TIMx, APP_TIM_PWM_CHx, dutyCycle, frequency);
+}
+
+/**
+ * @brief  Starts the PWM output with a fine frequency and duty cycle.
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  duty : Desired high time in 0.01% units (0 to TIM_DUTY_FULL).
+ * @param  achieved : Pointer to the setting to be filled with the achieved values, may be 0.
+ * @retval 1 if started, 0 if the frequency is out of range
+ */
+u8 APP_PWM_StartFine(u32 frequency_mHz, u32 duty, TIM_PWM_Setting_t *achieved)
+{
+	return TIM_PWM_StartFine(APP_TIM_PWM_TIMx, APP_TIM_PWM_CHx, frequency_mHz, duty, achieved);
+}
+
+/**
+ * @brief  Plays a table of compare values on the PWM output started by APP_PWM_StartFine, one per period.
+ * @param  compares : Table of compare values, see SEQ_DutyToCompare.
+ * @param  count : Number of steps in the table.
+ * @param  mode : SEQ_MODE_ONESHOT or SEQ_MODE_LOOP.
+ * @retval None
+ */
+void APP_PWM_StartSequence(const u16 *compares, u16 count, SEQ_Mode_t mode)
+{
+	SEQ_Start(compares, count, mode);
+}
+
+/**
+ * @brief  Stops the sequence played on the PWM output, which keeps its last duty cycle.
+ * @param  None
+ * @retval None
+ */
+void APP_PWM_StopSequence(void)
+{
+	SEQ_Stop();
+}
+
+/**
+ * @brief  Starts the complementary half-bridge output pair with dead time and break input.
+ * @note   Refused while TIM1 is used by the analog sampling, the gated mode or a measurement channel.
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  duty : Desired duty cycle of the high side, dead time included, in 0.01% units.
+ * @param  deadTime_ns : Delay before each output turns on, up to 1008 TIM1 clock cycles.
+ * @param  achievedDeadTime_ns : Pointer to the achieved dead time in ns to be filled, may be 0.
+ * @retval 1 if started, 0 if TIM1 is busy or a value is out of range
+ */
+u8 APP_HB_Start(u32 frequency_mHz, u32 duty, u32 deadTime_ns, u32 *achievedDeadTime_ns)
+{
+	TIM_Complementary_t config = { frequency_mHz, duty, deadTime_ns, APP_HB_BREAK };
+
+	if (SCOPE_IsRunning() || measMode == AUTO_MODE_GATED || APP_IC_IsTimerUsed(APP_HB_TIMx))
+	{
+		return 0;
+	}
+
+	TIM_Init(APP_HB_TIMx);
+	hbRunning = TIM_PWM_StartComplementary(APP_HB_TIMx, APP_HB_CHx, &config, 0, achievedDeadTime_ns);
+
+	return hbRunning;
+}
+
+/**
+ * @brief  Stops the half-bridge output pair, both outputs are driven low.
+ * @param  None
+ * @retval None
+ */
+void APP_HB_Stop(void)
+{
+	if (!hbRunning)
+	{
+		return;
+	}
+
+	TIM_PWM_StopComplementary(APP_HB_TIMx, APP_HB_CHx);
+	hbRunning = 0;
+}
+
+/**
+ * @brief  Enables the half-bridge outputs again after a break.
+ * @param  None
+ * @retval 1 if the outputs are enabled, 0 if the break input is still active
+ */
+u8 APP_HB_Resume(void)
+{
+	if (!hbRunning)
+	{
+		return 0;
+	}
+
+	TIM_Break_Resume(APP_HB_TIMx);
+
+	return !TIM_Break_IsActive(APP_HB_TIMx);
+}
+
+/**
+ * @brief  Returns the dead time between the high side falling and the low side rising edges,
+ *         measured with the high side wired to APP_PHASE_CH_A and the low side to APP_PHASE_CH_B.
+ * @param  None
+ * @retval Dead time in ns, 0 if not measured
+ */
+u32 APP_HB_GetDeadTime_ns(void)
+{
+	u32 delay = phaseMeas.delayTicks;
+	u32 high = measChannels[APP_PHASE_CH_A].highTicks;
+
+	// The low side rises one high side pulse plus the dead time after the high side
+	if (!phaseEnabled || delay <= high)
+	{
+		return 0;
+	}
+
+	return (u32)(((u64)(delay - high) * 1000000000ULL) / phaseMeas.tickRate);
+}
+
+/**
+ * @brief  Prints on GLCD the initial frequency, duty, period, and draws initial PWM signal
+ * @param  None
+ * @retval None
+ */
+void APP_GLCD_Print_Init()
+{
+	 // Retrieve initial frequency, duty cycle, and period values
+	oldFreq = APP_IC_GetFreq_KHZ();
+	oldDuty = APP_IC_GetDuty();
+
+	// Print initial frequency, duty cycle, and period values on the GLCD
+	APP_GLCD_PrintFreq();
+	APP_GLCD_PrintDuty();
+	APP_GLCD_PrintPeriod();
+	APP_GLCD_PrintTimebase();
+	APP_GLCD_PrintStatus();
+
+	// Draw initial PWM signal on the GLCD
+	APP_GLCD_DrawPWM();
+
+}
+/**
+ * @brief  Updates GLCD display with new frequency, duty, period, and PWM signal if they have changed.
+ * @param  None
+ * @retval None
+ */
+void APP_GLCD_Update()
+{
+	// Histogram views are redrawn from the accumulated bins
+	if (currentView == APP_VIEW_HIST_PERIOD || currentView == APP_VIEW_HIST_DUTY)
+	{
+		APP_GLCD_UpdateHistogram();
+		return;
+	}
+
+	if (currentView == APP_VIEW_SPLIT)
+	{
+		APP_GLCD_UpdateSplit(0);
+		return;
+	}
+
+	if (currentView == APP_VIEW_PHASE)
+	{
+		APP_GLCD_UpdatePhase(0);
+		return;
+	}
+
+	if (currentView == APP_VIEW_LA)
+	{
+		APP_GLCD_UpdateLA(0);
+		return;
+	}
+
+	if (currentView == APP_VIEW_ANALOG)
+	{
+		APP_GLCD_UpdateAnalog(0);
+		return;
+	}
+
+	// The sweep results only change when a sweep runs
+	if (currentView == APP_VIEW_SWEEP)
+	{
+		return;
+	}
+
+	if (currentView == APP_VIEW_PROF)
+	{
+		APP_GLCD_UpdateProf();
+		return;
+	}
+
+	if (currentView == APP_VIEW_LOAD)
+	{
+		APP_GLCD_UpdateLoad();
+		return;
+	}
+
+	if (overloaded != statusShown)
+	{
+		APP_GLCD_PrintStatus();
+	}
+
+	// Check for changes in frequency
+	if (APP_IC_GetFreq_KHZ() != oldFreq)
+	{
+		// Update and print new frequency on the GLCD
+		oldFreq = APP_IC_GetFreq_KHZ();
+		APP_GLCD_PrintFreq();
+
+		// Print new period on GLCD
+		APP_GLCD_PrintPeriod();
+
+		// The cycles of the PWM signal take a new width at the same timebase
+		APP_GLCD_DrawPWM();
+	}
+
+	// Check for changes in duty cycle
+	if (APP_IC_GetDuty() != oldDuty)
+	{
+		// Update and print new duty on the GLCD
+		oldDuty = APP_IC_GetDuty();
+		APP_GLCD_PrintDuty();
+
+		// Draw new PWM signal on GLCD
+		APP_GLCD_DrawPWM();
+	}
+
+
+}
+
+/**
+ * @brief  Processes the posted events and runs the periodic tasks that are due (GLCD refresh),
+ *         then sleeps until the next interrupt when nothing is left to do. To be called from the main loop.
+ * @param  None
+ * @retval None
+ */
+void APP_Run(void)
+{
+	u32 state;
+
+	APP_ProcessEvents();
+	SCHED_Dispatch(&appSched, STK_GetTicks());
+
+	// The check and the sleep share a critical section, an event posted after the check
+	// still wakes the core and its interrupt runs when the section ends
+	state = NVIC_EnterCritical();
+	if (!APP_IsEventPending() && SCHED_GetIdleTime(&appSched, STK_GetTicks()) != 0)
+	{
+		NVIC_WaitForInterrupt();
+	}
+	NVIC_ExitCritical(state);
 }
 
 /**
- * @brief  Prints on GLCD the initial frequency, duty, period, and draws initial PWM signal
+ * @brief  Selects the view shown on the GLCD and redraws the screen.
+ * @param  view : View to be shown (from @ref APP_View_t)
+ * @retval None
+ */
+void APP_SetView(APP_View_t view)
+{
+	currentView = view;
+	GLCD_ClearScreen();
+
+	if (currentView == APP_VIEW_PWM)
+	{
+		APP_GLCD_Print_Init();
+	}
+	else if (currentView == APP_VIEW_SPLIT)
+	{
+		APP_GLCD_UpdateSplit(1);
+	}
+	else if (currentView == APP_VIEW_PHASE)
+	{
+		APP_GLCD_UpdatePhase(1);
+	}
+	else if (currentView == APP_VIEW_LA)
+	{
+		APP_GLCD_UpdateLA(1);
+	}
+	else if (currentView == APP_VIEW_ANALOG)
+	{
+		APP_GLCD_UpdateAnalog(1);
+	}
+	else if (currentView == APP_VIEW_SWEEP)
+	{
+		APP_GLCD_UpdateSweep();
+	}
+	else if (currentView == APP_VIEW_PROF)
+	{
+		APP_GLCD_UpdateProf();
+	}
+	else if (currentView == APP_VIEW_LOAD)
+	{
+		APP_GLCD_UpdateLoad();
+	}
+	else
+	{
+		// Force a redraw of the selected histogram
+		histForceRedraw = 1;
+		APP_GLCD_UpdateHistogram();
+	}
+}
+
+/**
+ * @brief  Clears the period and duty cycle histograms.
  * @param  None
  * @retval None
  */
-void APP_GLCD_Print_Init()
+void APP_HIST_Reset(void)
 {
-	 // Retrieve initial frequency, duty cycle, and period values
-	oldFreq = APP_IC_GetFreq_KHZ();
-	oldDuty = APP_IC_GetDuty();
+	HIST_Clear(&periodHist);
+	HIST_Clear(&dutyHist);
+	histForceRedraw = 1;
+}
 
-	// Print initial frequency, duty cycle, and period values on the GLCD
-	APP_GLCD_PrintFreq();
-	APP_GLCD_PrintDuty();
-	APP_GLCD_PrintPeriod();
+/**
+ * @brief  Returns a measurement channel, giving access to its results and ring buffer.
+ * @param  index : Index of the channel in APP_MEAS_CH_CONFIG
+ * @retval Pointer to the measurement channel, 0 if the index is out of range
+ */
+MEAS_Channel_t* APP_MEAS_GetChannel(u8 index)
+{
+	if (index >= APP_MEAS_CH_COUNT)
+	{
+		return 0;
+	}
 
-	// Draw initial PWM signal on the GLCD
-	APP_GLCD_DrawPWM(duty);
+	return &measChannels[index];
+}
+
+/**
+ * @brief  Returns the captures of a measurement channel overwritten before they were served.
+ * @param  index : Index of the channel in APP_MEAS_CH_CONFIG
+ * @retval Overcaptures of the rising edge channel since reset, 0 if the index is out of range
+ */
+u32 APP_MEAS_GetOvercaptures(u8 index)
+{
+	if (index >= APP_MEAS_CH_COUNT)
+	{
+		return 0;
+	}
 
+	return TIM_IC_GetOvercaptures(measConfigs[index].TIMx, measConfigs[index].periodCh);
 }
+
 /**
- * @brief  Updates GLCD display with new frequency, duty, period, and PWM signal if they have changed.
+ * @brief  Returns the share of the core spent in the interrupt handlers over the last APP_LOAD_PERIOD_MS.
+ * @param  peak : Pointer to the highest share measured to be filled, may be 0
+ * @retval Load in 0.1%
+ */
+u16 APP_ISR_GetLoad(u16 *peak)
+{
+	if (peak != 0)
+	{
+		*peak = isrLoadPeak;
+	}
+
+	return isrLoad;
+}
+
+/**
+ * @brief  Checks whether the measurements of the last APP_LOAD_PERIOD_MS can't be trusted:
+ *         captures were overwritten or the interrupt load reached APP_LOAD_WARN_PERMILLE.
+ * @param  None
+ * @retval 1 if overloaded, 0 otherwise
+ */
+u8 APP_IsOverloaded(void)
+{
+	return overloaded;
+}
+
+/**
+ * @brief  Returns the phase/delay measurement between the APP_PHASE_CH_A and APP_PHASE_CH_B inputs.
+ * @param  None
+ * @retval Pointer to the phase measurement, 0 if the inputs are not captured on the same timer
+ */
+PHASE_t* APP_PHASE_GetMeasurement(void)
+{
+	if (!phaseEnabled)
+	{
+		return 0;
+	}
+
+	return &phaseMeas;
+}
+
+/**
+ * @brief  Starts a logic analyzer record of the raw edges of the main measurement channel.
+ * @note   The main channel measurement is suspended until the record buffer is full.
  * @param  None
  * @retval None
  */
-void APP_GLCD_Update()
+void APP_LA_Start(void)
 {
-	// Check for changes in frequency
-	if (APP_IC_GetFreq_KHZ() != oldFreq)
+	// Every edge of the main channel is recorded at the timer clock
+	APP_IC_ResetCapturePrescaler();
+
+	laDrawn = 0;
+	EDGE_Start(&laCapture);
+}
+
+/**
+ * @brief  Starts a continuous logic analyzer record of the main measurement channel that is
+ *         frozen around the first edge meeting the trigger condition.
+ * @note   APP_LA_PRETRIGGER_PERCENT of the record is kept before the trigger edge.
+ *         The main channel measurement is suspended until the record is frozen.
+ * @param  trigger : Pointer to the trigger condition (times in timer ticks)
+ * @retval None
+ */
+void APP_LA_StartTriggered(const EDGE_Trigger_t *trigger)
+{
+	// Every edge of the main channel is recorded at the timer clock
+	APP_IC_ResetCapturePrescaler();
+
+	laDrawn = 0;
+	EDGE_StartTriggered(&laCapture, trigger, APP_LA_PRETRIGGER_PERCENT);
+}
+
+/**
+ * @brief  Returns the logic analyzer record.
+ * @param  None
+ * @retval Pointer to the edge capture record
+ */
+const EDGE_Capture_t* APP_LA_GetRecord(void)
+{
+	return &laCapture;
+}
+
+/**
+ * @brief  Starts the analog sampling shown on the analog view.
+ * @note   Refused if a measurement channel uses the SCOPE trigger timer, in gated mode, or while the half bridge runs.
+ * @param  sampleRate : Requested sample rate in Hz
+ * @retval Achieved sample rate in Hz, 0 if refused
+ */
+u32 APP_SCOPE_Start(u32 sampleRate)
+{
+	// The trigger timer also times the gates of the gated mode
+	if (APP_IC_IsTimerUsed(SCOPE_TRIG_TIMx) || measMode == AUTO_MODE_GATED || hbRunning)
 	{
-		// Update and print new frequency on the GLCD
-		oldFreq = APP_IC_GetFreq_KHZ();
-		APP_GLCD_PrintFreq();
+		return 0;
+	}
 
-		// Print new period on GLCD
-		APP_GLCD_PrintPeriod();
+	scopeHasFrame = 0;
+
+	return SCOPE_Start(sampleRate);
+}
+
+/**
+ * @brief  Stops the analog sampling.
+ * @param  None
+ * @retval None
+ */
+void APP_SCOPE_Stop(void)
+{
+	SCOPE_Stop();
+}
+
+/**
+ * @brief  Sets the time per division of the PWM view.
+ * @param  timePerDiv_us : Time per division in us (APP_TIMEBASE_MIN_US to APP_TIMEBASE_MAX_US)
+ * @retval None
+ */
+void APP_SetTimebase(u32 timePerDiv_us)
+{
+	if (timePerDiv_us < APP_TIMEBASE_MIN_US)
+	{
+		timePerDiv_us = APP_TIMEBASE_MIN_US;
+	}
+	else if (timePerDiv_us > APP_TIMEBASE_MAX_US)
+	{
+		timePerDiv_us = APP_TIMEBASE_MAX_US;
 	}
 
-	// Check for changes in duty cycle
-	if (APP_IC_GetDuty() != oldDuty)
+	timebaseDiv_us = timePerDiv_us;
+
+	if (currentView == APP_VIEW_PWM)
 	{
-		// Update and print new duty on the GLCD
-		oldDuty = APP_IC_GetDuty();
-		APP_GLCD_PrintDuty();
+		APP_GLCD_PrintTimebase();
+		APP_GLCD_DrawPWM();
+	}
+}
 
-		// Draw new PWM signal on GLCD
-		APP_GLCD_DrawPWM(oldDuty);
+/**
+ * @brief  Sets the horizontal position of the PWM view.
+ * @param  positionTime_us : Time in us between a rising edge and the left border of the GLCD
+ * @retval None
+ */
+void APP_SetPosition(u32 positionTime_us)
+{
+	position_us = positionTime_us;
+
+	if (currentView == APP_VIEW_PWM)
+	{
+		APP_GLCD_PrintTimebase();
+		APP_GLCD_DrawPWM();
+	}
+}
+
+/**
+ * @brief  Returns the time per division of the PWM view.
+ * @param  None
+ * @retval Time per division in us
+ */
+u32 APP_GetTimebase(void)
+{
+	return timebaseDiv_us;
+}
+
+/**
+ * @brief  Probes the main measurement channel input and selects its capture prescaler,
+ *         measurement mode and the timebase of the PWM view, within about 1 s.
+ * @note   In gated mode only the frequency of the main channel is measured: the capture
+ *         interrupts of its timer are masked and the duty cycle reads 0.
+ * @param  result : Pointer to the setting to be filled, may be 0
+ * @retval Autoset status from @ref APP_AutosetStatus_t
+ */
+APP_AutosetStatus_t APP_Autoset(AUTO_Setting_t *result)
+{
+	const MEAS_Config_t *mainConfig = &measConfigs[APP_MEAS_MAIN_CH];
+	const MEAS_Channel_t *mainChannel = &measChannels[APP_MEAS_MAIN_CH];
+	AUTO_Setting_t setting;
+	u32 count, captures;
+	u8 bursts = 0;
+	u8 captured = 0;
+
+	if (SCOPE_IsRunning() || laCapture.state == EDGE_ARMED || APP_IC_IsTimerUsed(APP_AUTOSET_GATE_TIMx) || hbRunning)
+	{
+		return APP_AUTOSET_BUSY;
+	}
+
+	if (measMode == AUTO_MODE_GATED)
+	{
+		APP_IC_StopGated();
+	}
+	TIM_Init(APP_AUTOSET_GATE_TIMx);
+
+	// Probe gate: the main channel timer counts the input edges, its captures are masked meanwhile
+	APP_IC_SetCaptureInterrupts(mainConfig->TIMx, TIM_INT_DISABLE);
+	TIM_SetPrescaler(mainConfig->TIMx, 0);
+	TIM_ExtClock_Start(mainConfig->TIMx, mainConfig->periodCh);
+	TIM_Gate_Start(APP_AUTOSET_GATE_TIMx, APP_AUTOSET_PROBE_GATE_US, TIM_INT_DISABLE);
+	count = TIM_GetCounter(mainConfig->TIMx);
+	APP_IC_WaitGate();
+	count = (TIM_GetCounter(mainConfig->TIMx) - count) & TIM_MAX_PERIOD;
+	TIM_Gate_Stop(APP_AUTOSET_GATE_TIMx);
+	TIM_ExtClock_Stop(mainConfig->TIMx);
+
+	AUTO_FromGatedCount(&setting, count, APP_AUTOSET_PROBE_GATE_US);
+
+	if (setting.mode == AUTO_MODE_GATED)
+	{
+		APP_IC_StartGated(&setting);
+		captured = 1;
+	}
+	else
+	{
+		// Capture bursts, the timer divider is refined from the captured period
+		do
+		{
+			APP_IC_ApplySetting(&setting);
+			captures = mainChannel->captures;
+			APP_IC_SetCaptureInterrupts(mainConfig->TIMx, TIM_INT_ENABLE);
+
+			captured = APP_IC_WaitBurst(captures);
+			bursts++;
+		} while (captured && AUTO_FromPeriod(&setting, mainChannel->periodTicks) && bursts < APP_AUTOSET_MAX_BURSTS);
+
+		if (!captured)
+		{
+			// No period within the timeout, back to the timer clock
+			setting.timerDivider = 1;
+			setting.capturePrescaler = 1;
+			setting.timePerDiv_us = 0;
+		}
+
+		// The last refinement may not have been captured yet
+		APP_IC_ApplySetting(&setting);
+	}
+
+	if (result != 0)
+	{
+		*result = setting;
+	}
+
+	// The period histogram bins are timer ticks of the previous setting
+	APP_HIST_Reset();
+
+	if (!captured)
+	{
+		return APP_AUTOSET_NO_SIGNAL;
+	}
+
+	position_us = 0;
+	APP_SetTimebase(setting.timePerDiv_us);
+
+	return APP_AUTOSET_OK;
+}
+
+/**
+ * @brief  Sweeps the PWM output across the SWEEP_FREQS_MHZ frequencies and SWEEP_DUTIES duty cycles
+ *         and measures every point on the main measurement channel, looped back to the output.
+ * @note   Blocking for about 0.2 s per point: every point runs APP_Autoset, then collects the
+ *         captures over SWEEP_WINDOW_US. The output keeps the last point.
+ * @param  None
+ * @retval Number of points measured, 0 if the analog sampling, logic analyzer or half bridge is running
+ */
+u8 APP_SWEEP_Run(void)
+{
+	const MEAS_Channel_t *mainChannel = &measChannels[APP_MEAS_MAIN_CH];
+	TIM_PWM_Setting_t generated;
+	AUTO_Setting_t setting;
+	SWEEP_Acc_t acc;
+	SWEEP_Point_t *point;
+	u32 frequency_mHz, duty;
+	u8 started = 0;
+
+	if (SCOPE_IsRunning() || laCapture.state == EDGE_ARMED || APP_IC_IsTimerUsed(APP_AUTOSET_GATE_TIMx) || hbRunning)
+	{
+		return 0;
+	}
+
+	for (u8 i = 0; i < SWEEP_POINT_COUNT; i++)
+	{
+		point = &sweepPoints[i];
+		SWEEP_GetTarget(i, &frequency_mHz, &duty);
+		SWEEP_ResetAcc(&acc);
+
+		point->status = SWEEP_POINT_OK;
+		point->frequency_mHz = frequency_mHz;
+		point->duty = duty;
+
+		// The output is started once, the next points are loaded at the end of a period
+		if (!TIM_PWM_Compute(frequency_mHz, duty, &generated))
+		{
+			point->status = SWEEP_POINT_SKIPPED;
+		}
+		else if (!started)
+		{
+			started = APP_PWM_StartFine(frequency_mHz, duty, 0);
+		}
+		else
+		{
+			TIM_PWM_Apply(APP_TIM_PWM_TIMx, APP_TIM_PWM_CHx, &generated);
+		}
+
+		if (point->status == SWEEP_POINT_OK)
+		{
+			point->frequency_mHz = generated.frequency_mHz;
+			point->duty = generated.duty;
+
+			if (APP_Autoset(&setting) != APP_AUTOSET_OK)
+			{
+				point->status = SWEEP_POINT_NO_SIGNAL;
+			}
+			else if (setting.mode == AUTO_MODE_GATED)
+			{
+				point->status = SWEEP_POINT_SKIPPED;  // No duty cycle captured in gated mode
+			}
+			else
+			{
+				APP_SWEEP_Collect(&acc);
+			}
+		}
+
+		SWEEP_Evaluate(point, &acc, mainChannel->tickRate, mainChannel->eventsPerCapture, SWEEP_WINDOW_US);
+	}
+
+	sweepCount = SWEEP_POINT_COUNT;
+
+	if (currentView == APP_VIEW_SWEEP)
+	{
+		APP_GLCD_UpdateSweep();
+	}
+
+	return sweepCount;
+}
+
+/**
+ * @brief  Returns the results of the last sweep, to be exported with SWEEP_FormatCsv.
+ * @param  count : Pointer to the number of points to be filled (0 if no sweep ran).
+ * @retval Pointer to the first point
+ */
+const SWEEP_Point_t* APP_SWEEP_GetResults(u8 *count)
+{
+	*count = sweepCount;
+
+	return sweepPoints;
+}
+
+/**
+ * @brief  Selects the page and columns of the sweep view, redrawn if shown.
+ * @param  page : Page of APP_SWEEP_ROWS points, wraps around after the last one
+ * @param  columns : Result columns (from @ref APP_SweepColumns_t)
+ * @retval None
+ */
+void APP_SWEEP_SetPage(u8 page, APP_SweepColumns_t columns)
+{
+	sweepPage = page;
+	sweepColumns = columns;
+
+	if (currentView == APP_VIEW_SWEEP)
+	{
+		APP_GLCD_UpdateSweep();
+	}
+}
+
+/**
+ * @brief  Starts streaming the capture records of the measurement channels on APP_TLM_USARTx,
+ *         an information frame is sent first and every APP_TLM_INFO_PERIOD task runs.
+ * @param  None
+ * @retval None
+ */
+void APP_TLM_Start(void)
+{
+	tlmInfoCountdown = 0;
+	tlmRunning = 1;
+}
+
+/**
+ * @brief  Stops adding records to the telemetry stream, the frames already closed are still sent.
+ * @param  None
+ * @retval None
+ */
+void APP_TLM_Stop(void)
+{
+	tlmRunning = 0;
+}
+
+/**
+ * @brief  Returns the records dropped because the link could not keep up.
+ * @param  None
+ * @retval Records lost since APP_Init
+ */
+u32 APP_TLM_GetLost(void)
+{
+	return tlm.lost;
+}
+
+/**
+ * @brief  Starts a screenshot: the GLCD lines are sent in TLM screen frames on APP_TLM_USARTx,
+ *         one every APP_SCREEN_PERIOD_MS when the link has room. The display is not refreshed
+ *         until the last line is sent.
+ * @param  None
+ * @retval 1 if the screenshot was started, 0 if one is being sent or the GLCD has no shadow copy
+ */
+u8 APP_Screenshot(void)
+{
+	if (screenNextLine < APP_SCREEN_LINE_COUNT || GLCD_GetLine(GLCD_LINE_0) == 0)
+	{
+		return 0;
 	}
 
+	screenNextLine = 0;
 
+	return 1;
 }
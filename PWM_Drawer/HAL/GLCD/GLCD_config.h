@@ -32,11 +32,18 @@
 /* GLCD Screen Size ----------------------------------------------*/
 #define GLCD_SCREEN_HALF_WIDTH (64U)
 #define GLCD_SCREEN_WIDTH (128U)
+#define GLCD_SCREEN_HEIGHT (64U)
+#define GLCD_LINE_HEIGHT (8U)
 
 /* Font Configurations -------------------------------------------*/
 #define GLCD_FONT_CHAR_WIDTH (7U)
 #define GLCD_FONT_ARRAY_COLS (8U)
 
+/* Shadow copy --------------------------------------------------*/
+/* The driver keeps a copy of the display RAM (1 KB) for GLCD_GetLine, reading the
+ * display back would need the data pins turned to inputs for every byte */
+#define GLCD_SHADOW_ENABLE (1U)
+
 /* GLCD Commands -------------------------------------------------*/
 #define GLCD_CMD_OFF (0x3E)
 #define GLCD_CMD_RESET_Y (0x40)
@@ -45,6 +52,6 @@
 #define GLCD_CMD_ON (0x3F)
 
 /* GLCD Delay ----------------------------------------------------*/
-#define T 1
+#define T (FCPU / 8000000UL)   // Scaled with the core clock so the bus timing stays the same
 
 #endif /* GLCD_GLCD_CONFIG_H_ */
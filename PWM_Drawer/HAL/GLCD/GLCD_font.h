@@ -7,7 +7,7 @@
  */
 #ifndef _FONT_H
 #define _FONT_H
- 	unsigned char Font[255][8] = {
+ 	const unsigned char Font[255][8] = {
 	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, //0/ -->
 	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, //1/ --> SOH
 	0x00,0x00,0x00,0x00,0x00,0x00,0x00,0x00, //2/ --> STX
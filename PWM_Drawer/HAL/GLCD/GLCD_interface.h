@@ -64,6 +64,15 @@ void GLCD_PrintNum(u32 num , u8 x , GLCD_LineNum_t y);
  * @retval None
  */
 void GLCD_PrintFloat(f32 num , u8 x ,GLCD_LineNum_t y);
+/**
+ * @brief  Prints a fixed-point number (num / 10^decimals) with all its decimals on the GLCD display.
+ * @param  num : Value in units of 10^-decimals
+ * @param  decimals : Number of decimal digits (0-9)
+ * @param  x : X coordinate
+ * @param  y : line number on GLCD (GLCD_LINE_0 to GLCD_LINE_7)
+ * @retval None
+ */
+void GLCD_PrintFixed(u32 num, u8 decimals, u8 x, GLCD_LineNum_t y);
 /**
  * @brief  Clears a specific line on the GLCD display
  * @param  y : line number on GLCD (GLCD_LINE_0 to GLCD_LINE_7)
@@ -88,4 +97,31 @@ void GLCD_DrawHLine(u8 x1, u8 x2, GLCD_LineNum_t y);
  */
 void GLCD_DrawVLine(GLCD_LineNum_t y1, GLCD_LineNum_t y2, u8 x);
 
+/**
+ * @brief  Draws a vertical span of pixels in a single column of the GLCD display.
+ * @note   Only the lines touched by the span are written, and the other pixels of
+ *         these lines in that column are cleared.
+ * @param  x : x coordinate (0-127)
+ * @param  y1 : The starting pixel row of the span (0-63).
+ * @param  y2 : The ending pixel row of the span (0-63).
+ * @retval None
+ */
+void GLCD_DrawColumn(u8 x, u8 y1, u8 y2);
+
+/**
+ * @brief  Clears the whole GLCD display
+ * @param  None
+ * @retval None
+ */
+void GLCD_ClearScreen(void);
+
+/**
+ * @brief  Returns the contents of a line as last written to the GLCD display.
+ * @note   Read from the shadow copy of the driver, see GLCD_SHADOW_ENABLE.
+ * @param  line : line number on GLCD (GLCD_LINE_0 to GLCD_LINE_7)
+ * @retval Pointer to the 128 column bytes of the line, bit 0 being the top pixel,
+ *         0 if the shadow copy is disabled
+ */
+const u8* GLCD_GetLine(GLCD_LineNum_t line);
+
 #endif /* GLCD_GLCD_INTERFACE_H_ */
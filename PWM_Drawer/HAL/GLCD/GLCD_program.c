@@ -10,11 +10,24 @@
 #include "STM32F103.h"
 
 #include "../../MCAL/GPIO/GPIO_interface.h"
+#include "../../MCAL/DWT/DWT_interface.h"
 
 #include "GLCD_interface.h"
 #include "GLCD_config.h"
 #include "GLCD_font.h"
 
+/* Private defines -----------------------------------------------------------*/
+#define GLCD_CHIP_LEFT  (0x01U)   // Controller of columns 0-63, selected by CS1
+#define GLCD_CHIP_RIGHT (0x02U)   // Controller of columns 64-127, selected by CS2
+#define GLCD_LINE_COUNT (GLCD_SCREEN_HEIGHT / GLCD_LINE_HEIGHT)
+
+/* Private variables ---------------------------------------------------------*/
+#if GLCD_SHADOW_ENABLE
+static u8 GLCD_Shadow[GLCD_LINE_COUNT][GLCD_SCREEN_WIDTH];
+static u8 GLCD_ShadowLine[2];     // Line address of each controller
+static u8 GLCD_ShadowColumn[2];   // Column address of each controller, incremented by every data write
+#endif
+
 /* Private Function Prototypes-------------------------------------------------*/
 
 /**
@@ -74,6 +87,22 @@ static void GLCD_GoTo_Col_Line(u8 x, u8 line);
  */
 static void GLCD_reverseString(char* str, int length) ;
 
+/**
+ * @brief  Follows the address set by a command in the shadow copy.
+ * @param  command : Command byte sent to the LCD.
+ * @param  chips : Controllers receiving the command (GLCD_CHIP_LEFT and/or GLCD_CHIP_RIGHT)
+ * @retval None
+ */
+static void GLCD_ShadowCommand(u8 command, u8 chips);
+
+/**
+ * @brief  Writes a data byte to the shadow copy at the address of its controller.
+ * @param  data : Data byte sent to the LCD.
+ * @param  x : X coordinate 0-127)
+ * @retval None
+ */
+static void GLCD_ShadowData(u8 data, u8 x);
+
 /* Private Functions ---------------------------------------------------------*/
 
 /**
@@ -97,6 +126,8 @@ static void Delay(u8 t)
  */
 static void GLCD_Send(u8 data)
 {
+	DWT_PROF_BEGIN(DWT_PROF_GLCD_SEND);
+
 	Delay(T);
 	GPIO_SetPinValue(GLCD_CTRL_PORT, GLCD_EN_PIN, GPIO_PIN_LOW); // Set Enable pin to low to initiate data transmission
 	Delay(T);
@@ -119,6 +150,8 @@ static void GLCD_Send(u8 data)
 
 	Delay(T);
 	GPIO_SetPinValue(GLCD_CTRL_PORT, GLCD_EN_PIN, GPIO_PIN_LOW); // Clear the Enable pin
+
+	DWT_PROF_END(DWT_PROF_GLCD_SEND);
 }
 
 /**
@@ -140,6 +173,7 @@ static void GLCD_SendCommand(u8 command)
 
 	// Send command to GLCD
 	GLCD_Send(command);
+	GLCD_ShadowCommand(command, GLCD_CHIP_LEFT | GLCD_CHIP_RIGHT);
 }
 
 /**
@@ -176,6 +210,8 @@ void GLCD_SendData(u8 data, u8 x)
 		// Send data to GLCD
 		GLCD_Send(data);
 	}
+
+	GLCD_ShadowData(data, x);
 }
 
 /**
@@ -215,6 +251,7 @@ static void GLCD_GoToColumn(u8 x)
 
 		// Send command to GLCD
 		GLCD_Send(x);
+		GLCD_ShadowCommand(x, GLCD_CHIP_LEFT);
 	}
 	else
 	{
@@ -231,6 +268,7 @@ static void GLCD_GoToColumn(u8 x)
 
 		// Send command to GLCD
 		GLCD_Send(x);
+		GLCD_ShadowCommand(x, GLCD_CHIP_RIGHT);
 	}
 }
 
@@ -273,6 +311,58 @@ static void GLCD_reverseString(char* str, int length)
 	    }
 }
 
+/**
+ * @brief  Follows the address set by a command in the shadow copy.
+ * @param  command : Command byte sent to the LCD.
+ * @param  chips : Controllers receiving the command (GLCD_CHIP_LEFT and/or GLCD_CHIP_RIGHT)
+ * @retval None
+ */
+static void GLCD_ShadowCommand(u8 command, u8 chips)
+{
+#if GLCD_SHADOW_ENABLE
+	for (u8 chip = 0; chip < 2U; chip++)
+	{
+		if (!(chips & (1U << chip)))
+		{
+			continue;
+		}
+
+		// Set page and set Y address commands from data sheet, the others keep the address
+		if ((command & 0xF8) == GLCD_CMD_RESET_X)
+		{
+			GLCD_ShadowLine[chip] = command & 0x07;
+		}
+		else if ((command & 0xC0) == GLCD_CMD_RESET_Y)
+		{
+			GLCD_ShadowColumn[chip] = command & 0x3F;
+		}
+	}
+#else
+	(void)command;
+	(void)chips;
+#endif
+}
+
+/**
+ * @brief  Writes a data byte to the shadow copy at the address of its controller.
+ * @param  data : Data byte sent to the LCD.
+ * @param  x : X coordinate 0-127)
+ * @retval None
+ */
+static void GLCD_ShadowData(u8 data, u8 x)
+{
+#if GLCD_SHADOW_ENABLE
+	u8 chip = (x < GLCD_SCREEN_HALF_WIDTH) ? 0U : 1U;
+
+	// Like the controller, the column wraps within its half of the screen
+	GLCD_Shadow[GLCD_ShadowLine[chip]][chip * GLCD_SCREEN_HALF_WIDTH + GLCD_ShadowColumn[chip]] = data;
+	GLCD_ShadowColumn[chip] = (GLCD_ShadowColumn[chip] + 1U) % GLCD_SCREEN_HALF_WIDTH;
+#else
+	(void)data;
+	(void)x;
+#endif
+}
+
 /*Public Functions -------------------------------------------------*/
 /**
  * @brief  Initializes GLCD display
@@ -421,6 +511,8 @@ void GLCD_PrintNum(u32 num , u8 x , u8 y)
  */
 void GLCD_PrintFloat(f32 num , u8 x , u8 y)
 {
+	DWT_PROF_BEGIN(DWT_PROF_GLCD_FLOAT);
+
 	  // Temporary array to store the converted string
 		char str[50];
 
@@ -459,6 +551,44 @@ void GLCD_PrintFloat(f32 num , u8 x , u8 y)
 	    str[i] = '\0';
 
 	    GLCD_PrintString(str, x, y);
+
+	DWT_PROF_END(DWT_PROF_GLCD_FLOAT);
+}
+
+/**
+ * @brief  Prints a fixed-point number (num / 10^decimals) with all its decimals on the GLCD display.
+ * @param  num : Value in units of 10^-decimals
+ * @param  decimals : Number of decimal digits (0-9)
+ * @param  x : X coordinate
+ * @param  y : line number on GLCD (GLCD_LINE_0 to GLCD_LINE_7)
+ * @retval None
+ */
+void GLCD_PrintFixed(u32 num, u8 decimals, u8 x, GLCD_LineNum_t y)
+{
+	// 10 digits, the decimal point, a leading zero and the terminator
+	char str[13];
+	int i = 0;
+
+	// Convert digits from least significant to most significant, at least one integer digit
+	do
+	{
+		str[i++] = '0' + num % 10;
+		num /= 10;
+
+		if (i == decimals)
+		{
+			str[i++] = '.';
+			if (num == 0)
+			{
+				str[i++] = '0';
+			}
+		}
+	} while (num != 0 || i < decimals);
+
+	GLCD_reverseString(str, i);
+	str[i] = '\0';
+
+	GLCD_PrintString(str, x, y);
 }
 
 
@@ -523,4 +653,81 @@ void GLCD_DrawVLine(GLCD_LineNum_t y1, GLCD_LineNum_t y2, u8 x)
 	}
 }
 
+/**
+ * @brief  Draws a vertical span of pixels in a single column of the GLCD display.
+ * @note   Only the lines touched by the span are written, and the other pixels of
+ *         these lines in that column are cleared.
+ * @param  x : x coordinate (0-127)
+ * @param  y1 : The starting pixel row of the span (0-63).
+ * @param  y2 : The ending pixel row of the span (0-63).
+ * @retval None
+ */
+void GLCD_DrawColumn(u8 x, u8 y1, u8 y2)
+{
+	u8 line, lineTop, mask;
+
+	// Order the span from top to bottom and keep it inside the screen
+	if (y1 > y2)
+	{
+		u8 temp = y1;
+		y1 = y2;
+		y2 = temp;
+	}
+	if (y2 >= GLCD_SCREEN_HEIGHT)
+	{
+		y2 = GLCD_SCREEN_HEIGHT - 1;
+	}
 
+	// Build one byte per touched line, bit 0 being the top pixel of the line
+	for (line = y1 / GLCD_LINE_HEIGHT; line <= y2 / GLCD_LINE_HEIGHT; line++)
+	{
+		lineTop = line * GLCD_LINE_HEIGHT;
+		mask = 0xFF;
+
+		if (y1 > lineTop)
+		{
+			mask &= (u8)(0xFF << (y1 - lineTop));
+		}
+		if (y2 < lineTop + GLCD_LINE_HEIGHT - 1)
+		{
+			mask &= (u8)(0xFF >> (lineTop + GLCD_LINE_HEIGHT - 1 - y2));
+		}
+
+		GLCD_GoTo_Col_Line(x, line);
+		GLCD_SendData(mask, x);
+	}
+}
+
+/**
+ * @brief  Clears the whole GLCD display
+ * @param  None
+ * @retval None
+ */
+void GLCD_ClearScreen(void)
+{
+	for (u8 line = GLCD_LINE_0; line <= GLCD_LINE_7; line++)
+	{
+		GLCD_ClearLine(line);
+	}
+}
+
+/**
+ * @brief  Returns the contents of a line as last written to the GLCD display.
+ * @note   Read from the shadow copy of the driver, see GLCD_SHADOW_ENABLE.
+ * @param  line : line number on GLCD (GLCD_LINE_0 to GLCD_LINE_7)
+ * @retval Pointer to the 128 column bytes of the line, bit 0 being the top pixel,
+ *         0 if the shadow copy is disabled
+ */
+const u8* GLCD_GetLine(GLCD_LineNum_t line)
+{
+#if GLCD_SHADOW_ENABLE
+	if (line < GLCD_LINE_COUNT)
+	{
+		return GLCD_Shadow[line];
+	}
+#else
+	(void)line;
+#endif
+
+	return 0;
+}
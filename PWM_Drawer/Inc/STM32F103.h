@@ -9,11 +9,16 @@
 #ifndef STM32F103_H_
 #define STM32F103_H_
 
-#define FCPU (8000000UL)
+#define FCPU (RCC_HCLK_HZ)   // Core clock derived from MCAL/RCC/RCC_config.h
 
 #include "../MCAL/GPIO/GPIO_private.h"
 #include "../MCAL/TIM/TIM_private.h"
 #include "../MCAL/NVIC/NVIC_private.h"
 #include "../MCAL/RCC/RCC_private.h"
+#include "../MCAL/ADC/ADC_private.h"
+#include "../MCAL/DMA/DMA_private.h"
+#include "../MCAL/DWT/DWT_private.h"
+#include "../MCAL/STK/STK_private.h"
+#include "../MCAL/USART/USART_private.h"
 
 #endif /* STM32F103_H_ */
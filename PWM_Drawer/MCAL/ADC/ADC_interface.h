@@ -0,0 +1,79 @@
+/**
+ ******************************************************************************
+ * @file    ADC_interface.h
+ * @author  Salma Faragalla
+ * @ brief  Header file of ADC module.
+ ******************************************************************************
+ */
+#ifndef ADC_ADC_INTERFACE_H_
+#define ADC_ADC_INTERFACE_H_
+
+#include "STM32F103.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef ADC_CH_t
+ * @brief Enumeration of ADC input channels (ADC_CH0-ADC_CH7 on PA0-PA7, ADC_CH8-ADC_CH9 on PB0-PB1).
+ */
+typedef enum {
+	ADC_CH0 = 0,
+	ADC_CH1,
+	ADC_CH2,
+	ADC_CH3,
+	ADC_CH4,
+	ADC_CH5,
+	ADC_CH6,
+	ADC_CH7,
+	ADC_CH8,
+	ADC_CH9,
+}ADC_CH_t;
+
+/**
+ * @typedef ADC_SampleTime_t
+ * @brief Enumeration of ADC sampling times in ADC clock cycles.
+ */
+typedef enum {
+	ADC_SMP_1_5 = 0,
+	ADC_SMP_7_5,
+	ADC_SMP_13_5,
+	ADC_SMP_28_5,
+	ADC_SMP_41_5,
+	ADC_SMP_55_5,
+	ADC_SMP_71_5,
+	ADC_SMP_239_5,
+}ADC_SampleTime_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Enables the clock of the ADC, powers it on and calibrates it.
+ * @param  ADCx : Pointer to the ADC peripheral (ADC1).
+ * @retval None
+ */
+void ADC_Init(volatile ADC_TypeDef *ADCx);
+
+/**
+ * @brief  Starts single channel conversions started by an external trigger, each result
+ *         being moved by DMA.
+ * @param  ADCx : Pointer to the ADC peripheral (ADC1).
+ * @param  ADC_CHx : Input channel (ADC_CH0 to ADC_CH9).
+ * @param  ADC_SampleTime : Sampling time from @ref ADC_SampleTime_t.
+ * @param  ADC_ExtSel : Trigger of the conversions from @defgroup ADC_EXTSEL.
+ * @retval None
+ */
+void ADC_StartTriggered(volatile ADC_TypeDef *ADCx, ADC_CH_t ADC_CHx, ADC_SampleTime_t ADC_SampleTime, u8 ADC_ExtSel);
+
+/**
+ * @brief  Stops the triggered conversions of the ADC.
+ * @param  ADCx : Pointer to the ADC peripheral (ADC1).
+ * @retval None
+ */
+void ADC_Stop(volatile ADC_TypeDef *ADCx);
+
+/**
+ * @brief  Returns the address of the ADC regular data register, to be used as DMA source.
+ * @param  ADCx : Pointer to the ADC peripheral (ADC1).
+ * @retval Address of the data register
+ */
+volatile u32* ADC_GetDataAddress(volatile ADC_TypeDef *ADCx);
+
+#endif /* ADC_ADC_INTERFACE_H_ */
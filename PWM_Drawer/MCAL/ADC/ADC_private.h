@@ -0,0 +1,81 @@
+/**
+ ******************************************************************************
+ * @file    ADC_private.h
+ * @author  Salma Faragalla
+ ******************************************************************************
+ */
+
+#ifndef ADC_ADC_PRIVATE_H_
+#define ADC_ADC_PRIVATE_H_
+
+typedef struct
+{
+	volatile u32 SR;
+	volatile u32 CR1;
+	volatile u32 CR2;
+	volatile u32 SMPR1;
+	volatile u32 SMPR2;
+	volatile u32 JOFR1;
+	volatile u32 JOFR2;
+	volatile u32 JOFR3;
+	volatile u32 JOFR4;
+	volatile u32 HTR;
+	volatile u32 LTR;
+	volatile u32 SQR1;
+	volatile u32 SQR2;
+	volatile u32 SQR3;
+	volatile u32 JSQR;
+	volatile u32 JDR1;
+	volatile u32 JDR2;
+	volatile u32 JDR3;
+	volatile u32 JDR4;
+	volatile u32 DR;
+
+}ADC_TypeDef;
+
+#define ADC1 ((volatile ADC_TypeDef*)0x40012400UL)
+
+/* ADC Register Pins*/
+
+/* SR */
+#define ADC_SR_AWD   (0UL)
+#define ADC_SR_EOC   (1UL)
+#define ADC_SR_JEOC  (2UL)
+#define ADC_SR_JSTRT (3UL)
+#define ADC_SR_STRT  (4UL)
+
+/* CR1 */
+#define ADC_CR1_EOCIE (5UL)
+#define ADC_CR1_SCAN  (8UL)
+
+/* ADC_CR2 */
+#define ADC_CR2_ADON    (0UL)
+#define ADC_CR2_CONT    (1UL)
+#define ADC_CR2_CAL     (2UL)
+#define ADC_CR2_RSTCAL  (3UL)
+#define ADC_CR2_DMA     (8UL)
+#define ADC_CR2_ALIGN   (11UL)
+#define ADC_CR2_EXTSEL  (17UL)
+#define ADC_CR2_EXTTRIG (20UL)
+#define ADC_CR2_SWSTART (22UL)
+
+/* ADC_SQR1 */
+#define ADC_SQR1_L (20UL)
+
+/* ADC_SMPRx */
+#define ADC_SMPR_BITS     (3UL)
+#define ADC_SMPR_MASK     (0x7UL)
+
+/* @defgroup ADC_EXTSEL : External event select for regular group */
+#define ADC_EXTSEL_TIM1_CC1  (0UL)
+#define ADC_EXTSEL_TIM1_CC2  (1UL)
+#define ADC_EXTSEL_TIM1_CC3  (2UL)
+#define ADC_EXTSEL_TIM2_CC2  (3UL)
+#define ADC_EXTSEL_TIM3_TRGO (4UL)
+#define ADC_EXTSEL_EXTI11    (6UL)
+#define ADC_EXTSEL_SWSTART   (7UL)
+#define ADC_EXTSEL_MASK      (7UL)
+
+#define ADC_RESOLUTION_MAX (4095UL)
+
+#endif /* ADC_ADC_PRIVATE_H_ */
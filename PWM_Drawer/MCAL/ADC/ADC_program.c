@@ -0,0 +1,127 @@
+/**
+ ******************************************************************************
+ * @file    ADC_program.c
+ * @author  Salma Faragalla
+ * @ brief  ADC module driver
+ ******************************************************************************
+ */
+/* Includes -------------------------------------------------------------------*/
+#include "BIT_MATH.h"
+
+#include "../GPIO/GPIO_interface.h"
+
+#include "ADC_interface.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define ADC_CAL_TIMEOUT (100000UL)
+#define ADC_STAB_DELAY  (1000UL)
+
+/*Private Functions prototypes -------------------------------------------------*/
+/**
+ * @brief  Configures the pin of an ADC input channel as analog input.
+ * @param  ADC_CHx : Input channel (ADC_CH0 to ADC_CH9).
+ * @retval None
+ */
+static void ADC_Pin_Init(ADC_CH_t ADC_CHx);
+
+/* Private Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Configures the pin of an ADC input channel as analog input.
+ * @param  ADC_CHx : Input channel (ADC_CH0 to ADC_CH9).
+ * @retval None
+ */
+static void ADC_Pin_Init(ADC_CH_t ADC_CHx)
+{
+	if (ADC_CHx <= ADC_CH7)
+	{
+		RCC_GPIOA_CLK_EN();
+		GPIO_SetPinDirSpeed(GPIOA, (GPIO_PinNum_t)ADC_CHx, GPIO_INPUT_ANLOG);
+	}
+	else
+	{
+		RCC_GPIOB_CLK_EN();
+		GPIO_SetPinDirSpeed(GPIOB, (GPIO_PinNum_t)(ADC_CHx - ADC_CH8), GPIO_INPUT_ANLOG);
+	}
+}
+
+/* Public Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Enables the clock of the ADC, powers it on and calibrates it.
+ * @param  ADCx : Pointer to the ADC peripheral (ADC1).
+ * @retval None
+ */
+void ADC_Init(volatile ADC_TypeDef *ADCx)
+{
+	u32 timeout;
+	volatile u32 delay;
+
+	if (ADCx == ADC1)
+	{
+		RCC_ADC1_CLK_EN();
+	}
+
+	SET_BIT(ADCx->CR2, ADC_CR2_ADON); // Power on the ADC
+
+	// Wait for the ADC to stabilize before the calibration
+	for (delay = 0; delay < ADC_STAB_DELAY; delay++);
+
+	// Reset and run the calibration
+	SET_BIT(ADCx->CR2, ADC_CR2_RSTCAL);
+	for (timeout = ADC_CAL_TIMEOUT; timeout && GET_BIT(ADCx->CR2, ADC_CR2_RSTCAL); timeout--);
+
+	SET_BIT(ADCx->CR2, ADC_CR2_CAL);
+	for (timeout = ADC_CAL_TIMEOUT; timeout && GET_BIT(ADCx->CR2, ADC_CR2_CAL); timeout--);
+}
+
+/**
+ * @brief  Starts single channel conversions started by an external trigger, each result
+ *         being moved by DMA.
+ * @param  ADCx : Pointer to the ADC peripheral (ADC1).
+ * @param  ADC_CHx : Input channel (ADC_CH0 to ADC_CH9).
+ * @param  ADC_SampleTime : Sampling time from @ref ADC_SampleTime_t.
+ * @param  ADC_ExtSel : Trigger of the conversions from @defgroup ADC_EXTSEL.
+ * @retval None
+ */
+void ADC_StartTriggered(volatile ADC_TypeDef *ADCx, ADC_CH_t ADC_CHx, ADC_SampleTime_t ADC_SampleTime, u8 ADC_ExtSel)
+{
+	/* Pin initialization for the input channel */
+	ADC_Pin_Init(ADC_CHx);
+
+	/* Sampling time of the channel */
+	ADCx->SMPR2 &= ~(ADC_SMPR_MASK << (ADC_CHx * ADC_SMPR_BITS));
+	ADCx->SMPR2 |= ((u32)ADC_SampleTime << (ADC_CHx * ADC_SMPR_BITS));
+
+	/* Regular sequence of a single conversion of the channel */
+	ADCx->SQR1 &= ~(0xFUL << ADC_SQR1_L);
+	ADCx->SQR3 = ADC_CHx;
+
+	/* Conversions started by the external trigger, right aligned, moved by DMA */
+	CLR_BIT(ADCx->CR1, ADC_CR1_SCAN);
+	CLR_BIT(ADCx->CR2, ADC_CR2_CONT);
+	CLR_BIT(ADCx->CR2, ADC_CR2_ALIGN);
+	ADCx->CR2 &= ~(ADC_EXTSEL_MASK << ADC_CR2_EXTSEL);
+	ADCx->CR2 |= ((u32)ADC_ExtSel << ADC_CR2_EXTSEL);
+	SET_BIT(ADCx->CR2, ADC_CR2_DMA);
+	SET_BIT(ADCx->CR2, ADC_CR2_EXTTRIG);
+}
+
+/**
+ * @brief  Stops the triggered conversions of the ADC.
+ * @param  ADCx : Pointer to the ADC peripheral (ADC1).
+ * @retval None
+ */
+void ADC_Stop(volatile ADC_TypeDef *ADCx)
+{
+	CLR_BIT(ADCx->CR2, ADC_CR2_EXTTRIG);
+	CLR_BIT(ADCx->CR2, ADC_CR2_DMA);
+}
+
+/**
+ * @brief  Returns the address of the ADC regular data register, to be used as DMA source.
+ * @param  ADCx : Pointer to the ADC peripheral (ADC1).
+ * @retval Address of the data register
+ */
+volatile u32* ADC_GetDataAddress(volatile ADC_TypeDef *ADCx)
+{
+	return &ADCx->DR;
+}
@@ -0,0 +1,140 @@
+/**
+ ******************************************************************************
+ * @file    DMA_interface.h
+ * @author  Salma Faragalla
+ * @ brief  Header file of DMA module.
+ ******************************************************************************
+ */
+#ifndef DMA_DMA_INTERFACE_H_
+#define DMA_DMA_INTERFACE_H_
+
+#include "STM32F103.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef DMA_CH_t
+ * @brief Enumeration of DMA1 channels.
+ */
+typedef enum {
+	DMA_CH1 = 0,
+	DMA_CH2,
+	DMA_CH3,
+	DMA_CH4,
+	DMA_CH5,
+	DMA_CH6,
+	DMA_CH7,
+}DMA_CH_t;
+
+/**
+ * @typedef DMA_Dir_t
+ * @brief Enumeration of DMA transfer directions.
+ */
+typedef enum {
+	DMA_PERIPH_TO_MEM = 0,
+	DMA_MEM_TO_PERIPH,
+}DMA_Dir_t;
+
+/**
+ * @typedef DMA_Size_t
+ * @brief Enumeration of DMA data sizes.
+ */
+typedef enum {
+	DMA_SIZE_8BIT = 0,
+	DMA_SIZE_16BIT,
+	DMA_SIZE_32BIT,
+}DMA_Size_t;
+
+/**
+ * @typedef DMA_Mode_t
+ * @brief Enumeration of DMA transfer modes.
+ */
+typedef enum {
+	DMA_MODE_NORMAL = 0,
+	DMA_MODE_CIRCULAR,
+}DMA_Mode_t;
+
+/**
+ * @typedef DMA_Priority_t
+ * @brief Enumeration of DMA channel priority levels.
+ */
+typedef enum {
+	DMA_PRIORITY_LOW = 0,
+	DMA_PRIORITY_MEDIUM,
+	DMA_PRIORITY_HIGH,
+	DMA_PRIORITY_VERY_HIGH,
+}DMA_Priority_t;
+
+/**
+ * @typedef DMA_Config_t
+ * @brief Configuration of a DMA channel transfer.
+ */
+typedef struct {
+	DMA_Dir_t      direction;  /*!< Transfer direction                          */
+	DMA_Mode_t     mode;       /*!< Normal or circular transfer                 */
+	DMA_Size_t     periphSize; /*!< Size of each peripheral access              */
+	DMA_Size_t     memSize;    /*!< Size of each memory access                  */
+	u8             periphInc;  /*!< 1 to increment the peripheral address       */
+	u8             memInc;     /*!< 1 to increment the memory address           */
+	DMA_Priority_t priority;   /*!< Priority against the other DMA channels     */
+}DMA_Config_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Enables the clock of DMA1.
+ * @param  None
+ * @retval None
+ */
+void DMA_Init(void);
+
+/**
+ * @brief  Configures and enables a DMA1 channel transfer.
+ *         The half transfer and transfer complete interrupts are enabled for the callbacks
+ *         registered on the channel before this call.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @param  config : Pointer to the transfer configuration.
+ * @param  periphAddress : Address of the peripheral register.
+ * @param  memAddress : Address of the memory buffer.
+ * @param  count : Number of data items to transfer.
+ * @retval None
+ */
+void DMA_Start(DMA_CH_t DMA_CHx, const DMA_Config_t *config, volatile void *periphAddress, void *memAddress, u16 count);
+
+/**
+ * @brief  Disables a DMA1 channel and its interrupts.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @retval None
+ */
+void DMA_Stop(DMA_CH_t DMA_CHx);
+
+/**
+ * @brief  Returns the number of data items left to transfer on a DMA1 channel.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @retval Remaining data items
+ */
+u16 DMA_GetRemaining(DMA_CH_t DMA_CHx);
+
+/**
+ * @brief  Returns the interrupt line of a DMA1 channel, to set its priority.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @retval Interrupt number
+ */
+IRQn_Type DMA_GetIRQn(DMA_CH_t DMA_CHx);
+
+/* Callback functions --------------------------------------------------------*/
+/**
+ * @brief  Sets the function called when half of the channel transfer is done.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @param  functionPtr : Pointer to the callback function.
+ * @retval None
+ */
+void DMA_SetHalfCallback(DMA_CH_t DMA_CHx, void ( *functionPtr ) ( void ));
+
+/**
+ * @brief  Sets the function called when the channel transfer is complete.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @param  functionPtr : Pointer to the callback function.
+ * @retval None
+ */
+void DMA_SetCompleteCallback(DMA_CH_t DMA_CHx, void ( *functionPtr ) ( void ));
+
+#endif /* DMA_DMA_INTERFACE_H_ */
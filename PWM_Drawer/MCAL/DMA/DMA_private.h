@@ -0,0 +1,57 @@
+/**
+ ******************************************************************************
+ * @file    DMA_private.h
+ * @author  Salma Faragalla
+ ******************************************************************************
+ */
+
+#ifndef DMA_DMA_PRIVATE_H_
+#define DMA_DMA_PRIVATE_H_
+
+#define DMA_CHANNEL_COUNT (7U)
+
+typedef struct
+{
+	volatile u32 CCR;
+	volatile u32 CNDTR;
+	volatile u32 CPAR;
+	volatile u32 CMAR;
+	u32 RESERVED;
+
+}DMA_Channel_TypeDef;
+
+typedef struct
+{
+	volatile u32 ISR;
+	volatile u32 IFCR;
+	DMA_Channel_TypeDef CH[DMA_CHANNEL_COUNT];
+
+}DMA_TypeDef;
+
+#define DMA1 ((volatile DMA_TypeDef*)0x40020000UL)
+
+/* DMA Register Pins*/
+
+/* DMA_CCRx */
+#define DMA_CCR_EN      (0UL)
+#define DMA_CCR_TCIE    (1UL)
+#define DMA_CCR_HTIE    (2UL)
+#define DMA_CCR_TEIE    (3UL)
+#define DMA_CCR_DIR     (4UL)
+#define DMA_CCR_CIRC    (5UL)
+#define DMA_CCR_PINC    (6UL)
+#define DMA_CCR_MINC    (7UL)
+#define DMA_CCR_PSIZE   (8UL)
+#define DMA_CCR_MSIZE   (10UL)
+#define DMA_CCR_PL      (12UL)
+#define DMA_CCR_MEM2MEM (14UL)
+
+/* DMA_ISR / DMA_IFCR : flags of channel x are shifted by (4 * x) */
+#define DMA_ISR_GIF  (0UL)
+#define DMA_ISR_TCIF (1UL)
+#define DMA_ISR_HTIF (2UL)
+#define DMA_ISR_TEIF (3UL)
+#define DMA_ISR_BITS (4UL)
+#define DMA_ISR_MASK (0xFUL)
+
+#endif /* DMA_DMA_PRIVATE_H_ */
@@ -0,0 +1,238 @@
+/**
+ ******************************************************************************
+ * @file    DMA_program.c
+ * @author  Salma Faragalla
+ * @ brief  DMA module driver
+ ******************************************************************************
+ */
+/* Includes -------------------------------------------------------------------*/
+#include "BIT_MATH.h"
+
+#include "../NVIC/NVIC_interface.h"
+#include "../DWT/DWT_interface.h"
+
+#include "DMA_interface.h"
+
+/* Private Variables -------------------------------------------------------------------*/
+static void (*DMA_Half_Callback_Ptr[DMA_CHANNEL_COUNT])(void);
+static void (*DMA_Complete_Callback_Ptr[DMA_CHANNEL_COUNT])(void);
+
+/*Private Functions prototypes -------------------------------------------------*/
+/**
+ * @brief  Clears the flags of a DMA1 channel and calls the callbacks of the pending events.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @retval None
+ */
+static void DMA_IRQ_Handle(DMA_CH_t DMA_CHx);
+
+/* Private Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Clears the flags of a DMA1 channel and calls the callbacks of the pending events.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @retval None
+ */
+static void DMA_IRQ_Handle(DMA_CH_t DMA_CHx)
+{
+	u32 flags;
+
+	DWT_ISR_Enter();
+
+	flags = (DMA1->ISR >> (DMA_CHx * DMA_ISR_BITS)) & DMA_ISR_MASK;
+
+	DMA1->IFCR = flags << (DMA_CHx * DMA_ISR_BITS);
+
+	if (GET_BIT(flags, DMA_ISR_HTIF) && DMA_Half_Callback_Ptr[DMA_CHx] != 0)
+	{
+		DMA_Half_Callback_Ptr[DMA_CHx]();
+	}
+
+	if (GET_BIT(flags, DMA_ISR_TCIF) && DMA_Complete_Callback_Ptr[DMA_CHx] != 0)
+	{
+		DMA_Complete_Callback_Ptr[DMA_CHx]();
+	}
+
+	DWT_ISR_Exit();
+}
+
+/* Public Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Enables the clock of DMA1.
+ * @param  None
+ * @retval None
+ */
+void DMA_Init(void)
+{
+	RCC_DMA1_CLK_EN();
+}
+
+/**
+ * @brief  Configures and enables a DMA1 channel transfer.
+ *         The half transfer and transfer complete interrupts are enabled for the callbacks
+ *         registered on the channel before this call.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @param  config : Pointer to the transfer configuration.
+ * @param  periphAddress : Address of the peripheral register.
+ * @param  memAddress : Address of the memory buffer.
+ * @param  count : Number of data items to transfer.
+ * @retval None
+ */
+void DMA_Start(DMA_CH_t DMA_CHx, const DMA_Config_t *config, volatile void *periphAddress, void *memAddress, u16 count)
+{
+	volatile DMA_Channel_TypeDef *channel = &DMA1->CH[DMA_CHx];
+	u32 ccr = 0;
+
+	/* Channel must be disabled while it is configured */
+	CLR_BIT(channel->CCR, DMA_CCR_EN);
+	DMA1->IFCR = DMA_ISR_MASK << (DMA_CHx * DMA_ISR_BITS);
+
+	channel->CPAR = (u32)periphAddress;
+	channel->CMAR = (u32)memAddress;
+	channel->CNDTR = count;
+
+	ccr |= ((u32)config->direction << DMA_CCR_DIR);
+	ccr |= ((u32)config->mode << DMA_CCR_CIRC);
+	ccr |= ((u32)(config->periphInc != 0) << DMA_CCR_PINC);
+	ccr |= ((u32)(config->memInc != 0) << DMA_CCR_MINC);
+	ccr |= ((u32)config->periphSize << DMA_CCR_PSIZE);
+	ccr |= ((u32)config->memSize << DMA_CCR_MSIZE);
+	ccr |= ((u32)config->priority << DMA_CCR_PL);
+
+	if (DMA_Half_Callback_Ptr[DMA_CHx] != 0)
+	{
+		SET_BIT(ccr, DMA_CCR_HTIE);
+	}
+	if (DMA_Complete_Callback_Ptr[DMA_CHx] != 0)
+	{
+		SET_BIT(ccr, DMA_CCR_TCIE);
+	}
+	if (GET_BIT(ccr, DMA_CCR_HTIE) || GET_BIT(ccr, DMA_CCR_TCIE))
+	{
+		NVIC_EnableIRQ(DMA_GetIRQn(DMA_CHx));
+	}
+
+	channel->CCR = ccr;
+	SET_BIT(channel->CCR, DMA_CCR_EN);
+}
+
+/**
+ * @brief  Disables a DMA1 channel and its interrupts.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @retval None
+ */
+void DMA_Stop(DMA_CH_t DMA_CHx)
+{
+	DMA1->CH[DMA_CHx].CCR = 0;
+	DMA1->IFCR = DMA_ISR_MASK << (DMA_CHx * DMA_ISR_BITS);
+}
+
+/**
+ * @brief  Returns the number of data items left to transfer on a DMA1 channel.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @retval Remaining data items
+ */
+u16 DMA_GetRemaining(DMA_CH_t DMA_CHx)
+{
+	return (u16)DMA1->CH[DMA_CHx].CNDTR;
+}
+
+/**
+ * @brief  Returns the interrupt line of a DMA1 channel, to set its priority.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @retval Interrupt number
+ */
+IRQn_Type DMA_GetIRQn(DMA_CH_t DMA_CHx)
+{
+	return (IRQn_Type)(DMA1_Channel1_IRQn + DMA_CHx);
+}
+
+/**
+ * @brief  Sets the function called when half of the channel transfer is done.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @param  functionPtr : Pointer to the callback function.
+ * @retval None
+ */
+void DMA_SetHalfCallback(DMA_CH_t DMA_CHx, void (*functionPtr)(void))
+{
+	DMA_Half_Callback_Ptr[DMA_CHx] = functionPtr;
+}
+
+/**
+ * @brief  Sets the function called when the channel transfer is complete.
+ * @param  DMA_CHx : DMA1 channel (DMA_CH1 to DMA_CH7).
+ * @param  functionPtr : Pointer to the callback function.
+ * @retval None
+ */
+void DMA_SetCompleteCallback(DMA_CH_t DMA_CHx, void (*functionPtr)(void))
+{
+	DMA_Complete_Callback_Ptr[DMA_CHx] = functionPtr;
+}
+
+/**
+ * @brief  DMA1 channel 1 interrupt handler.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel1_IRQHandler(void)
+{
+	DMA_IRQ_Handle(DMA_CH1);
+}
+
+/**
+ * @brief  DMA1 channel 2 interrupt handler.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel2_IRQHandler(void)
+{
+	DMA_IRQ_Handle(DMA_CH2);
+}
+
+/**
+ * @brief  DMA1 channel 3 interrupt handler.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel3_IRQHandler(void)
+{
+	DMA_IRQ_Handle(DMA_CH3);
+}
+
+/**
+ * @brief  DMA1 channel 4 interrupt handler.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel4_IRQHandler(void)
+{
+	DMA_IRQ_Handle(DMA_CH4);
+}
+
+/**
+ * @brief  DMA1 channel 5 interrupt handler.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel5_IRQHandler(void)
+{
+	DMA_IRQ_Handle(DMA_CH5);
+}
+
+/**
+ * @brief  DMA1 channel 6 interrupt handler.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel6_IRQHandler(void)
+{
+	DMA_IRQ_Handle(DMA_CH6);
+}
+
+/**
+ * @brief  DMA1 channel 7 interrupt handler.
+ * @param  None
+ * @retval None
+ */
+void DMA1_Channel7_IRQHandler(void)
+{
+	DMA_IRQ_Handle(DMA_CH7);
+}
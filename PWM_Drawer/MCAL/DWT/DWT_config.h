@@ -0,0 +1,25 @@
+/**
+ ******************************************************************************
+ * @file    DWT_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for DWT module.
+ ******************************************************************************
+ */
+#ifndef DWT_DWT_CONFIG_H_
+#define DWT_DWT_CONFIG_H_
+
+/* Profiling configurations ------------------------------------------------------*/
+/* 0 removes the profiling: the region macros expand to nothing and no table is kept */
+#define DWT_PROF_ENABLE (1)
+
+/* Profiled regions, a region is measured from one context only (thread or one interrupt) */
+#define DWT_PROF_IC_CAPTURE  (0U)   // Capture callback of the measurement channels
+#define DWT_PROF_GLCD_SEND   (1U)   // Byte write to the GLCD controller
+#define DWT_PROF_GLCD_FLOAT  (2U)   // Float formatting and printing
+#define DWT_PROF_DRAW_PWM    (3U)   // PWM waveform drawing
+#define DWT_PROF_REGION_COUNT (4U)
+
+/* Names shown on the diagnostics view, up to 9 characters */
+#define DWT_PROF_REGION_NAMES { "CAPTURE", "GLCD SEND", "GLCD FLT", "DRAW PWM" }
+
+#endif /* DWT_DWT_CONFIG_H_ */
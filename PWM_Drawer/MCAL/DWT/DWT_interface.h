@@ -0,0 +1,110 @@
+/**
+ ******************************************************************************
+ * @file    DWT_interface.h
+ * @author  Salma Faragalla
+ * @ brief  Header file of DWT (cycle counter) module.
+ ******************************************************************************
+ */
+#ifndef DWT_DWT_INTERFACE_H_
+#define DWT_DWT_INTERFACE_H_
+
+#include "STM32F103.h"
+
+#include "DWT_config.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef DWT_ProfStats_t
+ * @brief Cycle counts of a profiled region, the measurement overhead is removed.
+ */
+typedef struct
+{
+	u32 calls;   /*!< Completed runs of the region */
+	u32 min;     /*!< Shortest run in core cycles, 0xFFFFFFFF before the first run */
+	u32 max;     /*!< Longest run in core cycles */
+	u64 total;   /*!< Sum of all runs in core cycles */
+}DWT_ProfStats_t;
+
+/* Exported macros -----------------------------------------------------------*/
+#if DWT_PROF_ENABLE
+/* Opens a region in the current block, closed by DWT_PROF_END(region) before each exit of the block */
+#define DWT_PROF_BEGIN(region) u32 dwtProfStart_##region = DWT_GetCycles()
+#define DWT_PROF_END(region)   DWT_PROF_Record((region), DWT_GetCycles() - dwtProfStart_##region)
+/* Records a run already timed by the caller */
+#define DWT_PROF_ADD(region, cycles) DWT_PROF_Record((region), (cycles))
+#else
+#define DWT_PROF_BEGIN(region)
+#define DWT_PROF_END(region)
+#define DWT_PROF_ADD(region, cycles)
+#endif
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Starts the core cycle counter from zero.
+ * @param  None
+ * @retval None
+ */
+void DWT_Init(void);
+
+/**
+ * @brief  Returns the core cycle counter, wrapping every 2^32 cycles (about 60 s at 72 MHz).
+ * @param  None
+ * @retval Core clock cycles counted since DWT_Init
+ */
+u32 DWT_GetCycles(void);
+
+/**
+ * @brief  Marks the start of an interrupt handler for the interrupt load meter.
+ * @note   Nested handlers are counted once, within the handler they preempt.
+ * @param  None
+ * @retval None
+ */
+void DWT_ISR_Enter(void);
+
+/**
+ * @brief  Marks the end of an interrupt handler started with DWT_ISR_Enter.
+ * @param  None
+ * @retval None
+ */
+void DWT_ISR_Exit(void);
+
+/**
+ * @brief  Returns the core cycles spent in the marked interrupt handlers.
+ * @param  None
+ * @retval Cycles counted since DWT_Init, wrapping
+ */
+u32 DWT_ISR_GetCycles(void);
+
+#if DWT_PROF_ENABLE
+/**
+ * @brief  Adds a run to the statistics of a profiled region.
+ * @param  region : Region index (from DWT_config.h)
+ * @param  cycles : Duration of the run including the measurement overhead.
+ * @retval None
+ */
+void DWT_PROF_Record(u8 region, u32 cycles);
+
+/**
+ * @brief  Clears the statistics of all regions.
+ * @param  None
+ * @retval None
+ */
+void DWT_PROF_Reset(void);
+
+/**
+ * @brief  Copies the statistics of a region, consistent with a run recorded by an interrupt.
+ * @param  region : Region index (from DWT_config.h)
+ * @param  stats : Pointer to the copy to be filled
+ * @retval 1 if the region exists, 0 otherwise
+ */
+u8 DWT_PROF_GetStats(u8 region, DWT_ProfStats_t *stats);
+
+/**
+ * @brief  Returns the name of a region.
+ * @param  region : Region index (from DWT_config.h)
+ * @retval Name of the region, "?" if the region does not exist
+ */
+const char* DWT_PROF_GetName(u8 region);
+#endif
+
+#endif /* DWT_DWT_INTERFACE_H_ */
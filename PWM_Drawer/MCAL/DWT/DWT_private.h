@@ -0,0 +1,30 @@
+/**
+ ******************************************************************************
+ * @file    DWT_private.h
+ * @author  Salma Faragalla
+ ******************************************************************************
+ */
+
+#ifndef DWT_DWT_PRIVATE_H_
+#define DWT_DWT_PRIVATE_H_
+
+typedef struct
+{
+	volatile u32 CTRL;
+	volatile u32 CYCCNT;
+
+}DWT_TypeDef;
+
+#define DWT ((volatile DWT_TypeDef*)0xE0001000UL)
+
+#define CoreDebug_DEMCR (*(volatile u32*)0xE000EDFCUL)
+
+/* DWT Register Pins*/
+
+/* DWT_CTRL */
+#define DWT_CTRL_CYCCNTENA (0UL)
+
+/* CoreDebug_DEMCR */
+#define DEMCR_TRCENA (24UL)
+
+#endif /* DWT_DWT_PRIVATE_H_ */
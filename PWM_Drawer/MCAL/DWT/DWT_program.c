@@ -0,0 +1,180 @@
+/**
+ ******************************************************************************
+ * @file    DWT_program.c
+ * @author  Salma Faragalla
+ * @ brief  DWT (cycle counter) module driver
+ ******************************************************************************
+ */
+/* Includes -------------------------------------------------------------------*/
+#include "BIT_MATH.h"
+
+#include "../NVIC/NVIC_interface.h"
+
+#include "DWT_interface.h"
+
+/* Private variables ---------------------------------------------------------*/
+static u32 DWT_IsrDepth = 0;            // Nesting of the marked handlers, restored by a handler before it returns
+static u32 DWT_IsrStart = 0;            // Cycle counter at the entry of the outermost handler
+static volatile u32 DWT_IsrCycles = 0;
+
+#if DWT_PROF_ENABLE
+static DWT_ProfStats_t DWT_ProfStats[DWT_PROF_REGION_COUNT];
+static const char* const DWT_ProfNames[DWT_PROF_REGION_COUNT] = DWT_PROF_REGION_NAMES;
+static u32 DWT_ProfOverhead = 0;  // Cycles of an empty region, removed from every run
+#endif
+
+/* Public Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Starts the core cycle counter from zero.
+ * @param  None
+ * @retval None
+ */
+void DWT_Init(void)
+{
+	SET_BIT(CoreDebug_DEMCR, DEMCR_TRCENA);  // The DWT unit is only clocked with trace enabled
+	DWT->CYCCNT = 0;
+	SET_BIT(DWT->CTRL, DWT_CTRL_CYCCNTENA);
+
+#if DWT_PROF_ENABLE
+	// Cost of the two counter reads of an empty region
+	u32 start = DWT_GetCycles();
+	DWT_ProfOverhead = DWT_GetCycles() - start;
+	DWT_PROF_Reset();
+#endif
+}
+
+/**
+ * @brief  Returns the core cycle counter, wrapping every 2^32 cycles (about 60 s at 72 MHz).
+ * @param  None
+ * @retval Core clock cycles counted since DWT_Init
+ */
+u32 DWT_GetCycles(void)
+{
+	return DWT->CYCCNT;
+}
+
+/**
+ * @brief  Marks the start of an interrupt handler for the interrupt load meter.
+ * @note   Nested handlers are counted once, within the handler they preempt.
+ * @param  None
+ * @retval None
+ */
+void DWT_ISR_Enter(void)
+{
+	if (DWT_IsrDepth++ == 0)
+	{
+		DWT_IsrStart = DWT->CYCCNT;
+	}
+}
+
+/**
+ * @brief  Marks the end of an interrupt handler started with DWT_ISR_Enter.
+ * @param  None
+ * @retval None
+ */
+void DWT_ISR_Exit(void)
+{
+	if (--DWT_IsrDepth == 0)
+	{
+		DWT_IsrCycles += DWT->CYCCNT - DWT_IsrStart;
+	}
+}
+
+/**
+ * @brief  Returns the core cycles spent in the marked interrupt handlers.
+ * @param  None
+ * @retval Cycles counted since DWT_Init, wrapping
+ */
+u32 DWT_ISR_GetCycles(void)
+{
+	return DWT_IsrCycles;
+}
+
+#if DWT_PROF_ENABLE
+/**
+ * @brief  Adds a run to the statistics of a profiled region.
+ * @param  region : Region index (from DWT_config.h)
+ * @param  cycles : Duration of the run including the measurement overhead.
+ * @retval None
+ */
+void DWT_PROF_Record(u8 region, u32 cycles)
+{
+	DWT_ProfStats_t *stats;
+
+	if (region >= DWT_PROF_REGION_COUNT)
+	{
+		return;
+	}
+
+	stats = &DWT_ProfStats[region];
+	cycles = (cycles > DWT_ProfOverhead) ? (cycles - DWT_ProfOverhead) : 0;
+
+	if (cycles < stats->min)
+	{
+		stats->min = cycles;
+	}
+	if (cycles > stats->max)
+	{
+		stats->max = cycles;
+	}
+	stats->total += cycles;
+	stats->calls++;
+}
+
+/**
+ * @brief  Clears the statistics of all regions.
+ * @param  None
+ * @retval None
+ */
+void DWT_PROF_Reset(void)
+{
+	u32 state = NVIC_EnterCritical();
+
+	for (u8 i = 0; i < DWT_PROF_REGION_COUNT; i++)
+	{
+		DWT_ProfStats[i].calls = 0;
+		DWT_ProfStats[i].min = 0xFFFFFFFFUL;
+		DWT_ProfStats[i].max = 0;
+		DWT_ProfStats[i].total = 0;
+	}
+
+	NVIC_ExitCritical(state);
+}
+
+/**
+ * @brief  Copies the statistics of a region, consistent with a run recorded by an interrupt.
+ * @param  region : Region index (from DWT_config.h)
+ * @param  stats : Pointer to the copy to be filled
+ * @retval 1 if the region exists, 0 otherwise
+ */
+u8 DWT_PROF_GetStats(u8 region, DWT_ProfStats_t *stats)
+{
+	u32 state;
+
+	if (region >= DWT_PROF_REGION_COUNT)
+	{
+		return 0;
+	}
+
+	state = NVIC_EnterCritical();
+	*stats = DWT_ProfStats[region];
+	NVIC_ExitCritical(state);
+
+	return 1;
+}
+
+/**
+ * @brief  Returns the name of a region.
+ * @param  region : Region index (from DWT_config.h)
+ * @retval Name of the region, "?" if the region does not exist
+ */
+const char* DWT_PROF_GetName(u8 region)
+{
+	if (region >= DWT_PROF_REGION_COUNT)
+	{
+		return "?";
+	}
+
+	return DWT_ProfNames[region];
+}
+#endif
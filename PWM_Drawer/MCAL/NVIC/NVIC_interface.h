@@ -10,6 +10,21 @@
 
 #include "STM32F103.h"
 
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef NVIC_PriorityGroup_t
+ * @brief Enumeration of priority groupings, splitting the 4 priority bits into
+ *        preemption priority and subpriority.
+ */
+typedef enum {
+	NVIC_GROUP_PRE16_SUB1 = 3,   /*!< 16 preemption priorities, no subpriority */
+	NVIC_GROUP_PRE8_SUB2,        /*!< 8 preemption priorities, 2 subpriorities */
+	NVIC_GROUP_PRE4_SUB4,        /*!< 4 preemption priorities, 4 subpriorities */
+	NVIC_GROUP_PRE2_SUB8,        /*!< 2 preemption priorities, 8 subpriorities */
+	NVIC_GROUP_PRE1_SUB16        /*!< No preemption, 16 subpriorities */
+}NVIC_PriorityGroup_t;
+
+/* Exported functions --------------------------------------------------------*/
 /**
  * @brief Enables the specified interrupt in the Nested Vectored Interrupt Controller.
  * @param IRQn : Interrupt number to be enabled.
@@ -17,4 +32,89 @@
  */
 void NVIC_EnableIRQ(IRQn_Type IRQn);
 
+/**
+ * @brief Disables the specified interrupt in the Nested Vectored Interrupt Controller.
+ * @param IRQn : Interrupt number to be disabled.
+ * @retval None
+ */
+void NVIC_DisableIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Sets the pending state of an interrupt, it runs as soon as its priority allows.
+ * @param IRQn : Interrupt number.
+ * @retval None
+ */
+void NVIC_SetPendingIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Clears the pending state of an interrupt.
+ * @param IRQn : Interrupt number.
+ * @retval None
+ */
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Checks the pending state of an interrupt.
+ * @param IRQn : Interrupt number.
+ * @retval 1 if pending, 0 otherwise
+ */
+u8 NVIC_GetPendingIRQ(IRQn_Type IRQn);
+
+/**
+ * @brief Sets how the priority bits split into preemption priority and subpriority.
+ * @note  To be called once before the priorities are set, they are encoded with the grouping.
+ * @param group : Priority grouping from @ref NVIC_PriorityGroup_t.
+ * @retval None
+ */
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroup_t group);
+
+/**
+ * @brief Sets the priority of an interrupt or of a system exception (negative IRQn).
+ * @note  Lower values are more urgent. An interrupt only preempts another one
+ *        of a numerically higher preemption priority.
+ * @param IRQn : Interrupt number.
+ * @param preemptPriority : Preemption priority, limited by the grouping.
+ * @param subPriority : Order of pending interrupts of the same preemption priority.
+ * @retval None
+ */
+void NVIC_SetPriority(IRQn_Type IRQn, u8 preemptPriority, u8 subPriority);
+
+/**
+ * @brief Masks all maskable interrupts (PRIMASK).
+ * @retval Previous mask state, to be passed to NVIC_ExitCritical
+ */
+u32 NVIC_EnterCritical(void);
+
+/**
+ * @brief Restores the interrupt mask saved by NVIC_EnterCritical, sections may be nested.
+ * @param state : Mask state returned by NVIC_EnterCritical.
+ * @retval None
+ */
+void NVIC_ExitCritical(u32 state);
+
+/**
+ * @brief Masks the interrupts of a preemption priority and the less urgent ones (BASEPRI),
+ *        the more urgent ones keep running.
+ * @note  Only raises the mask, a section nested in a stricter one keeps the stricter mask.
+ * @param preemptPriority : Most urgent preemption priority to be masked (1 or more).
+ * @retval Previous mask, to be passed to NVIC_RestoreBasePriority
+ */
+u32 NVIC_RaiseBasePriority(u8 preemptPriority);
+
+/**
+ * @brief Restores the priority mask saved by NVIC_RaiseBasePriority.
+ * @param state : Mask returned by NVIC_RaiseBasePriority.
+ * @retval None
+ */
+void NVIC_RestoreBasePriority(u32 state);
+
+/**
+ * @brief Sleeps the core until an interrupt is pending (WFI).
+ * @note  A pending interrupt also wakes the core inside NVIC_EnterCritical, it is then
+ *        taken at NVIC_ExitCritical: checking for work and sleeping in the same section
+ *        can't miss an interrupt raised in between.
+ * @retval None
+ */
+void NVIC_WaitForInterrupt(void);
+
 #endif /* NVIC_NVIC_INTERFACE_H_ */
@@ -20,13 +20,34 @@ typedef struct
         u32 RESERVED3[24U];
    volatile u32 IABR[8U];               /*!< Offset: 0x200 (R/W)  Interrupt Active bit Register */
         u32 RESERVED4[56U];
-   volatile u32  IP[240U];               /*!< Offset: 0x300 (R/W)  Interrupt Priority Register (8Bit wide) */
+   volatile u8  IP[240U];                /*!< Offset: 0x300 (R/W)  Interrupt Priority Register (8Bit wide) */
         u32 RESERVED5[644U];
    volatile u32 STIR;                   /*!< Offset: 0xE00 ( /W)  Software Trigger Interrupt Register */
 }  NVIC_Type;
 
 #define NVIC                ((NVIC_Type      *)    0xE000E100UL    )   /*!< NVIC configuration struct */
 
+typedef struct
+{
+   volatile u32 CPUID;                  /*!< Offset: 0x000 (R/ )  CPUID Base Register */
+   volatile u32 ICSR;                   /*!< Offset: 0x004 (R/W)  Interrupt Control and State Register */
+   volatile u32 VTOR;                   /*!< Offset: 0x008 (R/W)  Vector Table Offset Register */
+   volatile u32 AIRCR;                  /*!< Offset: 0x00C (R/W)  Application Interrupt and Reset Control Register */
+   volatile u32 SCR;                    /*!< Offset: 0x010 (R/W)  System Control Register */
+   volatile u32 CCR;                    /*!< Offset: 0x014 (R/W)  Configuration Control Register */
+   volatile u8  SHP[12U];               /*!< Offset: 0x018 (R/W)  System Handlers Priority Registers (4-7, 8-11, 12-15) */
+}  SCB_Type;
+
+#define SCB                 ((SCB_Type       *)    0xE000ED00UL    )   /*!< System control block */
+
+/* SCB_AIRCR */
+#define AIRCR_PRIGROUP      (8UL)
+#define AIRCR_PRIGROUP_MASK (7UL)
+#define AIRCR_VECTKEY       (16UL)
+#define AIRCR_VECTKEY_VALUE (0x05FAUL)          // Written with every AIRCR access, or the write is ignored
+
+#define NVIC_PRIO_BITS      (4UL)               // Priority bits implemented by the STM32F1, upper bits of each byte
+
 
 /*!< Interrupt Number Definition */
 typedef enum
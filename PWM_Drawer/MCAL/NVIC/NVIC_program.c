@@ -10,6 +10,44 @@
 
 #include "NVIC_interface.h"
 
+/* Private functions prototypes ----------------------------------------------*/
+/**
+ * @brief Encodes a priority into the implemented bits of a priority byte with the current grouping.
+ * @param preemptPriority : Preemption priority.
+ * @param subPriority : Subpriority.
+ * @retval Priority byte
+ */
+static u8 NVIC_EncodePriority(u8 preemptPriority, u8 subPriority);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief Encodes a priority into the implemented bits of a priority byte with the current grouping.
+ * @param preemptPriority : Preemption priority.
+ * @param subPriority : Subpriority.
+ * @retval Priority byte
+ */
+static u8 NVIC_EncodePriority(u8 preemptPriority, u8 subPriority)
+{
+	u32 group = (SCB->AIRCR >> AIRCR_PRIGROUP) & AIRCR_PRIGROUP_MASK;
+	u32 subBits = (group > 7UL - NVIC_PRIO_BITS) ? (group - (7UL - NVIC_PRIO_BITS)) : 0UL;
+	u32 preemptBits = NVIC_PRIO_BITS - subBits;
+	u32 priority;
+
+	// Out of range values are clamped to the least urgent level
+	if (preemptPriority >= (1UL << preemptBits))
+	{
+		preemptPriority = (u8)((1UL << preemptBits) - 1UL);
+	}
+	if (subPriority >= (1UL << subBits))
+	{
+		subPriority = (u8)((1UL << subBits) - 1UL);
+	}
+
+	priority = ((u32)preemptPriority << subBits) | subPriority;
+
+	return (u8)(priority << (8UL - NVIC_PRIO_BITS));
+}
+
 /* Public functions -------------------------------------------------------------*/
 /**
  * @brief Enables the specified interrupt in the Nested Vectored Interrupt Controller.
@@ -18,8 +56,166 @@
  */
 void NVIC_EnableIRQ(IRQn_Type IRQn)
 {
-  if ((u32)(IRQn) >= 0)
-  {
-    NVIC->ISER[(((u32)IRQn) >> 5UL)] = (u32)(1UL << (((u32)IRQn) & 0x1FUL));
-  }
+	if ((s32)IRQn >= 0)
+	{
+		NVIC->ISER[(((u32)IRQn) >> 5UL)] = (u32)(1UL << (((u32)IRQn) & 0x1FUL));
+	}
+}
+
+/**
+ * @brief Disables the specified interrupt in the Nested Vectored Interrupt Controller.
+ * @param IRQn : Interrupt number to be disabled.
+ * @retval None
+ */
+void NVIC_DisableIRQ(IRQn_Type IRQn)
+{
+	if ((s32)IRQn >= 0)
+	{
+		NVIC->ICER[(((u32)IRQn) >> 5UL)] = (u32)(1UL << (((u32)IRQn) & 0x1FUL));
+	}
+}
+
+/**
+ * @brief Sets the pending state of an interrupt, it runs as soon as its priority allows.
+ * @param IRQn : Interrupt number.
+ * @retval None
+ */
+void NVIC_SetPendingIRQ(IRQn_Type IRQn)
+{
+	if ((s32)IRQn >= 0)
+	{
+		NVIC->ISPR[(((u32)IRQn) >> 5UL)] = (u32)(1UL << (((u32)IRQn) & 0x1FUL));
+	}
+}
+
+/**
+ * @brief Clears the pending state of an interrupt.
+ * @param IRQn : Interrupt number.
+ * @retval None
+ */
+void NVIC_ClearPendingIRQ(IRQn_Type IRQn)
+{
+	if ((s32)IRQn >= 0)
+	{
+		NVIC->ICPR[(((u32)IRQn) >> 5UL)] = (u32)(1UL << (((u32)IRQn) & 0x1FUL));
+	}
+}
+
+/**
+ * @brief Checks the pending state of an interrupt.
+ * @param IRQn : Interrupt number.
+ * @retval 1 if pending, 0 otherwise
+ */
+u8 NVIC_GetPendingIRQ(IRQn_Type IRQn)
+{
+	if ((s32)IRQn < 0)
+	{
+		return 0;
+	}
+
+	return (u8)((NVIC->ISPR[(((u32)IRQn) >> 5UL)] >> (((u32)IRQn) & 0x1FUL)) & 0x01UL);
+}
+
+/**
+ * @brief Sets how the priority bits split into preemption priority and subpriority.
+ * @note  To be called once before the priorities are set, they are encoded with the grouping.
+ * @param group : Priority grouping from @ref NVIC_PriorityGroup_t.
+ * @retval None
+ */
+void NVIC_SetPriorityGrouping(NVIC_PriorityGroup_t group)
+{
+	u32 aircr = SCB->AIRCR;
+
+	// VECTKEY reads back differently, it is rewritten with every access
+	aircr &= ~((0xFFFFUL << AIRCR_VECTKEY) | (AIRCR_PRIGROUP_MASK << AIRCR_PRIGROUP));
+	aircr |= (AIRCR_VECTKEY_VALUE << AIRCR_VECTKEY) | (((u32)group & AIRCR_PRIGROUP_MASK) << AIRCR_PRIGROUP);
+	SCB->AIRCR = aircr;
+}
+
+/**
+ * @brief Sets the priority of an interrupt or of a system exception (negative IRQn).
+ * @note  Lower values are more urgent. An interrupt only preempts another one
+ *        of a numerically higher preemption priority.
+ * @param IRQn : Interrupt number.
+ * @param preemptPriority : Preemption priority, limited by the grouping.
+ * @param subPriority : Order of pending interrupts of the same preemption priority.
+ * @retval None
+ */
+void NVIC_SetPriority(IRQn_Type IRQn, u8 preemptPriority, u8 subPriority)
+{
+	u8 priority = NVIC_EncodePriority(preemptPriority, subPriority);
+
+	if ((s32)IRQn >= 0)
+	{
+		NVIC->IP[(u32)IRQn] = priority;
+	}
+	else
+	{
+		// System handlers 4 to 15 (MemManage to SysTick)
+		SCB->SHP[(((u32)IRQn) & 0x0FUL) - 4UL] = priority;
+	}
+}
+
+/**
+ * @brief Masks all maskable interrupts (PRIMASK).
+ * @retval Previous mask state, to be passed to NVIC_ExitCritical
+ */
+u32 NVIC_EnterCritical(void)
+{
+	u32 state;
+
+	__asm volatile ("MRS %0, PRIMASK\n\tCPSID i" : "=r" (state) : : "memory");
+
+	return state;
+}
+
+/**
+ * @brief Restores the interrupt mask saved by NVIC_EnterCritical, sections may be nested.
+ * @param state : Mask state returned by NVIC_EnterCritical.
+ * @retval None
+ */
+void NVIC_ExitCritical(u32 state)
+{
+	__asm volatile ("MSR PRIMASK, %0" : : "r" (state) : "memory");
+}
+
+/**
+ * @brief Masks the interrupts of a preemption priority and the less urgent ones (BASEPRI),
+ *        the more urgent ones keep running.
+ * @note  Only raises the mask, a section nested in a stricter one keeps the stricter mask.
+ * @param preemptPriority : Most urgent preemption priority to be masked (1 or more).
+ * @retval Previous mask, to be passed to NVIC_RestoreBasePriority
+ */
+u32 NVIC_RaiseBasePriority(u8 preemptPriority)
+{
+	u32 state;
+	u32 level = NVIC_EncodePriority(preemptPriority, 0);
+
+	// BASEPRI_MAX ignores a write that would lower the current mask (0 being no mask)
+	__asm volatile ("MRS %0, BASEPRI" : "=r" (state));
+	__asm volatile ("MSR BASEPRI_MAX, %0" : : "r" (level) : "memory");
+
+	return state;
+}
+
+/**
+ * @brief Restores the priority mask saved by NVIC_RaiseBasePriority.
+ * @param state : Mask returned by NVIC_RaiseBasePriority.
+ * @retval None
+ */
+void NVIC_RestoreBasePriority(u32 state)
+{
+	__asm volatile ("MSR BASEPRI, %0" : : "r" (state) : "memory");
+}
+
+/**
+ * @brief Sleeps the core until an interrupt is pending (WFI).
+ * @note  A pending interrupt also wakes the core inside NVIC_EnterCritical, it is then
+ *        taken at NVIC_ExitCritical: checking for work and sleeping in the same section
+ *        can't miss an interrupt raised in between.
+ * @retval None
+ */
+void NVIC_WaitForInterrupt(void)
+{
+	__asm volatile ("DSB\n\tWFI" : : : "memory");
 }
@@ -0,0 +1,25 @@
+/**
+ ******************************************************************************
+ * @file    RCC_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for RCC module.
+ ******************************************************************************
+ */
+#ifndef RCC_RCC_CONFIG_H_
+#define RCC_RCC_CONFIG_H_
+
+/* System clock configurations -------------------------------------------------*/
+#define RCC_CLK_SRC (RCC_SRC_PLL_HSE)  // From @defgroup RCC_CLK_SRC
+#define RCC_HSE_HZ  (8000000UL)        // Crystal of the board
+#define RCC_PLL_MUL (9UL)              // 2-16, 8 MHz x 9 = 72 MHz
+
+/* Bus prescalers ----------------------------------------------------------------*/
+#define RCC_AHB_DIV  (1UL)             // 1, 2, 4, 8, 16, 64, 128, 256, or 512
+#define RCC_APB1_DIV (2UL)             // 1, 2, 4, 8, or 16; APB1 is limited to 36 MHz
+#define RCC_APB2_DIV (1UL)             // 1, 2, 4, 8, or 16
+#define RCC_ADC_DIV  (6UL)             // 2, 4, 6, or 8 from APB2; the ADC is limited to 14 MHz
+
+/* Start-up configurations -------------------------------------------------------*/
+#define RCC_READY_TIMEOUT (100000UL)   // Polling iterations for an oscillator, the PLL or the switch
+
+#endif /* RCC_RCC_CONFIG_H_ */
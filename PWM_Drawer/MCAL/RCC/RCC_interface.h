@@ -0,0 +1,34 @@
+/**
+ ******************************************************************************
+ * @file    RCC_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of RCC module.
+ ******************************************************************************
+ */
+#ifndef RCC_RCC_INTERFACE_H_
+#define RCC_RCC_INTERFACE_H_
+
+#include "STM32F103.h"
+
+/**
+ * @typedef RCC_Status_t
+ * @brief Enumeration of clock configuration results.
+ */
+typedef enum
+{
+	RCC_OK = 0,       /*!< Clock tree configured as in RCC_config.h */
+	RCC_ERR_HSE,      /*!< The crystal did not start, the system stays on HSI */
+	RCC_ERR_PLL,      /*!< The PLL did not lock, the system stays on HSI */
+	RCC_ERR_SWITCH    /*!< The system clock switch did not complete */
+}RCC_Status_t;
+
+/**
+ * @brief  Configures the clock tree from RCC_config.h: oscillator, PLL, flash wait states,
+ *         AHB/APB/ADC prescalers, then switches the system clock.
+ * @note   To be called first, every clock constant (FCPU, TIM_CLK) assumes the configured tree.
+ * @param  None
+ * @retval Configuration status from @ref RCC_Status_t
+ */
+RCC_Status_t RCC_Init(void);
+
+#endif /* RCC_RCC_INTERFACE_H_ */
@@ -25,7 +25,106 @@ typedef struct
 
 } RCC_TypeDef;
 
+typedef struct
+{
+	volatile u32 ACR;
+	volatile u32 KEYR;
+	volatile u32 OPTKEYR;
+	volatile u32 SR;
+	volatile u32 CR;
+	volatile u32 AR;
+	u32 RESERVED;
+	volatile u32 OBR;
+	volatile u32 WRPR;
+
+} FLASH_TypeDef;
+
 #define RCC ((volatile RCC_TypeDef*)0x40021000UL)
+#define FLASH ((volatile FLASH_TypeDef*)0x40022000UL)
+
+/* RCC_CR */
+#define RCC_CR_HSION  (0UL)
+#define RCC_CR_HSIRDY (1UL)
+#define RCC_CR_HSEON  (16UL)
+#define RCC_CR_HSERDY (17UL)
+#define RCC_CR_PLLON  (24UL)
+#define RCC_CR_PLLRDY (25UL)
+
+/* RCC_CFGR */
+#define RCC_CFGR_SW       (0UL)
+#define RCC_CFGR_SWS      (2UL)
+#define RCC_CFGR_HPRE     (4UL)
+#define RCC_CFGR_PPRE1    (8UL)
+#define RCC_CFGR_PPRE2    (11UL)
+#define RCC_CFGR_ADCPRE   (14UL)
+#define RCC_CFGR_PLLSRC   (16UL)
+#define RCC_CFGR_PLLXTPRE (17UL)
+#define RCC_CFGR_PLLMUL   (18UL)
+
+#define RCC_SW_MASK     (3UL)
+#define RCC_SW_HSI      (0UL)
+#define RCC_SW_HSE      (1UL)
+#define RCC_SW_PLL      (2UL)
+#define RCC_HPRE_MASK   (0xFUL)
+#define RCC_PPRE_MASK   (7UL)
+#define RCC_ADCPRE_MASK (3UL)
+#define RCC_PLLMUL_MASK (0xFUL)
+
+/* FLASH_ACR */
+#define FLASH_ACR_LATENCY (0UL)
+#define FLASH_ACR_PRFTBE  (4UL)
+#define FLASH_LATENCY_MASK (7UL)
+
+/**
+ * @defgroup RCC_CLK_SRC System clock sources
+ * @{
+ */
+#define RCC_SRC_HSI     (0U)   /*!< 8 MHz internal oscillator */
+#define RCC_SRC_HSE     (1U)   /*!< External crystal */
+#define RCC_SRC_PLL_HSI (2U)   /*!< PLL fed by HSI / 2 */
+#define RCC_SRC_PLL_HSE (3U)   /*!< PLL fed by the external crystal */
+/** @} */
+
+#define RCC_HSI_HZ (8000000UL)
+
+#include "RCC_config.h"
+
+/* Clock tree derived from RCC_config.h ------------------------------------------*/
+#if (RCC_CLK_SRC == RCC_SRC_HSI)
+#define RCC_SYSCLK_HZ (RCC_HSI_HZ)
+#elif (RCC_CLK_SRC == RCC_SRC_HSE)
+#define RCC_SYSCLK_HZ (RCC_HSE_HZ)
+#elif (RCC_CLK_SRC == RCC_SRC_PLL_HSI)
+#define RCC_SYSCLK_HZ ((RCC_HSI_HZ / 2UL) * RCC_PLL_MUL)
+#else
+#define RCC_SYSCLK_HZ (RCC_HSE_HZ * RCC_PLL_MUL)
+#endif
+
+#define RCC_HCLK_HZ  (RCC_SYSCLK_HZ / RCC_AHB_DIV)
+#define RCC_PCLK1_HZ (RCC_HCLK_HZ / RCC_APB1_DIV)
+#define RCC_PCLK2_HZ (RCC_HCLK_HZ / RCC_APB2_DIV)
+
+/* Timers run at twice their APB clock when the APB is divided */
+#define RCC_APB1_TIM_HZ ((RCC_APB1_DIV == 1UL) ? RCC_PCLK1_HZ : (RCC_PCLK1_HZ * 2UL))
+#define RCC_APB2_TIM_HZ ((RCC_APB2_DIV == 1UL) ? RCC_PCLK2_HZ : (RCC_PCLK2_HZ * 2UL))
+#define RCC_ADC_HZ      (RCC_PCLK2_HZ / RCC_ADC_DIV)
+
+#if (RCC_APB1_TIM_HZ != RCC_APB2_TIM_HZ)
+#error "TIM_CLK assumes the same clock for TIM1 (APB2) and TIM2/TIM3 (APB1)"
+#endif
+
+/* Flash wait states: 0 up to 24 MHz, 1 up to 48 MHz, 2 up to 72 MHz */
+#define RCC_FLASH_LATENCY ((RCC_HCLK_HZ <= 24000000UL) ? 0UL : ((RCC_HCLK_HZ <= 48000000UL) ? 1UL : 2UL))
+
+#if (RCC_SYSCLK_HZ > 72000000UL)
+#error "SYSCLK above 72 MHz"
+#endif
+#if (RCC_PCLK1_HZ > 36000000UL)
+#error "APB1 clock above 36 MHz, raise RCC_APB1_DIV"
+#endif
+#if (RCC_ADC_HZ > 14000000UL)
+#error "ADC clock above 14 MHz, raise RCC_ADC_DIV"
+#endif
 
 #define RCC_GPIOA_CLK_EN()	( RCC->APB2ENR |= (0x01UL<<2) )
 #define RCC_GPIOB_CLK_EN()	( RCC->APB2ENR |= (0x01UL<<3) )
@@ -37,5 +136,9 @@ typedef struct
 #define RCC_TIM2_CLK_EN()   (RCC->APB1ENR  |= (0x01UL<<0) )
 #define RCC_TIM3_CLK_EN()   (RCC->APB1ENR  |= (0x01UL<<1) )
 
+#define RCC_ADC1_CLK_EN()   (RCC->APB2ENR  |= (0x01UL<<9) )
+#define RCC_USART1_CLK_EN() (RCC->APB2ENR  |= (0x01UL<<14))
+#define RCC_DMA1_CLK_EN()   (RCC->AHBENR   |= (0x01UL<<0) )
+
 
 #endif /* RCC_RCC_PRIVATE_H_ */
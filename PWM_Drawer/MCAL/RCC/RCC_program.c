@@ -0,0 +1,177 @@
+/**
+ ******************************************************************************
+ * @file    RCC_program.c
+ * @author  Salma Faragalla
+ * @ brief  RCC module driver
+ ******************************************************************************
+ */
+/* Includes -------------------------------------------------------------------*/
+#include "BIT_MATH.h"
+
+#include "RCC_interface.h"
+
+/*Private Functions prototypes -------------------------------------------------*/
+/**
+ * @brief  Returns the AHB prescaler field value of a division factor.
+ * @param  div : Division factor (1, 2, 4, 8, 16, 64, 128, 256, or 512).
+ * @retval HPRE field value
+ */
+static u32 RCC_AHB_PrescalerBits(u32 div);
+
+/**
+ * @brief  Returns the APB prescaler field value of a division factor.
+ * @param  div : Division factor (1, 2, 4, 8, or 16).
+ * @retval PPRE field value
+ */
+static u32 RCC_APB_PrescalerBits(u32 div);
+
+/**
+ * @brief  Waits for a bit of a RCC register to be set, bounded by RCC_READY_TIMEOUT.
+ * @param  reg : Pointer to the register.
+ * @param  bit : Bit to be waited for.
+ * @retval 1 if the bit was set, 0 on timeout
+ */
+static u8 RCC_WaitReady(volatile u32 *reg, u32 bit);
+
+/* Private Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Returns the AHB prescaler field value of a division factor.
+ * @param  div : Division factor (1, 2, 4, 8, 16, 64, 128, 256, or 512).
+ * @retval HPRE field value
+ */
+static u32 RCC_AHB_PrescalerBits(u32 div)
+{
+	u32 shift = 0;
+
+	if (div <= 1)
+	{
+		return 0;
+	}
+
+	while ((div >> shift) > 1)
+	{
+		shift++;
+	}
+
+	// 0x8 divides by 2, division by 32 does not exist so 0xC divides by 64
+	return (shift < 6) ? (0x7UL + shift) : (0x6UL + shift);
+}
+
+/**
+ * @brief  Returns the APB prescaler field value of a division factor.
+ * @param  div : Division factor (1, 2, 4, 8, or 16).
+ * @retval PPRE field value
+ */
+static u32 RCC_APB_PrescalerBits(u32 div)
+{
+	u32 shift = 0;
+
+	if (div <= 1)
+	{
+		return 0;
+	}
+
+	while ((div >> shift) > 1)
+	{
+		shift++;
+	}
+
+	// 0x4 divides by 2, 0x7 by 16
+	return 0x3UL + shift;
+}
+
+/**
+ * @brief  Waits for a bit of a RCC register to be set, bounded by RCC_READY_TIMEOUT.
+ * @param  reg : Pointer to the register.
+ * @param  bit : Bit to be waited for.
+ * @retval 1 if the bit was set, 0 on timeout
+ */
+static u8 RCC_WaitReady(volatile u32 *reg, u32 bit)
+{
+	for (u32 timeout = RCC_READY_TIMEOUT; timeout; timeout--)
+	{
+		if (GET_BIT(*reg, bit))
+		{
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/* Public Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Configures the clock tree from RCC_config.h: oscillator, PLL, flash wait states,
+ *         AHB/APB/ADC prescalers, then switches the system clock.
+ * @note   To be called first, every clock constant (FCPU, TIM_CLK) assumes the configured tree.
+ * @param  None
+ * @retval Configuration status from @ref RCC_Status_t
+ */
+RCC_Status_t RCC_Init(void)
+{
+	u32 cfgr;
+	u32 sw;
+
+	// Run from HSI while the tree is reconfigured
+	SET_BIT(RCC->CR, RCC_CR_HSION);
+	RCC_WaitReady(&RCC->CR, RCC_CR_HSIRDY);
+	RCC->CFGR &= ~(RCC_SW_MASK << RCC_CFGR_SW);
+	CLR_BIT(RCC->CR, RCC_CR_PLLON);
+
+#if (RCC_CLK_SRC == RCC_SRC_HSE || RCC_CLK_SRC == RCC_SRC_PLL_HSE)
+	SET_BIT(RCC->CR, RCC_CR_HSEON);
+	if (!RCC_WaitReady(&RCC->CR, RCC_CR_HSERDY))
+	{
+		CLR_BIT(RCC->CR, RCC_CR_HSEON);
+		return RCC_ERR_HSE;
+	}
+#endif
+
+	// Wait states before the clock gets faster, with the prefetch buffer
+	FLASH->ACR = (FLASH->ACR & ~(FLASH_LATENCY_MASK << FLASH_ACR_LATENCY)) |
+			(RCC_FLASH_LATENCY << FLASH_ACR_LATENCY) | (0x01UL << FLASH_ACR_PRFTBE);
+
+	// Bus prescalers before the switch so that APB1 never exceeds its limit
+	cfgr = RCC->CFGR;
+	cfgr &= ~((RCC_HPRE_MASK << RCC_CFGR_HPRE) | (RCC_PPRE_MASK << RCC_CFGR_PPRE1) |
+			(RCC_PPRE_MASK << RCC_CFGR_PPRE2) | (RCC_ADCPRE_MASK << RCC_CFGR_ADCPRE));
+	cfgr |= RCC_AHB_PrescalerBits(RCC_AHB_DIV) << RCC_CFGR_HPRE;
+	cfgr |= RCC_APB_PrescalerBits(RCC_APB1_DIV) << RCC_CFGR_PPRE1;
+	cfgr |= RCC_APB_PrescalerBits(RCC_APB2_DIV) << RCC_CFGR_PPRE2;
+	cfgr |= ((RCC_ADC_DIV / 2UL) - 1UL) << RCC_CFGR_ADCPRE;
+
+#if (RCC_CLK_SRC == RCC_SRC_PLL_HSI || RCC_CLK_SRC == RCC_SRC_PLL_HSE)
+	cfgr &= ~((RCC_PLLMUL_MASK << RCC_CFGR_PLLMUL) | (0x01UL << RCC_CFGR_PLLSRC) | (0x01UL << RCC_CFGR_PLLXTPRE));
+	cfgr |= (RCC_PLL_MUL - 2UL) << RCC_CFGR_PLLMUL;
+#if (RCC_CLK_SRC == RCC_SRC_PLL_HSE)
+	cfgr |= 0x01UL << RCC_CFGR_PLLSRC;
+#endif
+	RCC->CFGR = cfgr;
+
+	SET_BIT(RCC->CR, RCC_CR_PLLON);
+	if (!RCC_WaitReady(&RCC->CR, RCC_CR_PLLRDY))
+	{
+		CLR_BIT(RCC->CR, RCC_CR_PLLON);
+		return RCC_ERR_PLL;
+	}
+	sw = RCC_SW_PLL;
+#elif (RCC_CLK_SRC == RCC_SRC_HSE)
+	RCC->CFGR = cfgr;
+	sw = RCC_SW_HSE;
+#else
+	RCC->CFGR = cfgr;
+	sw = RCC_SW_HSI;
+#endif
+
+	// Switch the system clock and wait for the switch status
+	RCC->CFGR = (RCC->CFGR & ~(RCC_SW_MASK << RCC_CFGR_SW)) | (sw << RCC_CFGR_SW);
+	for (u32 timeout = RCC_READY_TIMEOUT; timeout; timeout--)
+	{
+		if (((RCC->CFGR >> RCC_CFGR_SWS) & RCC_SW_MASK) == sw)
+		{
+			return RCC_OK;
+		}
+	}
+
+	return RCC_ERR_SWITCH;
+}
@@ -0,0 +1,30 @@
+/**
+ ******************************************************************************
+ * @file    STK_interface.h
+ * @author  Salma Faragalla
+ * @ brief  Header file of STK (SysTick timebase) module.
+ ******************************************************************************
+ */
+#ifndef STK_STK_INTERFACE_H_
+#define STK_STK_INTERFACE_H_
+
+#include "STM32F103.h"
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Starts the SysTick interrupt every millisecond, the tick counter restarts from zero.
+ * @note   The SysTick priority is set with NVIC_SetPriority(SysTick_IRQn, ...).
+ * @param  None
+ * @retval None
+ */
+void STK_Init(void);
+
+/**
+ * @brief  Returns the milliseconds elapsed since STK_Init, wrapping every 2^32 ms (about 49 days).
+ * @note   Compare times through their difference, (s32)(a - b) >= 0, so that the wrap is handled.
+ * @param  None
+ * @retval Tick counter in ms
+ */
+u32 STK_GetTicks(void);
+
+#endif /* STK_STK_INTERFACE_H_ */
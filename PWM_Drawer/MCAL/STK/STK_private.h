@@ -0,0 +1,32 @@
+/**
+ ******************************************************************************
+ * @file    STK_private.h
+ * @author  Salma Faragalla
+ ******************************************************************************
+ */
+
+#ifndef STK_STK_PRIVATE_H_
+#define STK_STK_PRIVATE_H_
+
+typedef struct
+{
+	volatile u32 CTRL;
+	volatile u32 LOAD;
+	volatile u32 VAL;
+	volatile u32 CALIB;
+
+}STK_TypeDef;
+
+#define STK ((volatile STK_TypeDef*)0xE000E010UL)
+
+#define STK_MAX_RELOAD (0xFFFFFFUL)
+
+/* STK Register Pins*/
+
+/* STK_CTRL */
+#define STK_CTRL_ENABLE    (0UL)
+#define STK_CTRL_TICKINT   (1UL)
+#define STK_CTRL_CLKSOURCE (2UL)   // Set: processor clock (HCLK), cleared: HCLK / 8
+#define STK_CTRL_COUNTFLAG (16UL)
+
+#endif /* STK_STK_PRIVATE_H_ */
@@ -0,0 +1,59 @@
+/**
+ ******************************************************************************
+ * @file    STK_program.c
+ * @author  Salma Faragalla
+ * @ brief  STK (SysTick timebase) module driver
+ ******************************************************************************
+ */
+/* Includes -------------------------------------------------------------------*/
+#include "BIT_MATH.h"
+
+#include "STK_interface.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define STK_TICK_HZ (1000UL)
+
+#if ((FCPU / STK_TICK_HZ) - 1UL > STK_MAX_RELOAD)
+#error "STK_TICK_HZ is too low for the 24-bit SysTick reload at FCPU"
+#endif
+
+/* Private Variables -------------------------------------------------------------------*/
+static volatile u32 STK_Ticks = 0;
+
+/* Public Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Starts the SysTick interrupt every millisecond, the tick counter restarts from zero.
+ * @note   The SysTick priority is set with NVIC_SetPriority(SysTick_IRQn, ...).
+ * @param  None
+ * @retval None
+ */
+void STK_Init(void)
+{
+	STK->CTRL = 0;
+	STK_Ticks = 0;
+
+	STK->LOAD = (FCPU / STK_TICK_HZ) - 1UL;
+	STK->VAL = 0;   // Any write clears the counter, the first period is a full one
+	STK->CTRL = (0x01UL << STK_CTRL_CLKSOURCE) | (0x01UL << STK_CTRL_TICKINT) | (0x01UL << STK_CTRL_ENABLE);
+}
+
+/**
+ * @brief  Returns the milliseconds elapsed since STK_Init, wrapping every 2^32 ms (about 49 days).
+ * @note   Compare times through their difference, (s32)(a - b) >= 0, so that the wrap is handled.
+ * @param  None
+ * @retval Tick counter in ms
+ */
+u32 STK_GetTicks(void)
+{
+	return STK_Ticks;
+}
+
+/**
+ * @brief  SysTick interrupt handler.
+ * @param  None
+ * @retval None
+ */
+void SysTick_Handler(void)
+{
+	STK_Ticks++;
+}
@@ -38,6 +38,75 @@ typedef enum {
 	TIM_INT_DISABLE = 0,
 	TIM_INT_ENABLE
 }TIM_INT_Status_t;
+/**
+ * @typedef TIM_IC_Prescaler_t
+ * @brief Enumeration of input capture prescalers (capture done once every N events).
+ */
+typedef enum {
+	TIM_IC_PSC_DIV1 = 0,
+	TIM_IC_PSC_DIV2,
+	TIM_IC_PSC_DIV4,
+	TIM_IC_PSC_DIV8
+}TIM_IC_Prescaler_t;
+
+/**
+ * @typedef TIM_Event_t
+ * @brief Enumeration of timer events, each one being its flag position in TIMx_SR and TIMx_DIER.
+ */
+typedef enum {
+	TIM_EVENT_UPDATE = 0,    /*!< Counter overflow or update generation */
+	TIM_EVENT_CC1,           /*!< Capture/compare on channel 1 */
+	TIM_EVENT_CC2,           /*!< Capture/compare on channel 2 */
+	TIM_EVENT_CC3,           /*!< Capture/compare on channel 3 */
+	TIM_EVENT_CC4,           /*!< Capture/compare on channel 4 */
+	TIM_EVENT_COM,           /*!< Commutation (TIM1) */
+	TIM_EVENT_TRIGGER,       /*!< Trigger input edge */
+	TIM_EVENT_COUNT
+}TIM_Event_t;
+
+/**
+ * @typedef TIM_EventCallback_t
+ * @brief Timer event callback, called from the timer interrupt with the context it was set with
+ *        and, for a capture/compare event, the value of the channel capture/compare register.
+ */
+typedef void (*TIM_EventCallback_t)(void *context, u32 value);
+
+/**
+ * @typedef TIM_PWM_Setting_t
+ * @brief Register values of a PWM signal and the frequency and duty cycle they achieve.
+ */
+typedef struct {
+	u16 prescaler;        /*!< PSC value, the counter clock is TIM_CLK / (prescaler + 1) */
+	u16 reload;           /*!< ARR value, the period is reload + 1 counter ticks */
+	u32 compare;          /*!< CCRx value, the output is high for compare ticks of each period */
+	u32 frequency_mHz;    /*!< Achieved frequency in mHz */
+	u32 duty;             /*!< Achieved duty cycle in 0.01% units (0 to TIM_DUTY_FULL) */
+}TIM_PWM_Setting_t;
+
+/**
+ * @typedef TIM_Break_t
+ * @brief Enumeration of break input (BKIN) configurations.
+ */
+typedef enum {
+	TIM_BREAK_DISABLE = 0,   /*!< Break input ignored */
+	TIM_BREAK_ACTIVE_LOW,    /*!< Outputs forced off while BKIN is low */
+	TIM_BREAK_ACTIVE_HIGH    /*!< Outputs forced off while BKIN is high */
+}TIM_Break_t;
+
+/**
+ * @typedef TIM_Complementary_t
+ * @brief Configuration of a complementary PWM output pair.
+ */
+typedef struct {
+	u32 frequency_mHz;       /*!< Frequency in mHz */
+	u32 duty;                /*!< Duty cycle of the reference signal in 0.01% units (0 to TIM_DUTY_FULL) */
+	u32 deadTime_ns;         /*!< Delay inserted before each output of the pair turns on */
+	TIM_Break_t breakInput;  /*!< Break input turning both outputs off */
+}TIM_Complementary_t;
+
+/* Exported constants --------------------------------------------------------*/
+#define TIM_EVENT_CCx(TIM_CHx) ((TIM_Event_t)(TIM_EVENT_CC1 + (TIM_CHx)))  // Capture/compare event of a channel
+#define TIM_DUTY_FULL (10000UL)   // Duty cycles of the fine PWM generator are in 0.01% units
 
 /**
  * @brief  Initializes the clock for the specified timer peripheral.
@@ -54,11 +123,142 @@ void TIM_Init(volatile TIM_TypeDef *TIMx);
  * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
  * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
  * @param  dutyCycle :  Desired dutly cycle (0-100)
- * @param  frequency : Desired frequency of the PWM signal in Hz (123 Hz - 80000 Hz)
+ * @param  frequency : Desired frequency of the PWM signal in Hz (TIM_CLK / 6553600 to TIM_CLK / 100)
  * @retval None
  */
 void TIM_PWM_Start(volatile TIM_TypeDef* TIMx ,TIM_CH_t TIM_CHx , u32 dutyCycle , u32 frequency);
 
+/**
+ * @brief  Starts periodic compare events on a timer channel without driving its pin,
+ *         to be used as the trigger of another peripheral (ADC conversions).
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  frequency : Desired rate of the compare events in Hz.
+ * @retval Achieved rate of the compare events in Hz
+ */
+u32 TIM_OC_Trigger_Start(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, u32 frequency);
+
+/**
+ * @brief  Stops the periodic compare events started by TIM_OC_Trigger_Start and the counter,
+ *         the channel is set back to frozen output compare mode and disabled.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @retval None
+ */
+void TIM_OC_Trigger_Stop(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx);
+
+/**
+ * @brief  Searches the prescaler and reload pair closest to a PWM frequency, the one with
+ *         the largest reload (finest duty steps) among equally close pairs.
+ * @note   Only computes the register values, may be called from an interrupt.
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  duty : Desired duty cycle in 0.01% units (0 to TIM_DUTY_FULL).
+ * @param  setting : Pointer to the register values and achieved frequency and duty to be filled.
+ * @retval 1 if found, 0 if the frequency is out of range (TIM_CLK / 2^32 to TIM_CLK / TIM_PWM_MIN_STEPS)
+ */
+u8 TIM_PWM_Compute(u32 frequency_mHz, u32 duty, TIM_PWM_Setting_t *setting);
+
+/**
+ * @brief  Starts a PWM signal with a fine frequency and duty cycle, the output being high
+ *         for the first part of each period.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  duty : Desired duty cycle in 0.01% units (0 to TIM_DUTY_FULL).
+ * @param  achieved : Pointer to the setting to be filled with the achieved values, may be 0.
+ * @retval 1 if started, 0 if the frequency is out of range
+ */
+u8 TIM_PWM_StartFine(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, u32 frequency_mHz, u32 duty, TIM_PWM_Setting_t *achieved);
+
+/**
+ * @brief  Changes the duty cycle of a running PWM signal at its next period.
+ * @note   The compare value goes through the preload register, may be called from an interrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel started by TIM_PWM_StartFine.
+ * @param  duty : Desired duty cycle in 0.01% units (0 to TIM_DUTY_FULL).
+ * @retval Achieved duty cycle in 0.01% units
+ */
+u32 TIM_PWM_SetDuty(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, u32 duty);
+
+/**
+ * @brief  Changes the frequency of a running PWM signal at its next period, keeping its duty cycle.
+ * @note   Runs the TIM_PWM_Compute search, fast sweeps should compute their settings
+ *         beforehand and load them with TIM_PWM_Apply.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel started by TIM_PWM_StartFine.
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  achieved : Pointer to the setting to be filled with the achieved values, may be 0.
+ * @retval 1 if changed, 0 if the frequency is out of range
+ */
+u8 TIM_PWM_SetFrequency(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, u32 frequency_mHz, TIM_PWM_Setting_t *achieved);
+
+/**
+ * @brief  Loads a computed setting into a running PWM signal, taking effect as a whole at its next period.
+ * @note   The prescaler, reload and compare values go through the preload registers with update
+ *         events held off while writing, may be called from an interrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel started by TIM_PWM_StartFine.
+ * @param  setting : Pointer to the setting filled by TIM_PWM_Compute.
+ * @retval None
+ */
+void TIM_PWM_Apply(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, const TIM_PWM_Setting_t *setting);
+
+/**
+ * @brief  Starts a complementary PWM output pair (CHx and CHxN) with dead time, for half-bridge signals.
+ * @note   TIM1 channels 1 to 3 only. CHx is high for the reference high time minus the dead time,
+ *         CHxN for the reference low time minus the dead time. Both outputs are low when stopped
+ *         or on a break, until TIM_Break_Resume.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, or TIM_CH3).
+ * @param  config : Pointer to the frequency, duty cycle, dead time and break configuration.
+ * @param  achieved : Pointer to the setting to be filled with the achieved values, may be 0.
+ * @param  deadTime_ns : Pointer to the achieved dead time in ns to be filled, may be 0.
+ * @retval 1 if started, 0 if the timer, channel, frequency or dead time is out of range
+ */
+u8 TIM_PWM_StartComplementary(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, const TIM_Complementary_t *config,
+		TIM_PWM_Setting_t *achieved, u32 *deadTime_ns);
+
+/**
+ * @brief  Stops a complementary PWM output pair, both outputs are driven low.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, or TIM_CH3).
+ * @retval None
+ */
+void TIM_PWM_StopComplementary(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx);
+
+/**
+ * @brief  Checks whether a break turned the outputs off since the last TIM_Break_Resume.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1).
+ * @retval 1 if the outputs are off, 0 otherwise
+ */
+u8 TIM_Break_IsActive(volatile TIM_TypeDef* TIMx);
+
+/**
+ * @brief  Enables the outputs again after a break, if the break input is no longer active.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1).
+ * @retval None
+ */
+void TIM_Break_Resume(volatile TIM_TypeDef* TIMx);
+
+/**
+ * @brief  Returns the address of the compare register of a timer channel, to be used as DMA destination.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @retval Address of the compare register
+ */
+static inline volatile u32* TIM_GetCompareAddress(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx)
+{
+	return TIM_Reg(TIMx, TIM_Channel_Descs[TIM_CHx].ccr);
+}
+
+/**
+ * @brief  Enables or disables the DMA request of the timer update event.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_DMA_Status : TIM_INT_ENABLE or TIM_INT_DISABLE.
+ * @retval None
+ */
+void TIM_DMA_SetUpdateRequest(volatile TIM_TypeDef* TIMx, TIM_INT_Status_t TIM_DMA_Status);
+
 /**
  * @brief  Starts Input Capture (IC) mode on the specified timer channel with the given configuration.
  * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
@@ -76,39 +276,152 @@ void TIM_IC_Start (volatile TIM_TypeDef* TIMx,TIM_CH_t TIM_CHx,u8 CCS_Direction
  * @retval None
  */
 void TIM_IC_INT_Enable (volatile TIM_TypeDef* TIMx);
+
 /**
- * @brief  Sets the callback function for the TIM1 update event interrupt
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Changes the capture edge of a channel already started in Input Capture mode.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  TIM_IC_Edge : Selection of edge for capture (TIM_IC_RISING_EDGE or TIM_IC_FALLING_EDGE)
  * @retval None
  */
+void TIM_IC_SetEdge(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, TIM_IC_Edge_t TIM_IC_Edge);
+
+/**
+ * @brief  Returns the last value captured on the specified timer channel.
+ * @note   Reading the capture register clears the channel capture flag.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @retval Captured counter value
+ */
+static inline u32 TIM_IC_GetCapture(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx)
+{
+	return *TIM_Reg(TIMx, TIM_Channel_Descs[TIM_CHx].ccr);
+}
+
+/**
+ * @brief  Checks the capture flag of the specified timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @retval 1 if a capture occurred since the last read of the capture register, 0 otherwise
+ */
+static inline u8 TIM_IC_IsCaptured(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx)
+{
+	return (TIMx->SR >> TIM_Channel_Descs[TIM_CHx].flag) & 0x01UL;
+}
 
-/* Callback functions --------------------------------------------------------*/
-void TIM1_UP_SetCallback(void ( *functionPtr ) ( void ));
 /**
- * @brief  Sets the callback function for the TIM1 trigger and communication interrupts.
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Returns the captures of a channel overwritten before their interrupt was served (CCxOF).
+ * @note   Counted by the interrupt handler, for channels with their capture event interrupt enabled.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @retval Overcaptures counted since reset, wrapping
+ */
+u32 TIM_IC_GetOvercaptures(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx);
+
+/**
+ * @brief  Sets the prescaler of the timer counter clock, the counter is restarted.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  prescaler : Counter clock is TIM_CLK / (prescaler + 1).
  * @retval None
  */
-void TIM1_TRG_COM_SetCallback(void ( *functionPtr ) ( void ));
+void TIM_SetPrescaler(volatile TIM_TypeDef* TIMx, u16 prescaler);
+
+/**
+ * @brief  Returns the current value of the timer counter.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @retval Counter value
+ */
+static inline u32 TIM_GetCounter(volatile TIM_TypeDef* TIMx)
+{
+	return TIMx->CNT;
+}
+
 /**
- * @brief  Sets the callback function for the capture/compare interrupt
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Sets the input capture prescaler of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  TIM_IC_Prescaler : Number of events per capture from @ref TIM_IC_Prescaler_t.
  * @retval None
  */
-void TIM1_CC_SetCallback(void ( *functionPtr ) ( void ));
+void TIM_IC_SetPrescaler(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, TIM_IC_Prescaler_t TIM_IC_Prescaler);
 
 /**
- * @brief  Sets the callback function for the TIM2 interrupt.
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Enables or disables the capture interrupt of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  TIM_INT_Status : Interrupt status (TIM_INT_ENABLE or TIM_INT_DISABLE).
  * @retval None
  */
-void TIM2_SetCallback(void ( *functionPtr ) ( void ));
+void TIM_IC_SetInterrupt(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx, TIM_INT_Status_t TIM_INT_Status);
 
 /**
- * @brief  Sets the callback function for the TIM3 interrupt.
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Clocks the timer counter with the rising edges of a channel input (external clock mode 1),
+ *         so that the counter counts the input edges.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel of the input (TIM_CH1 or TIM_CH2).
+ * @retval None
+ */
+void TIM_ExtClock_Start(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx);
+
+/**
+ * @brief  Clocks the timer counter again with the internal clock.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @retval None
+ */
+void TIM_ExtClock_Stop(volatile TIM_TypeDef* TIMx);
+
+/**
+ * @brief  Starts periodic update events every gate time, used to time a measurement gate.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  gateTime_us : Time between update events in us.
+ * @param  TIM_INT_Status : Update interrupt status (TIM_INT_ENABLE or TIM_INT_DISABLE).
  * @retval None
  */
-void TIM3_SetCallback(void ( *functionPtr ) ( void ));
+void TIM_Gate_Start(volatile TIM_TypeDef* TIMx, u32 gateTime_us, TIM_INT_Status_t TIM_INT_Status);
+
+/**
+ * @brief  Checks and clears the update event of a gate timer.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @retval 1 if a gate time elapsed since the last call, 0 otherwise
+ */
+u8 TIM_Gate_IsElapsed(volatile TIM_TypeDef* TIMx);
+
+/**
+ * @brief  Stops a gate timer and its update interrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @retval None
+ */
+void TIM_Gate_Stop(volatile TIM_TypeDef* TIMx);
+
+/* Callback functions --------------------------------------------------------*/
+/**
+ * @brief  Sets the callback of a timer event, called from the timer interrupt once the event flag is cleared.
+ * @note   Does not enable the event interrupt, see TIM_Event_SetInterrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  event : Timer event from @ref TIM_Event_t.
+ * @param  callback : Pointer to the callback function, 0 to only clear the event.
+ * @param  context : User pointer passed back to the callback.
+ * @retval None
+ */
+void TIM_SetEventCallback(volatile TIM_TypeDef* TIMx, TIM_Event_t event, TIM_EventCallback_t callback, void *context);
+
+/**
+ * @brief  Enables or disables the interrupt of a timer event and its interrupt line.
+ * @note   The capture interrupts are usually set by TIM_IC_Start or TIM_IC_SetInterrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  event : Timer event from @ref TIM_Event_t.
+ * @param  TIM_INT_Status : Interrupt status (TIM_INT_ENABLE or TIM_INT_DISABLE).
+ * @retval None
+ */
+void TIM_Event_SetInterrupt(volatile TIM_TypeDef* TIMx, TIM_Event_t event, TIM_INT_Status_t TIM_INT_Status);
+
+/**
+ * @brief  Returns the interrupt line serving a timer event, to set its priority.
+ * @note   TIM2 and TIM3 serve all their events on a single line.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  event : Timer event from @ref TIM_Event_t.
+ * @retval Interrupt number
+ */
+IRQn_Type TIM_GetIRQn(volatile TIM_TypeDef* TIMx, TIM_Event_t event);
 
 #endif /* TIM_TIM_INTERFACE_H_ */
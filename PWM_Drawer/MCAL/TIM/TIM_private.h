@@ -8,9 +8,20 @@
 #ifndef TIM_TIM_PRIVATE_H_
 #define TIM_TIM_PRIVATE_H_
 
-#define TIM_CLK (8000000UL)
+/* TIM1 is clocked from APB2, TIM2 and TIM3 from APB1 */
+#define TIM_CLK (RCC_APB1_TIM_HZ)   // Same clock for all timers, checked in RCC_private.h
 #define TIM_MAX_PERIOD (0xFFFF)
 
+/* Dead-time generator (TIM1, tDTS = tCK_INT): DTG[7:5] selects the step and offset */
+#define TIM_DTG_LINEAR_MAX  (127UL)   // 0xx: DT = DTG x tDTS
+#define TIM_DTG_X2_MAX      (254UL)   // 10x: DT = (64 + DTG[5:0]) x 2 tDTS
+#define TIM_DTG_X8_MAX      (504UL)   // 110: DT = (32 + DTG[4:0]) x 8 tDTS
+#define TIM_DTG_X16_MAX     (1008UL)  // 111: DT = (32 + DTG[4:0]) x 16 tDTS
+
+/* PWM generator */
+#define TIM_PWM_MIN_STEPS   (100UL)   // Smallest period in counter ticks, 1% duty steps
+#define TIM_PWM_SEARCH_SPAN (256UL)   // Prescalers tried above the smallest one fitting the period
+
 
 typedef struct
 {
@@ -46,6 +57,8 @@ typedef struct
 
 /* TIMx_CR1 */
 #define CR1_CEN (0UL)
+#define CR1_UDIS (1UL)
+#define CR1_OPM (3UL)
 #define CR1_ARPE (7UL)
 
 /* TIMx_EGR */
@@ -117,7 +130,17 @@ typedef struct
 #define CCER_CC4NP (15UL)
 
 /* TIMx_BDTR */
+#define BDTR_DTG (0UL)
+#define BDTR_OSSI (10UL)
+#define BDTR_OSSR (11UL)
+#define BDTR_BKE (12UL)
+#define BDTR_BKP (13UL)
 #define BDTR_MOE (15UL)
+#define BDTR_DTG_MASK (0xFFUL)
+
+/* TIMx_CR2 output idle states (TIM1) */
+#define CR2_OIS1 (8UL)
+#define CR2_OIS1N (9UL)
 
 /* @defgroup CCS_DIRECTION */
 #define CCS_OP (0UL)
@@ -128,12 +151,22 @@ typedef struct
 /* TIMx_CCMRx Input Mode*/
 #define CCMR1_IC1F (4UL)
 #define CCMR1_IC2F (12UL)
+#define CCMR1_IC1PSC (2UL)
+#define CCMR1_IC2PSC (10UL)
+#define CCMR2_IC3PSC (2UL)
+#define CCMR2_IC4PSC (10UL)
+#define ICPSC_MASK (3UL)
+#define CCS_MASK (3UL)     // CCxS of TIMx_CCMRx, 0 for an output compare channel
 
 /* TIMx_DIER */
+#define DIER_UIE (0UL)
 #define DIER_CC1IE (1UL)
 #define DIER_CC2IE (2UL)
 #define DIER_CC3IE (3UL)
 #define DIER_CC4IE (4UL)
+#define DIER_COMIE (5UL)
+#define DIER_TIE (6UL)
+#define DIER_UDE (8UL)
 
 /* TIMx_SMCR */
 
@@ -164,11 +197,59 @@ typedef struct
 #define SMS_GATED    (5UL)
 #define SMS_TRIGGER (6UL)
 #define SMS_EXT1     (7UL)
+#define SMCR_SMS_MASK (7UL)
+#define SMCR_TS_MASK  (7UL)
 
 
 /* TIMx_SR*/
+#define SR_UIF (0UL)
 #define SR_CC1IF (1UL)
 #define SR_CC2IF (2UL)
 #define SR_CC3IF (3UL)
 #define SR_CC4IF (4UL)
+#define SR_COMIF (5UL)
+#define SR_TIF (6UL)
+#define SR_BIF (7UL)
+#define SR_CC1OF (9UL)
+#define SR_CC2OF (10UL)
+#define SR_CC3OF (11UL)
+#define SR_CC4OF (12UL)
+#define SR_CCOF_OFFSET (8UL)  // CCxOF sits 8 bits above CCxIF
+
+/* Channel descriptors -------------------------------------------------------*/
+#define TIM_CHANNEL_COUNT (4U)
+
+/* Register offsets in words from the timer base address */
+#define TIM_OFFSET_CCMR1 (6U)
+#define TIM_OFFSET_CCMR2 (7U)
+#define TIM_OFFSET_CCR1  (13U)
+
+typedef struct
+{
+	u8 ccr;          /*!< Offset of the CCRx register */
+	u8 ccmr;         /*!< Offset of the CCMRx register holding the channel */
+	u8 ccmrShift;    /*!< Position of the channel byte in its CCMRx register */
+	u8 ccerShift;    /*!< Position of CCxE in CCER, followed by CCxP, CCxNE and CCxNP */
+	u8 flag;         /*!< Position of CCxIF in SR and of CCxIE in DIER */
+}TIM_Channel_Desc_t;
+
+/* Indexed by TIM_CH_t, a constant channel folds every field into an immediate */
+static const TIM_Channel_Desc_t TIM_Channel_Descs[TIM_CHANNEL_COUNT] =
+{
+	{ TIM_OFFSET_CCR1,       TIM_OFFSET_CCMR1, 0U, CCER_CC1E, SR_CC1IF },
+	{ TIM_OFFSET_CCR1 + 1U,  TIM_OFFSET_CCMR1, 8U, CCER_CC2E, SR_CC2IF },
+	{ TIM_OFFSET_CCR1 + 2U,  TIM_OFFSET_CCMR2, 0U, CCER_CC3E, SR_CC3IF },
+	{ TIM_OFFSET_CCR1 + 3U,  TIM_OFFSET_CCMR2, 8U, CCER_CC4E, SR_CC4IF },
+};
+
+/**
+ * @brief  Returns a register of a timer from its offset in a channel descriptor.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  offset : Offset of the register in words.
+ * @retval Pointer to the register
+ */
+static inline volatile u32* TIM_Reg(volatile TIM_TypeDef *TIMx, u8 offset)
+{
+	return (volatile u32 *)TIMx + offset;
+}
 #endif /* TIM_TIM_PRIVATE_H_ */
@@ -10,19 +10,59 @@
 
 #include "../GPIO/GPIO_interface.h"
 #include "../NVIC/NVIC_interface.h"
+#include "../DWT/DWT_interface.h"
 
 #include "TIM_interface.h"
 
 /* Defines -------------------------------------------------------------------*/
+#define TIM_COUNT (3U)
+
+/* Events served by each interrupt line, bit n for event n */
+#define TIM_EVENTS_CC     (0x1EUL)
+#define TIM_EVENTS_TRGCOM ((0x01UL << TIM_EVENT_COM) | (0x01UL << TIM_EVENT_TRIGGER))
+#define TIM_EVENTS_ALL    ((0x01UL << TIM_EVENT_COUNT) - 1UL)
+
+/* Private types -------------------------------------------------------------------*/
+/**
+ * @brief Pins and interrupt lines of a timer.
+ */
+typedef struct
+{
+	volatile TIM_TypeDef *TIMx;
+	volatile GPIO_TypeDef *ports[TIM_CHANNEL_COUNT];  /*!< Ports of the CH1 to CH4 pins */
+	GPIO_PinNum_t pins[TIM_CHANNEL_COUNT];           /*!< CH1 to CH4 pins */
+	IRQn_Type ccIRQn;                                 /*!< Capture/compare interrupt */
+	IRQn_Type upIRQn;                                 /*!< Update interrupt */
+	IRQn_Type trgIRQn;                                /*!< Trigger and commutation interrupt */
+}TIM_Desc_t;
+
+/**
+ * @brief Callback of a timer event.
+ */
+typedef struct
+{
+	TIM_EventCallback_t callback;
+	void *context;
+}TIM_Handler_t;
 
 /* Private Variables -------------------------------------------------------------------*/
-static void (*TIM1_UP_Callback_Ptr)(void);
-static void (*TIM1_TRG_COM_Callback_Ptr)(void);
-static void (*TIM1_CC_Callback_Ptr)(void);
-static void (*TIM2_Callback_Ptr)(void);
-static void (*TIM3_Callback_Ptr)(void);
+static const TIM_Desc_t TIM_Descs[TIM_COUNT] =
+{
+	{ TIM1, { GPIOA, GPIOA, GPIOA, GPIOA }, { GPIO_PIN8, GPIO_PIN9, GPIO_PIN10, GPIO_PIN11 }, TIM1_CC_IRQn, TIM1_UP_IRQn, TIM1_TRG_COM_IRQn },
+	{ TIM2, { GPIOA, GPIOA, GPIOA, GPIOA }, { GPIO_PIN0, GPIO_PIN1, GPIO_PIN2,  GPIO_PIN3  }, TIM2_IRQn,    TIM2_IRQn,    TIM2_IRQn },
+	{ TIM3, { GPIOA, GPIOA, GPIOB, GPIOB }, { GPIO_PIN6, GPIO_PIN7, GPIO_PIN0,  GPIO_PIN1  }, TIM3_IRQn,    TIM3_IRQn,    TIM3_IRQn },
+};
+
+static TIM_Handler_t TIM_Handlers[TIM_COUNT][TIM_EVENT_COUNT];  // Indexed as TIM_Descs, then by event
+static volatile u32 TIM_Overcaptures[TIM_COUNT][TIM_CHANNEL_COUNT];  // Indexed as TIM_Descs, then by channel
 
 /*Private Functions prototypes -------------------------------------------------*/
+/**
+ * @brief  Finds the pins and interrupt lines of a timer.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @retval Pointer to the timer descriptor, 0 for an unknown timer
+ */
+static const TIM_Desc_t* TIM_GetDesc(volatile TIM_TypeDef *TIMx);
 /**
  * @brief  Initializes the pin configuration for a specific timer channel.
  * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
@@ -31,6 +71,44 @@ static void (*TIM3_Callback_Ptr)(void);
  * @retval None
  */
 static void TIM_Pin_Init(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx,GPIO_Mode_t GPIO_Mode);
+/**
+ * @brief  Writes the compare register of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  compare : Compare value
+ * @retval None
+ */
+static void TIM_OC_SetCompare(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 compare);
+/**
+ * @brief  Reads the compare register of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @retval Compare value
+ */
+static u32 TIM_OC_GetCompare(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx);
+/**
+ * @brief  Replaces the CCMRx byte of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  mode : Channel byte, bit positions of channel 1 (CCMR1_OC1M, CCMR1_OC1PE, ...)
+ * @retval None
+ */
+static void TIM_CH_SetMode(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 mode);
+/**
+ * @brief  Encodes a dead time into the BDTR.DTG field, rounded up to the next step.
+ * @param  deadTime_ns : Dead time in ns.
+ * @param  achieved_ns : Pointer to the achieved dead time in ns to be filled.
+ * @retval DTG code, or a value above BDTR_DTG_MASK if the dead time is out of range
+ */
+static u32 TIM_DeadTime_Encode(u32 deadTime_ns, u32 *achieved_ns);
+/**
+ * @brief  Clears the pending events of a timer interrupt line and calls their callbacks,
+ *         counting the captures overwritten before they were served.
+ * @param  index : Index of the timer in TIM_Descs.
+ * @param  events : Events served by the interrupt line, bit n for event n.
+ * @retval None
+ */
+static void TIM_IRQ_Dispatch(u8 index, u32 events);
 
 /* Private Functions -------------------------------------------------------------------*/
 /**
@@ -42,64 +120,184 @@ static void TIM_Pin_Init(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx,GPIO_Mode_
  */
 static void TIM_Pin_Init(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx,GPIO_Mode_t GPIO_Mode)
 {
-	if (TIMx == TIM1)
+	const TIM_Desc_t *desc = TIM_GetDesc(TIMx);
+
+	if (desc != 0)
 	{
-		switch(TIM_CHx)
+		GPIO_SetPinDirSpeed(desc->ports[TIM_CHx], desc->pins[TIM_CHx], GPIO_Mode);
+	}
+}
+
+/**
+ * @brief  Finds the pins and interrupt lines of a timer.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @retval Pointer to the timer descriptor, 0 for an unknown timer
+ */
+static const TIM_Desc_t* TIM_GetDesc(volatile TIM_TypeDef *TIMx)
+{
+	for (u8 i = 0; i < TIM_COUNT; i++)
+	{
+		if (TIM_Descs[i].TIMx == TIMx)
 		{
-		case TIM_CH1:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN8, GPIO_Mode);
-			break;
-		case TIM_CH2:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN9, GPIO_Mode);
-			break;
-		case TIM_CH3:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN10, GPIO_Mode);
-			break;
-		case TIM_CH4:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN11, GPIO_Mode);
-			break;
+			return &TIM_Descs[i];
 		}
 	}
-	else if (TIMx == TIM2)
+
+	return 0;
+}
+
+/**
+ * @brief  Writes the compare register of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  compare : Compare value
+ * @retval None
+ */
+static void TIM_OC_SetCompare(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 compare)
+{
+	*TIM_Reg(TIMx, TIM_Channel_Descs[TIM_CHx].ccr) = compare;
+}
+
+/**
+ * @brief  Reads the compare register of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @retval Compare value
+ */
+static u32 TIM_OC_GetCompare(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx)
+{
+	return *TIM_Reg(TIMx, TIM_Channel_Descs[TIM_CHx].ccr);
+}
+
+/**
+ * @brief  Replaces the CCMRx byte of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  mode : Channel byte, bit positions of channel 1 (CCMR1_OC1M, CCMR1_OC1PE, ...)
+ * @retval None
+ */
+static void TIM_CH_SetMode(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 mode)
+{
+	const TIM_Channel_Desc_t *desc = &TIM_Channel_Descs[TIM_CHx];
+	volatile u32 *ccmr = TIM_Reg(TIMx, desc->ccmr);
+
+	*ccmr = (*ccmr & ~(0xFFUL << desc->ccmrShift)) | (mode << desc->ccmrShift);
+}
+
+/**
+ * @brief  Encodes a dead time into the BDTR.DTG field, rounded up to the next step.
+ * @param  deadTime_ns : Dead time in ns.
+ * @param  achieved_ns : Pointer to the achieved dead time in ns to be filled.
+ * @retval DTG code, or a value above BDTR_DTG_MASK if the dead time is out of range
+ */
+static u32 TIM_DeadTime_Encode(u32 deadTime_ns, u32 *achieved_ns)
+{
+	u32 ticks = (u32)(((u64)deadTime_ns * TIM_CLK + 999999999ULL) / 1000000000ULL);
+	u32 dtg;
+
+	if (ticks <= TIM_DTG_LINEAR_MAX)
+	{
+		dtg = ticks;
+	}
+	else if (ticks <= TIM_DTG_X2_MAX)
+	{
+		ticks = (ticks + 1UL) & ~1UL;
+		dtg = 0x80UL | (ticks / 2UL - 64UL);
+	}
+	else if (ticks <= TIM_DTG_X8_MAX)
+	{
+		ticks = (ticks + 7UL) & ~7UL;
+		dtg = 0xC0UL | (ticks / 8UL - 32UL);
+	}
+	else if (ticks <= TIM_DTG_X16_MAX)
+	{
+		ticks = (ticks + 15UL) & ~15UL;
+		dtg = 0xE0UL | (ticks / 16UL - 32UL);
+	}
+	else
 	{
-		switch(TIM_CHx)
+		return BDTR_DTG_MASK + 1UL;
+	}
+
+	*achieved_ns = (u32)(((u64)ticks * 1000000000ULL + TIM_CLK / 2UL) / TIM_CLK);
+
+	return dtg;
+}
+
+/**
+ * @brief  Clears the pending events of a timer interrupt line and calls their callbacks,
+ *         counting the captures overwritten before they were served.
+ * @param  index : Index of the timer in TIM_Descs.
+ * @param  events : Events served by the interrupt line, bit n for event n.
+ * @retval None
+ */
+static void TIM_IRQ_Dispatch(u8 index, u32 events)
+{
+	volatile TIM_TypeDef *TIMx = TIM_Descs[index].TIMx;
+	const TIM_Handler_t *handlers = TIM_Handlers[index];
+	const TIM_Channel_Desc_t *desc;
+	u32 values[TIM_CHANNEL_COUNT];
+	u32 status, pending, overcaptured, cleared;
+	u32 value;
+
+	DWT_ISR_Enter();
+
+	// SR is read once, events with their interrupt disabled are left to the polling functions
+	status = TIMx->SR;
+	pending = status & TIMx->DIER & events;
+
+	// A capture while CCxIF was still set has overwritten the previous one
+	overcaptured = (status >> SR_CCOF_OFFSET) & pending & TIM_EVENTS_CC;
+	cleared = pending | (overcaptured << SR_CCOF_OFFSET);
+
+	// Every capture is read before any callback runs, a later read could return the next
+	// capture and lose this one. The read clears CCxIF of an input channel, a capture
+	// arriving from now on stays pending for the next interrupt.
+	for (u8 ch = 0; ch < TIM_CHANNEL_COUNT; ch++)
+	{
+		desc = &TIM_Channel_Descs[ch];
+		if (!((pending >> (TIM_EVENT_CC1 + ch)) & 0x01UL))
 		{
-		case TIM_CH1:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN0, GPIO_Mode);
-			break;
-		case TIM_CH2:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN1, GPIO_Mode);
-			break;
-		case TIM_CH3:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN2, GPIO_Mode);
-			break;
-		case TIM_CH4:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN3, GPIO_Mode);
-			break;
+			continue;
+		}
+
+		values[ch] = *TIM_Reg(TIMx, desc->ccr);
+		if ((*TIM_Reg(TIMx, desc->ccmr) >> (desc->ccmrShift + CCMR1_CC1S)) & CCS_MASK)
+		{
+			cleared &= ~(0x01UL << (TIM_EVENT_CC1 + ch));
 		}
 	}
-	else if (TIMx == TIM3)
+
+	// Compare matches, the other events and the overcapture flags are cleared by software (rc_w0)
+	TIMx->SR = ~cleared;
+
+	for (u8 event = 0; pending != 0; event++, pending >>= 1, overcaptured >>= 1)
 	{
-		switch(TIM_CHx)
+		if (!(pending & 0x01UL))
 		{
-		case TIM_CH1:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN6, GPIO_Mode);
-			break;
-		case TIM_CH2:
-			GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN7, GPIO_Mode);
-			break;
-		case TIM_CH3:
-			GPIO_SetPinDirSpeed(GPIOB, GPIO_PIN0, GPIO_Mode);
-			break;
-		case TIM_CH4:
-			GPIO_SetPinDirSpeed(GPIOB, GPIO_PIN1, GPIO_Mode);
-			break;
+			continue;
+		}
+
+		value = 0;
+		if ((TIM_EVENTS_CC >> event) & 0x01UL)
+		{
+			value = values[event - TIM_EVENT_CC1];
+
+			if (overcaptured & 0x01UL)
+			{
+				TIM_Overcaptures[index][event - TIM_EVENT_CC1]++;
+			}
+		}
+
+		if (handlers[event].callback != 0)
+		{
+			handlers[event].callback(handlers[event].context, value);
 		}
 	}
 
+	DWT_ISR_Exit();
 }
 
-
 /* Public Functions -------------------------------------------------------------------*/
 /**
  * @brief  Initializes the clock for the specified timer peripheral.
@@ -113,6 +311,7 @@ void TIM_Init(volatile TIM_TypeDef *TIMx)
 	{
 		RCC_TIM1_CLK_EN();
 		RCC_GPIOA_CLK_EN();
+		RCC_GPIOB_CLK_EN();  // Complementary outputs and break input
 	}
 
 	else if (TIMx == TIM2)
@@ -134,7 +333,7 @@ void TIM_Init(volatile TIM_TypeDef *TIMx)
  * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
  * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
  * @param  dutyCycle :  Desired dutly cycle (0-100)
- * @param  frequency : Desired frequency of the PWM signal in Hz (123 Hz - 80000 Hz)
+ * @param  frequency : Desired frequency of the PWM signal in Hz (TIM_CLK / 6553600 to TIM_CLK / 100)
  * @retval None
  */
 void TIM_PWM_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 dutyCycle, u32 frequency)
@@ -143,36 +342,9 @@ void TIM_PWM_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 dutyCycle,
 	TIM_Pin_Init(TIMx, TIM_CHx, GPIO_OUTPUT_AF_PP_2MHZ);
 
 	/* Individual channel initialization*/
-	switch (TIM_CHx)
-	{
-	case TIM_CH1:
-		TIMx->CCR1 = dutyCycle;
-		TIMx->CCMR1 |= OCM_PWM2 << CCMR1_OC1M; // Select PWM Mode
-		SET_BIT(TIMx->CCMR1, CCMR1_OC1PE);	   // Enable the corresponding preload register
-		SET_BIT(TIMx->CCER, CCER_CC1E);        // Enable capture/compare channel
-		break;
-
-	case TIM_CH2:
-		TIMx->CCR2 = dutyCycle;
-		TIMx->CCMR1 |= OCM_PWM2 << CCMR1_OC2M; // Select PWM Mode
-		SET_BIT(TIMx->CCMR1, CCMR1_OC2PE);	   // Enable the corresponding preload register
-		SET_BIT(TIMx->CCER, CCER_CC2E);		   // Enable capture/compare channel
-		break;
-
-	case TIM_CH3:
-		TIMx->CCR3 = dutyCycle;
-		TIMx->CCMR2 |= OCM_PWM2 << CCMR2_OC3M; // Select PWM Mode
-		SET_BIT(TIMx->CCMR2, CCMR2_OC3PE);	   // Enable the corresponding preload register
-		SET_BIT(TIMx->CCER, CCER_CC3E);        // Enable capture from the counter into the capture register
-		break;
-
-	case TIM_CH4:
-		TIMx->CCR4 = dutyCycle;
-		TIMx->CCMR2 |= OCM_PWM2 << CCMR2_OC4M; // Select PWM Mode
-		SET_BIT(TIMx->CCMR2, CCMR2_OC4PE);	   // Enable the corresponding preload register
-		SET_BIT(TIMx->CCER, CCER_CC4E);        // Enable capture/compare channel
-		break;
-	}
+	TIM_OC_SetCompare(TIMx, TIM_CHx, dutyCycle);
+	TIM_CH_SetMode(TIMx, TIM_CHx, (OCM_PWM2 << CCMR1_OC1M) | (0x01UL << CCMR1_OC1PE));  // PWM mode with the compare preload
+	SET_BIT(TIMx->CCER, TIM_Channel_Descs[TIM_CHx].ccerShift);                          // Enable capture/compare channel
 
 	/* Common initialization for all timer channels */
 	TIMx->ARR = 100UL;  // Set ARR to 100 to allow direct mapping of the duty cycle value to the range of 0 to 100
@@ -189,125 +361,445 @@ void TIM_PWM_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 dutyCycle,
 }
 
 /**
- * @brief  Starts Input Capture (IC) mode on the specified timer channel with the given configuration.
+ * @brief  Starts periodic compare events on a timer channel without driving its pin,
+ *         to be used as the trigger of another peripheral (ADC conversions).
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  frequency : Desired rate of the compare events in Hz.
+ * @retval Achieved rate of the compare events in Hz
+ */
+u32 TIM_OC_Trigger_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 frequency)
+{
+	u32 ticks = TIM_CLK / frequency;
+	u32 prescaler = ticks / (TIM_MAX_PERIOD + 1UL);   // Smallest prescaler keeping the period in 16 bits
+	u32 period = ticks / (prescaler + 1UL);
+
+	CLR_BIT(TIMx->CR1, CR1_CEN);
+
+	TIMx->PSC = prescaler;
+	TIMx->ARR = period - 1UL;
+
+	/* Individual channel initialization, the pin is left in its GPIO configuration */
+	TIM_OC_SetCompare(TIMx, TIM_CHx, period / 2UL);
+	TIM_CH_SetMode(TIMx, TIM_CHx, OCM_PWM1 << CCMR1_OC1M);  // Select PWM Mode, one rising edge of OCxREF per period
+	SET_BIT(TIMx->CCER, TIM_Channel_Descs[TIM_CHx].ccerShift);
+
+	if (TIMx == TIM1)
+	{
+		SET_BIT(TIMx->BDTR, BDTR_MOE); //  Main output enable for TIM1 only
+	}
+
+	SET_BIT(TIMx->EGR, EGR_UG);   // Generate an update event
+	SET_BIT(TIMx->CR1, CR1_CEN);  // Enable the Timer/Counter
+
+	return TIM_CLK / ((prescaler + 1UL) * period);
+}
+
+/**
+ * @brief  Stops the periodic compare events started by TIM_OC_Trigger_Start and the counter,
+ *         the channel is set back to frozen output compare mode and disabled.
  * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
  * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
- * @param  CCS_Direction : Capture/Compare selection from @defgroup CCS_DIRECTION
- * @param  TIM_IC_Edge : Selection of edge for capture (TIM_IC_RISING_EDGE or TIM_IC_FALLING_EDGE)
- * @param  TIM_INT_Status: Enable/disable timer capture interrupt (TIM_INT_ENABLE or TIM_INT_DISABLE).
  * @retval None
  */
-void TIM_IC_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u8 CCS_Direction, TIM_IC_Edge_t TIM_IC_Edge , TIM_INT_Status_t TIM_INT_Status)
+void TIM_OC_Trigger_Stop(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx)
 {
-	/* Pin initialization for timer channel */
-	TIM_Pin_Init(TIMx, TIM_CHx, GPIO_INPUT_FLOATING);
+	CLR_BIT(TIMx->CR1, CR1_CEN);
+	CLR_BIT(TIMx->CCER, TIM_Channel_Descs[TIM_CHx].ccerShift);
+	TIM_CH_SetMode(TIMx, TIM_CHx, 0);
 
-	/* Individual channel initialization*/
-	switch (TIM_CHx)
+	if (TIMx == TIM1)
 	{
-	case TIM_CH1:
-		TIMx->CCMR1 |= (CCS_Direction << CCMR1_CC1S); // Select the active input
+		CLR_BIT(TIMx->BDTR, BDTR_MOE);
+	}
+}
 
-		// Select the active polarity
-		if (TIM_IC_Edge == TIM_IC_RISING_EDGE)
-		{
-			CLR_BIT(TIMx->CCER, CCER_CC1P);
-		}
-		else if (TIM_IC_Edge == TIM_IC_FALLING_EDGE)
-		{
-			SET_BIT(TIMx->CCER, CCER_CC1P);
-		}
+/**
+ * @brief  Searches the prescaler and reload pair closest to a PWM frequency, the one with
+ *         the largest reload (finest duty steps) among equally close pairs.
+ * @note   Only computes the register values, may be called from an interrupt.
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  duty : Desired duty cycle in 0.01% units (0 to TIM_DUTY_FULL).
+ * @param  setting : Pointer to the register values and achieved frequency and duty to be filled.
+ * @retval 1 if found, 0 if the frequency is out of range (TIM_CLK / 2^32 to TIM_CLK / TIM_PWM_MIN_STEPS)
+ */
+u8 TIM_PWM_Compute(u32 frequency_mHz, u32 duty, TIM_PWM_Setting_t *setting)
+{
+	u64 target, ticks, error;
+	u64 bestError = ~0ULL;
+	u32 prescaler, firstPrescaler, period;
+	u32 bestPrescaler = 0, bestPeriod = 0;
 
-		// Enable or disable Interrupt
-		if (TIM_INT_Status == TIM_INT_ENABLE)
-		{
-			SET_BIT(TIMx->DIER, DIER_CC1IE);
-		}
-		else if (TIM_INT_Status == TIM_INT_DISABLE)
-		{
-			CLR_BIT(TIMx->DIER, DIER_CC1IE);
-		}
-		SET_BIT(TIMx->CCER, CCER_CC1E);  // Enable capture/compare channel
-		break;
+	if (frequency_mHz == 0)
+	{
+		return 0;
+	}
 
-	case TIM_CH2:
-		TIMx->CCMR1 |= (CCS_Direction << CCMR1_CC2S); // Select the active input
+	// Period in thousandths of a timer tick, so that the mHz are not rounded away
+	target = ((u64)TIM_CLK * 1000000ULL) / frequency_mHz;
+	if (target < TIM_PWM_MIN_STEPS * 1000ULL)
+	{
+		return 0;
+	}
 
-		// Select the active polarity
-		if (TIM_IC_Edge == TIM_IC_RISING_EDGE)
+	// Smallest prescaler keeping the period in 16 bits gives the largest reload
+	firstPrescaler = (u32)((target + (TIM_MAX_PERIOD + 1ULL) * 1000ULL - 1ULL) / ((TIM_MAX_PERIOD + 1ULL) * 1000ULL));
+	if (firstPrescaler > TIM_MAX_PERIOD + 1UL)
+	{
+		return 0;
+	}
+
+	// Larger prescalers trade reload for a closer frequency
+	for (prescaler = firstPrescaler; prescaler < firstPrescaler + TIM_PWM_SEARCH_SPAN && prescaler <= TIM_MAX_PERIOD + 1UL; prescaler++)
+	{
+		period = (u32)((target + prescaler * 500ULL) / (prescaler * 1000ULL));
+		if (period > TIM_MAX_PERIOD + 1UL)
 		{
-			CLR_BIT(TIMx->CCER, CCER_CC2P);
+			period = TIM_MAX_PERIOD + 1UL;
 		}
-		else if (TIM_IC_Edge == TIM_IC_FALLING_EDGE)
+		if (period < TIM_PWM_MIN_STEPS)
 		{
-			SET_BIT(TIMx->CCER, CCER_CC2P);
+			break;
 		}
 
-		// Enable or disable Interrupt
-		if (TIM_INT_Status == TIM_INT_ENABLE)
-		{
-			SET_BIT(TIMx->DIER, DIER_CC2IE);
-		}
-		else if (TIM_INT_Status == TIM_INT_DISABLE)
+		ticks = (u64)prescaler * period * 1000ULL;
+		error = (ticks > target) ? (ticks - target) : (target - ticks);
+		if (error < bestError)
 		{
-			CLR_BIT(TIMx->DIER, DIER_CC2IE);
+			bestError = error;
+			bestPrescaler = prescaler;
+			bestPeriod = period;
+
+			if (error == 0)
+			{
+				break;
+			}
 		}
+	}
 
-		SET_BIT(TIMx->CCER, CCER_CC2E);  // Enable capture/compare channel
-		break;
+	if (duty > TIM_DUTY_FULL)
+	{
+		duty = TIM_DUTY_FULL;
+	}
 
-	case TIM_CH3:
-		TIMx->CCMR2 |= CCS_Direction << CCMR2_CC3S; // Select the active input
+	setting->prescaler = bestPrescaler - 1UL;
+	setting->reload = bestPeriod - 1UL;
+	setting->compare = (duty * bestPeriod + TIM_DUTY_FULL / 2UL) / TIM_DUTY_FULL;
+	setting->frequency_mHz = (u32)((((u64)TIM_CLK * 1000ULL) + ((u64)bestPrescaler * bestPeriod) / 2ULL) / ((u64)bestPrescaler * bestPeriod));
+	setting->duty = (setting->compare * TIM_DUTY_FULL + bestPeriod / 2UL) / bestPeriod;
 
-		// Select the active polarity
-		if (TIM_IC_Edge == TIM_IC_RISING_EDGE)
-		{
-			CLR_BIT(TIMx->CCER, CCER_CC3P);
-		}
-		else if (TIM_IC_Edge == TIM_IC_FALLING_EDGE)
-		{
-			SET_BIT(TIMx->CCER, CCER_CC3P);
-		}
+	return 1;
+}
 
-		// Enable or disable Interrupt
-		if (TIM_INT_Status == TIM_INT_ENABLE)
-		{
-			SET_BIT(TIMx->DIER, DIER_CC3IE);
-		}
-		else if (TIM_INT_Status == TIM_INT_DISABLE)
-		{
-			CLR_BIT(TIMx->DIER, DIER_CC3IE);
-		}
+/**
+ * @brief  Starts a PWM signal with a fine frequency and duty cycle, the output being high
+ *         for the first part of each period.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  duty : Desired duty cycle in 0.01% units (0 to TIM_DUTY_FULL).
+ * @param  achieved : Pointer to the setting to be filled with the achieved values, may be 0.
+ * @retval 1 if started, 0 if the frequency is out of range
+ */
+u8 TIM_PWM_StartFine(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 frequency_mHz, u32 duty, TIM_PWM_Setting_t *achieved)
+{
+	TIM_PWM_Setting_t setting;
 
-		SET_BIT(TIMx->CCER, CCER_CC3E);  // Enable capture/compare channel
-		break;
+	if (!TIM_PWM_Compute(frequency_mHz, duty, &setting))
+	{
+		return 0;
+	}
 
-	case TIM_CH4:
-		TIMx->CCMR2 |= CCS_Direction << CCMR2_CC4S; // Select the active input
+	/* Pin initialization for timer channel */
+	TIM_Pin_Init(TIMx, TIM_CHx, GPIO_OUTPUT_AF_PP_2MHZ);
 
-		// Select the active polarity
-		if (TIM_IC_Edge == TIM_IC_RISING_EDGE)
-		{
-			CLR_BIT(TIMx->CCER, CCER_CC4P);
-		}
-		else if (TIM_IC_Edge == TIM_IC_FALLING_EDGE)
-		{
-			SET_BIT(TIMx->CCER, CCER_CC4P);
-		}
+	CLR_BIT(TIMx->CR1, CR1_CEN);
 
-		// Enable or disable Interrupt
-		if (TIM_INT_Status == TIM_INT_ENABLE)
-		{
-			SET_BIT(TIMx->DIER, DIER_CC1IE);
-		}
-		else if (TIM_INT_Status == TIM_INT_DISABLE)
+	TIMx->PSC = setting.prescaler;
+	TIMx->ARR = setting.reload;
+	TIM_OC_SetCompare(TIMx, TIM_CHx, setting.compare);
+
+	/* Individual channel initialization, PWM mode 1: high while the counter is below the compare value */
+	TIM_CH_SetMode(TIMx, TIM_CHx, (OCM_PWM1 << CCMR1_OC1M) | (0x01UL << CCMR1_OC1PE));
+	SET_BIT(TIMx->CCER, TIM_Channel_Descs[TIM_CHx].ccerShift);
+
+	if (TIMx == TIM1)
+	{
+		SET_BIT(TIMx->BDTR, BDTR_MOE); //  Main output enable for TIM1 only
+	}
+
+	SET_BIT(TIMx->CR1, CR1_ARPE); //  Enable the auto-reload preload register
+	SET_BIT(TIMx->EGR, EGR_UG);   // Load the prescaler, reload and compare values
+	SET_BIT(TIMx->CR1, CR1_CEN);  // Enable the Timer/Counter
+
+	if (achieved != 0)
+	{
+		*achieved = setting;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief  Changes the duty cycle of a running PWM signal at its next period.
+ * @note   The compare value goes through the preload register, may be called from an interrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel started by TIM_PWM_StartFine.
+ * @param  duty : Desired duty cycle in 0.01% units (0 to TIM_DUTY_FULL).
+ * @retval Achieved duty cycle in 0.01% units
+ */
+u32 TIM_PWM_SetDuty(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 duty)
+{
+	u32 period = TIMx->ARR + 1UL;
+	u32 compare;
+
+	if (duty > TIM_DUTY_FULL)
+	{
+		duty = TIM_DUTY_FULL;
+	}
+
+	compare = (duty * period + TIM_DUTY_FULL / 2UL) / TIM_DUTY_FULL;
+	TIM_OC_SetCompare(TIMx, TIM_CHx, compare);
+
+	return (compare * TIM_DUTY_FULL + period / 2UL) / period;
+}
+
+/**
+ * @brief  Changes the frequency of a running PWM signal at its next period, keeping its duty cycle.
+ * @note   Runs the TIM_PWM_Compute search, fast sweeps should compute their settings
+ *         beforehand and load them with TIM_PWM_Apply.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel started by TIM_PWM_StartFine.
+ * @param  frequency_mHz : Desired frequency in mHz.
+ * @param  achieved : Pointer to the setting to be filled with the achieved values, may be 0.
+ * @retval 1 if changed, 0 if the frequency is out of range
+ */
+u8 TIM_PWM_SetFrequency(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 frequency_mHz, TIM_PWM_Setting_t *achieved)
+{
+	TIM_PWM_Setting_t setting;
+	u32 period = TIMx->ARR + 1UL;
+	u32 duty = (TIM_OC_GetCompare(TIMx, TIM_CHx) * TIM_DUTY_FULL + period / 2UL) / period;
+
+	if (!TIM_PWM_Compute(frequency_mHz, duty, &setting))
+	{
+		return 0;
+	}
+
+	TIM_PWM_Apply(TIMx, TIM_CHx, &setting);
+
+	if (achieved != 0)
+	{
+		*achieved = setting;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief  Loads a computed setting into a running PWM signal, taking effect as a whole at its next period.
+ * @note   The prescaler, reload and compare values go through the preload registers with update
+ *         events held off while writing, may be called from an interrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel started by TIM_PWM_StartFine.
+ * @param  setting : Pointer to the setting filled by TIM_PWM_Compute.
+ * @retval None
+ */
+void TIM_PWM_Apply(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, const TIM_PWM_Setting_t *setting)
+{
+	// Hold the shadow registers while writing so that no period mixes old and new values
+	SET_BIT(TIMx->CR1, CR1_UDIS);
+
+	TIMx->PSC = setting->prescaler;
+	TIMx->ARR = setting->reload;
+	TIM_OC_SetCompare(TIMx, TIM_CHx, setting->compare);
+
+	CLR_BIT(TIMx->CR1, CR1_UDIS);
+}
+
+/**
+ * @brief  Starts a complementary PWM output pair (CHx and CHxN) with dead time, for half-bridge signals.
+ * @note   TIM1 channels 1 to 3 only. CHx is high for the reference high time minus the dead time,
+ *         CHxN for the reference low time minus the dead time. Both outputs are low when stopped
+ *         or on a break, until TIM_Break_Resume.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, or TIM_CH3).
+ * @param  config : Pointer to the frequency, duty cycle, dead time and break configuration.
+ * @param  achieved : Pointer to the setting to be filled with the achieved values, may be 0.
+ * @param  deadTime_ns : Pointer to the achieved dead time in ns to be filled, may be 0.
+ * @retval 1 if started, 0 if the timer, channel, frequency or dead time is out of range
+ */
+u8 TIM_PWM_StartComplementary(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, const TIM_Complementary_t *config,
+		TIM_PWM_Setting_t *achieved, u32 *deadTime_ns)
+{
+	TIM_PWM_Setting_t setting;
+	u32 dtg, achievedDeadTime = 0;
+	u32 bdtr;
+
+	if (TIMx != TIM1 || TIM_CHx == TIM_CH4)
+	{
+		return 0;
+	}
+
+	dtg = TIM_DeadTime_Encode(config->deadTime_ns, &achievedDeadTime);
+	if (dtg > BDTR_DTG_MASK || !TIM_PWM_Compute(config->frequency_mHz, config->duty, &setting))
+	{
+		return 0;
+	}
+
+	/* Outputs off while the pair is configured */
+	CLR_BIT(TIMx->BDTR, BDTR_MOE);
+	CLR_BIT(TIMx->CR1, CR1_CEN);
+
+	/* CHx pins on port A, CHxN pins PB13 to PB15, BKIN PB12 */
+	TIM_Pin_Init(TIMx, TIM_CHx, GPIO_OUTPUT_AF_PP_50MHZ);
+	GPIO_SetPinDirSpeed(GPIOB, (GPIO_PinNum_t)(GPIO_PIN13 + TIM_CHx), GPIO_OUTPUT_AF_PP_50MHZ);
+	if (config->breakInput != TIM_BREAK_DISABLE)
+	{
+		// Pulled to the inactive level, an unconnected break input does not stop the outputs
+		GPIO_SetPinDirSpeed(GPIOB, GPIO_PIN12, GPIO_INPUT_PU_PD);
+		GPIO_SetPinValue(GPIOB, GPIO_PIN12, (config->breakInput == TIM_BREAK_ACTIVE_LOW) ? GPIO_PIN_HIGH : GPIO_PIN_LOW);
+	}
+
+	/* Both outputs idle low: OISx and OISxN cleared */
+	TIMx->CR2 &= ~(0x03UL << (CR2_OIS1 + 2UL * TIM_CHx));
+
+	/* Dead time, break polarity, outputs driven inactive rather than released when disabled */
+	bdtr = (dtg << BDTR_DTG) | (0x01UL << BDTR_OSSR) | (0x01UL << BDTR_OSSI);
+	if (config->breakInput != TIM_BREAK_DISABLE)
+	{
+		bdtr |= (0x01UL << BDTR_BKE);
+		if (config->breakInput == TIM_BREAK_ACTIVE_HIGH)
 		{
-			CLR_BIT(TIMx->DIER, DIER_CC1IE);
+			bdtr |= (0x01UL << BDTR_BKP);
 		}
+	}
+	TIMx->BDTR = bdtr;
+
+	TIMx->PSC = setting.prescaler;
+	TIMx->ARR = setting.reload;
+	TIM_OC_SetCompare(TIMx, TIM_CHx, setting.compare);
+
+	/* PWM mode 1 with preload on the channel, CCxE and CCxNE active high */
+	TIM_CH_SetMode(TIMx, TIM_CHx, (OCM_PWM1 << CCMR1_OC1M) | (0x01UL << CCMR1_OC1PE));
+	TIMx->CCER &= ~(0x0FUL << TIM_Channel_Descs[TIM_CHx].ccerShift);
+	TIMx->CCER |= ((0x01UL << CCER_CC1E) | (0x01UL << CCER_CC1NE)) << TIM_Channel_Descs[TIM_CHx].ccerShift;
+
+	SET_BIT(TIMx->CR1, CR1_ARPE);
+	SET_BIT(TIMx->EGR, EGR_UG);
+	TIMx->SR = ~(0x01UL << SR_BIF);  // Drop a break latched while the outputs were off
+	SET_BIT(TIMx->BDTR, BDTR_MOE);
+	SET_BIT(TIMx->CR1, CR1_CEN);
+
+	if (achieved != 0)
+	{
+		*achieved = setting;
+	}
+	if (deadTime_ns != 0)
+	{
+		*deadTime_ns = achievedDeadTime;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief  Stops a complementary PWM output pair, both outputs are driven low.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, or TIM_CH3).
+ * @retval None
+ */
+void TIM_PWM_StopComplementary(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx)
+{
+	// With MOE cleared and OSSI set, both outputs take their low idle state
+	CLR_BIT(TIMx->BDTR, BDTR_MOE);
+	TIMx->CCER &= ~(0x0FUL << TIM_Channel_Descs[TIM_CHx].ccerShift);
+	CLR_BIT(TIMx->CR1, CR1_CEN);
+	TIMx->BDTR = 0;
+}
+
+/**
+ * @brief  Checks whether a break turned the outputs off since the last TIM_Break_Resume.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1).
+ * @retval 1 if the outputs are off, 0 otherwise
+ */
+u8 TIM_Break_IsActive(volatile TIM_TypeDef *TIMx)
+{
+	return GET_BIT(TIMx->BDTR, BDTR_BKE) && !GET_BIT(TIMx->BDTR, BDTR_MOE);
+}
 
-		SET_BIT(TIMx->CCER, CCER_CC4E);  // Enable capture/compare channel
-		break;
+/**
+ * @brief  Enables the outputs again after a break, if the break input is no longer active.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1).
+ * @retval None
+ */
+void TIM_Break_Resume(volatile TIM_TypeDef *TIMx)
+{
+	// MOE can't be set while the break input is active, it stays cleared then
+	TIMx->SR = ~(0x01UL << SR_BIF);
+	SET_BIT(TIMx->BDTR, BDTR_MOE);
+}
+
+/**
+ * @brief  Enables or disables the DMA request of the timer update event.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_DMA_Status : TIM_INT_ENABLE or TIM_INT_DISABLE.
+ * @retval None
+ */
+void TIM_DMA_SetUpdateRequest(volatile TIM_TypeDef *TIMx, TIM_INT_Status_t TIM_DMA_Status)
+{
+	if (TIM_DMA_Status == TIM_INT_ENABLE)
+	{
+		SET_BIT(TIMx->DIER, DIER_UDE);
+	}
+	else
+	{
+		CLR_BIT(TIMx->DIER, DIER_UDE);
 	}
+}
+
+/**
+ * @brief  Starts Input Capture (IC) mode on the specified timer channel with the given configuration.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  CCS_Direction : Capture/Compare selection from @defgroup CCS_DIRECTION
+ * @param  TIM_IC_Edge : Selection of edge for capture (TIM_IC_RISING_EDGE or TIM_IC_FALLING_EDGE)
+ * @param  TIM_INT_Status: Enable/disable timer capture interrupt (TIM_INT_ENABLE or TIM_INT_DISABLE).
+ * @retval None
+ */
+void TIM_IC_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u8 CCS_Direction, TIM_IC_Edge_t TIM_IC_Edge , TIM_INT_Status_t TIM_INT_Status)
+{
+	const TIM_Channel_Desc_t *desc = &TIM_Channel_Descs[TIM_CHx];
+
+	/* Pin initialization for timer channel, an indirect input uses the pin of the paired channel */
+	if (CCS_Direction == CCS_IP_DIRECT)
+	{
+		TIM_Pin_Init(TIMx, TIM_CHx, GPIO_INPUT_FLOATING);
+	}
+
+	/* Individual channel initialization*/
+	*TIM_Reg(TIMx, desc->ccmr) |= ((u32)CCS_Direction << CCMR1_CC1S) << desc->ccmrShift;  // Select the active input
+
+	// Select the active polarity
+	if (TIM_IC_Edge == TIM_IC_RISING_EDGE)
+	{
+		CLR_BIT(TIMx->CCER, (desc->ccerShift + CCER_CC1P));
+	}
+	else if (TIM_IC_Edge == TIM_IC_FALLING_EDGE)
+	{
+		SET_BIT(TIMx->CCER, (desc->ccerShift + CCER_CC1P));
+	}
+
+	// Enable or disable Interrupt
+	if (TIM_INT_Status == TIM_INT_ENABLE)
+	{
+		SET_BIT(TIMx->DIER, desc->flag);
+	}
+	else if (TIM_INT_Status == TIM_INT_DISABLE)
+	{
+		CLR_BIT(TIMx->DIER, desc->flag);
+	}
+
+	SET_BIT(TIMx->CCER, desc->ccerShift);  // Enable capture/compare channel
 	TIMx->ARR = TIM_MAX_PERIOD;
 	SET_BIT(TIMx->CR1, CR1_CEN); // Enable timer/counter
 }
@@ -319,66 +811,274 @@ void TIM_IC_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u8 CCS_Direction
  */
 void TIM_IC_INT_Enable(volatile TIM_TypeDef *TIMx)
 {
-	if (TIMx == TIM1)
+	const TIM_Desc_t *desc = TIM_GetDesc(TIMx);
+
+	if (desc != 0)
 	{
-		NVIC_EnableIRQ(TIM1_CC_IRQn);
+		NVIC_EnableIRQ(desc->ccIRQn);
 	}
-	else if (TIMx == TIM2)
+}
+
+/**
+ * @brief  Changes the capture edge of a channel already started in Input Capture mode.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  TIM_IC_Edge : Selection of edge for capture (TIM_IC_RISING_EDGE or TIM_IC_FALLING_EDGE)
+ * @retval None
+ */
+void TIM_IC_SetEdge(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, TIM_IC_Edge_t TIM_IC_Edge)
+{
+	if (TIM_IC_Edge == TIM_IC_RISING_EDGE)
 	{
-		NVIC_EnableIRQ(TIM2_IRQn);
+		CLR_BIT(TIMx->CCER, (TIM_Channel_Descs[TIM_CHx].ccerShift + CCER_CC1P));
 	}
-	else if (TIMx == TIM3)
+	else if (TIM_IC_Edge == TIM_IC_FALLING_EDGE)
 	{
-		NVIC_EnableIRQ(TIM3_IRQn);
+		SET_BIT(TIMx->CCER, (TIM_Channel_Descs[TIM_CHx].ccerShift + CCER_CC1P));
 	}
 }
 
 /**
- * @brief  Sets the callback function for the TIM1 update event interrupt
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Sets the prescaler of the timer counter clock, the counter is restarted.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  prescaler : Counter clock is TIM_CLK / (prescaler + 1).
  * @retval None
  */
-void TIM1_UP_SetCallback(void (*functionPtr)(void))
+void TIM_SetPrescaler(volatile TIM_TypeDef *TIMx, u16 prescaler)
 {
-	TIM1_UP_Callback_Ptr = functionPtr;
+	TIMx->PSC = prescaler;
+	SET_BIT(TIMx->EGR, EGR_UG);   // Load the prescaler now
+	TIMx->SR = ~(0x01UL << SR_UIF);  // SR is rc_w0, writing 1 leaves the other flags
 }
 
 /**
- * @brief  Sets the callback function for the TIM1 trigger and communication interrupts.
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Sets the input capture prescaler of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  TIM_IC_Prescaler : Number of events per capture from @ref TIM_IC_Prescaler_t.
+ * @retval None
+ */
+void TIM_IC_SetPrescaler(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, TIM_IC_Prescaler_t TIM_IC_Prescaler)
+{
+	const TIM_Channel_Desc_t *desc = &TIM_Channel_Descs[TIM_CHx];
+	volatile u32 *ccmr = TIM_Reg(TIMx, desc->ccmr);
+	u32 shift = desc->ccmrShift + CCMR1_IC1PSC;
+
+	*ccmr = (*ccmr & ~(ICPSC_MASK << shift)) | ((u32)TIM_IC_Prescaler << shift);
+}
+
+/**
+ * @brief  Enables or disables the capture interrupt of a timer channel.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @param  TIM_INT_Status : Interrupt status (TIM_INT_ENABLE or TIM_INT_DISABLE).
  * @retval None
  */
-void TIM1_TRG_COM_SetCallback(void (*functionPtr)(void))
+void TIM_IC_SetInterrupt(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, TIM_INT_Status_t TIM_INT_Status)
 {
-	TIM1_TRG_COM_Callback_Ptr = functionPtr;
+	if (TIM_INT_Status == TIM_INT_ENABLE)
+	{
+		// Drop a capture latched while the interrupt was disabled, and the overcapture the
+		// captures left unread meanwhile would otherwise report with the next one
+		TIMx->SR = ~((0x01UL << TIM_Channel_Descs[TIM_CHx].flag) |
+				(0x01UL << (TIM_Channel_Descs[TIM_CHx].flag + SR_CCOF_OFFSET)));
+		SET_BIT(TIMx->DIER, TIM_Channel_Descs[TIM_CHx].flag);
+	}
+	else
+	{
+		CLR_BIT(TIMx->DIER, TIM_Channel_Descs[TIM_CHx].flag);
+	}
+}
+
+/**
+ * @brief  Clocks the timer counter with the rising edges of a channel input (external clock mode 1),
+ *         so that the counter counts the input edges.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel of the input (TIM_CH1 or TIM_CH2).
+ * @retval None
+ */
+void TIM_ExtClock_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx)
+{
+	u32 smcr = TIMx->SMCR & ~((SMCR_SMS_MASK << SMCR_SMS) | (SMCR_TS_MASK << SMCR_TS));
+
+	smcr |= ((TIM_CHx == TIM_CH2) ? TS_TI2FP2 : TS_TI1FP1) << SMCR_TS;
+	smcr |= SMS_EXT1 << SMCR_SMS;
+	TIMx->SMCR = smcr;
+}
+
+/**
+ * @brief  Clocks the timer counter again with the internal clock.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @retval None
+ */
+void TIM_ExtClock_Stop(volatile TIM_TypeDef *TIMx)
+{
+	TIMx->SMCR &= ~(SMCR_SMS_MASK << SMCR_SMS);
+}
+
+/**
+ * @brief  Starts periodic update events every gate time, used to time a measurement gate.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  gateTime_us : Time between update events in us.
+ * @param  TIM_INT_Status : Update interrupt status (TIM_INT_ENABLE or TIM_INT_DISABLE).
+ * @retval None
+ */
+void TIM_Gate_Start(volatile TIM_TypeDef *TIMx, u32 gateTime_us, TIM_INT_Status_t TIM_INT_Status)
+{
+	const TIM_Desc_t *desc = TIM_GetDesc(TIMx);
+	u32 ticks = gateTime_us * (TIM_CLK / 1000000UL);
+	u32 prescaler = ticks / (TIM_MAX_PERIOD + 1UL);   // Smallest prescaler keeping the period in 16 bits
+	u32 period = ticks / (prescaler + 1UL);
+
+	CLR_BIT(TIMx->CR1, CR1_CEN);
+
+	TIMx->PSC = prescaler;
+	TIMx->ARR = period - 1UL;
+	SET_BIT(TIMx->EGR, EGR_UG);   // Load the prescaler and restart the counter
+	TIMx->SR = ~(0x01UL << SR_UIF);   // The forced update does not end a gate
+
+	if (TIM_INT_Status == TIM_INT_ENABLE && desc != 0)
+	{
+		SET_BIT(TIMx->DIER, DIER_UIE);
+		NVIC_EnableIRQ(desc->upIRQn);
+	}
+	else
+	{
+		CLR_BIT(TIMx->DIER, DIER_UIE);
+	}
+
+	SET_BIT(TIMx->CR1, CR1_CEN);  // Enable the Timer/Counter
+}
+
+/**
+ * @brief  Checks and clears the update event of a gate timer.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @retval 1 if a gate time elapsed since the last call, 0 otherwise
+ */
+u8 TIM_Gate_IsElapsed(volatile TIM_TypeDef *TIMx)
+{
+	if (!GET_BIT(TIMx->SR, SR_UIF))
+	{
+		return 0;
+	}
+
+	TIMx->SR = ~(0x01UL << SR_UIF);
+	return 1;
 }
 
 /**
- * @brief  Sets the callback function for the capture/compare interrupt
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Stops a gate timer and its update interrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
  * @retval None
  */
-void TIM1_CC_SetCallback(void (*functionPtr)(void))
+void TIM_Gate_Stop(volatile TIM_TypeDef *TIMx)
 {
-	TIM1_CC_Callback_Ptr = functionPtr;
+	CLR_BIT(TIMx->CR1, CR1_CEN);
+	CLR_BIT(TIMx->DIER, DIER_UIE);
+	TIMx->SR = ~(0x01UL << SR_UIF);
 }
+
 /**
- * @brief  Sets the callback function for the TIM2 interrupt.
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Sets the callback of a timer event, called from the timer interrupt once the event flag is cleared.
+ * @note   Does not enable the event interrupt, see TIM_Event_SetInterrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  event : Timer event from @ref TIM_Event_t.
+ * @param  callback : Pointer to the callback function, 0 to only clear the event.
+ * @param  context : User pointer passed back to the callback.
  * @retval None
  */
-void TIM2_SetCallback(void (*functionPtr)(void))
+void TIM_SetEventCallback(volatile TIM_TypeDef *TIMx, TIM_Event_t event, TIM_EventCallback_t callback, void *context)
 {
-	TIM2_Callback_Ptr = functionPtr;
+	const TIM_Desc_t *desc = TIM_GetDesc(TIMx);
+	TIM_Handler_t *handler;
+
+	if (desc == 0 || event >= TIM_EVENT_COUNT)
+	{
+		return;
+	}
+
+	// The interrupt may be running: the callback is dropped while its context changes
+	handler = &TIM_Handlers[desc - TIM_Descs][event];
+	handler->callback = 0;
+	handler->context = context;
+	handler->callback = callback;
 }
+
 /**
- * @brief  Sets the callback function for the TIM3 interrupt.
- * @param  functionPtr :  Pointer to the callback function.
+ * @brief  Enables or disables the interrupt of a timer event and its interrupt line.
+ * @note   The capture interrupts are usually set by TIM_IC_Start or TIM_IC_SetInterrupt.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  event : Timer event from @ref TIM_Event_t.
+ * @param  TIM_INT_Status : Interrupt status (TIM_INT_ENABLE or TIM_INT_DISABLE).
  * @retval None
  */
-void TIM3_SetCallback(void (*functionPtr)(void))
+void TIM_Event_SetInterrupt(volatile TIM_TypeDef *TIMx, TIM_Event_t event, TIM_INT_Status_t TIM_INT_Status)
 {
-	TIM3_Callback_Ptr = functionPtr;
+	const TIM_Desc_t *desc = TIM_GetDesc(TIMx);
+
+	if (desc == 0 || event >= TIM_EVENT_COUNT)
+	{
+		return;
+	}
+
+	if (TIM_INT_Status == TIM_INT_ENABLE)
+	{
+		// Drop an event latched while the interrupt was disabled
+		TIMx->SR = ~(0x01UL << event);
+		SET_BIT(TIMx->DIER, event);
+		NVIC_EnableIRQ(TIM_GetIRQn(TIMx, event));
+	}
+	else
+	{
+		CLR_BIT(TIMx->DIER, event);
+	}
+}
+
+/**
+ * @brief  Returns the captures of a channel overwritten before their interrupt was served (CCxOF).
+ * @note   Counted by the interrupt handler, for channels with their capture event interrupt enabled.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Timer channel (TIM_CH1, TIM_CH2, TIM_CH3, or TIM_CH4).
+ * @retval Overcaptures counted since reset, wrapping
+ */
+u32 TIM_IC_GetOvercaptures(volatile TIM_TypeDef* TIMx, TIM_CH_t TIM_CHx)
+{
+	const TIM_Desc_t *desc = TIM_GetDesc(TIMx);
+
+	if (desc == 0)
+	{
+		return 0;
+	}
+
+	return TIM_Overcaptures[desc - TIM_Descs][TIM_CHx];
+}
+
+/**
+ * @brief  Returns the interrupt line serving a timer event, to set its priority.
+ * @note   TIM2 and TIM3 serve all their events on a single line.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  event : Timer event from @ref TIM_Event_t.
+ * @retval Interrupt number
+ */
+IRQn_Type TIM_GetIRQn(volatile TIM_TypeDef *TIMx, TIM_Event_t event)
+{
+	const TIM_Desc_t *desc = TIM_GetDesc(TIMx);
+
+	if (desc == 0)
+	{
+		return TIM3_IRQn;  // Not a timer of the table, only avoids a null access
+	}
+
+	if (event == TIM_EVENT_UPDATE)
+	{
+		return desc->upIRQn;
+	}
+	else if ((TIM_EVENTS_CC >> event) & 0x01UL)
+	{
+		return desc->ccIRQn;
+	}
+
+	return desc->trgIRQn;
 }
 
 /**
@@ -388,10 +1088,7 @@ void TIM3_SetCallback(void (*functionPtr)(void))
  */
 void TIM1_UP_IRQHandler(void)
 {
-	if (TIM1_UP_Callback_Ptr != 0)
-	{
-		TIM1_UP_Callback_Ptr();
-	}
+	TIM_IRQ_Dispatch(0, 0x01UL << TIM_EVENT_UPDATE);
 }
 
 /**
@@ -401,10 +1098,7 @@ void TIM1_UP_IRQHandler(void)
  */
 void TIM1_TRG_COM_IRQHandler(void)
 {
-	if (TIM1_TRG_COM_Callback_Ptr != 0)
-	{
-		TIM1_TRG_COM_Callback_Ptr();
-	}
+	TIM_IRQ_Dispatch(0, TIM_EVENTS_TRGCOM);
 }
 
 /**
@@ -414,10 +1108,7 @@ void TIM1_TRG_COM_IRQHandler(void)
  */
 void TIM1_CC_IRQHandler(void)
 {
-	if (TIM1_CC_Callback_Ptr != 0)
-	{
-		TIM1_CC_Callback_Ptr();
-	}
+	TIM_IRQ_Dispatch(0, TIM_EVENTS_CC);
 }
 
 /**
@@ -427,10 +1118,7 @@ void TIM1_CC_IRQHandler(void)
  */
 void TIM2_IRQHandler(void)
 {
-	if (TIM3_Callback_Ptr != 0)
-	{
-		TIM2_Callback_Ptr();
-	}
+	TIM_IRQ_Dispatch(1, TIM_EVENTS_ALL);
 }
 
 /**
@@ -440,10 +1128,5 @@ void TIM2_IRQHandler(void)
  */
 void TIM3_IRQHandler(void)
 {
-
-	if (TIM3_Callback_Ptr != 0)
-	{
-		TIM3_Callback_Ptr();
-	}
-
+	TIM_IRQ_Dispatch(2, TIM_EVENTS_ALL);
 }
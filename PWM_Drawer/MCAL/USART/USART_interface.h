@@ -0,0 +1,56 @@
+/**
+ ******************************************************************************
+ * @file    USART_interface.h
+ * @author  Salma Faragalla
+ * @ brief  Header file of USART module.
+ ******************************************************************************
+ */
+#ifndef USART_USART_INTERFACE_H_
+#define USART_USART_INTERFACE_H_
+
+#include "STM32F103.h"
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Configures a USART for transmission only, 8 data bits, no parity, 1 stop bit.
+ *         USART1 transmits on PA9 through DMA1 channel 4.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @param  baudRate : Baud rate in bit/s, up to PCLK2 / 16 (4.5 Mbit/s at 72 MHz).
+ * @retval Achieved baud rate in bit/s, 0 for an unsupported USART
+ */
+u32 USART_Init(volatile USART_TypeDef *USARTx, u32 baudRate);
+
+/**
+ * @brief  Starts the DMA transmission of a buffer, which must stay untouched until it completes.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @param  data : Pointer to the bytes to be sent.
+ * @param  length : Number of bytes (1 or more).
+ * @retval 1 if the transmission started, 0 if the previous one is still running
+ */
+u8 USART_SendDMA(volatile USART_TypeDef *USARTx, const u8 *data, u16 length);
+
+/**
+ * @brief  Checks whether a DMA transmission is running.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @retval 1 if the DMA still moves bytes to the USART, 0 otherwise
+ */
+u8 USART_IsBusy(volatile USART_TypeDef *USARTx);
+
+/**
+ * @brief  Returns the interrupt line of the transmit DMA channel, to set its priority.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @retval Interrupt number
+ */
+IRQn_Type USART_GetIRQn(volatile USART_TypeDef *USARTx);
+
+/* Callback functions --------------------------------------------------------*/
+/**
+ * @brief  Sets the function called when the DMA has written the last byte of a transmission,
+ *         a new one can be started from the callback.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @param  functionPtr : Pointer to the callback function.
+ * @retval None
+ */
+void USART_SetTxCompleteCallback(volatile USART_TypeDef *USARTx, void (*functionPtr)(void));
+
+#endif /* USART_USART_INTERFACE_H_ */
@@ -0,0 +1,39 @@
+/**
+ ******************************************************************************
+ * @file    USART_private.h
+ * @author  Salma Faragalla
+ ******************************************************************************
+ */
+
+#ifndef USART_USART_PRIVATE_H_
+#define USART_USART_PRIVATE_H_
+
+typedef struct
+{
+	volatile u32 SR;
+	volatile u32 DR;
+	volatile u32 BRR;
+	volatile u32 CR1;
+	volatile u32 CR2;
+	volatile u32 CR3;
+	volatile u32 GTPR;
+
+}USART_TypeDef;
+
+#define USART1 ((volatile USART_TypeDef*)0x40013800UL)
+
+/* USART Register Pins*/
+
+/* SR */
+#define USART_SR_TC  (6UL)
+#define USART_SR_TXE (7UL)
+
+/* CR1 */
+#define USART_CR1_RE (2UL)
+#define USART_CR1_TE (3UL)
+#define USART_CR1_UE (13UL)
+
+/* CR3 */
+#define USART_CR3_DMAT (7UL)
+
+#endif /* USART_USART_PRIVATE_H_ */
@@ -0,0 +1,149 @@
+/**
+ ******************************************************************************
+ * @file    USART_program.c
+ * @author  Salma Faragalla
+ * @ brief  USART module driver
+ ******************************************************************************
+ */
+/* Includes -------------------------------------------------------------------*/
+#include "BIT_MATH.h"
+
+#include "../GPIO/GPIO_interface.h"
+#include "../DMA/DMA_interface.h"
+
+#include "USART_interface.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define USART1_TX_DMA_CH (DMA_CH4)   // Fixed request mapping of USART1_TX
+
+/* Private Variables -------------------------------------------------------------------*/
+static const DMA_Config_t USART_TxDMAConfig = {
+	DMA_MEM_TO_PERIPH, DMA_MODE_NORMAL, DMA_SIZE_8BIT, DMA_SIZE_8BIT, 0, 1, DMA_PRIORITY_MEDIUM
+};
+
+static volatile u8 USART1_TxBusy = 0;
+static void (*USART1_TxComplete_Callback_Ptr)(void);
+
+/*Private Functions prototypes -------------------------------------------------*/
+/**
+ * @brief  Transfer complete callback of the USART1 transmit DMA channel.
+ * @param  None
+ * @retval None
+ */
+static void USART1_TxDMA_Callback(void);
+
+/* Private Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Transfer complete callback of the USART1 transmit DMA channel.
+ * @param  None
+ * @retval None
+ */
+static void USART1_TxDMA_Callback(void)
+{
+	DMA_Stop(USART1_TX_DMA_CH);
+	USART1_TxBusy = 0;
+
+	if (USART1_TxComplete_Callback_Ptr != 0)
+	{
+		USART1_TxComplete_Callback_Ptr();
+	}
+}
+
+/* Public Functions -------------------------------------------------------------------*/
+/**
+ * @brief  Configures a USART for transmission only, 8 data bits, no parity, 1 stop bit.
+ *         USART1 transmits on PA9 through DMA1 channel 4.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @param  baudRate : Baud rate in bit/s, up to PCLK2 / 16 (4.5 Mbit/s at 72 MHz).
+ * @retval Achieved baud rate in bit/s, 0 for an unsupported USART
+ */
+u32 USART_Init(volatile USART_TypeDef *USARTx, u32 baudRate)
+{
+	u32 brr;
+
+	if (USARTx != USART1 || baudRate == 0)
+	{
+		return 0;
+	}
+
+	RCC_GPIOA_CLK_EN();
+	RCC_USART1_CLK_EN();
+	DMA_Init();
+
+	GPIO_SetPinDirSpeed(GPIOA, GPIO_PIN9, GPIO_OUTPUT_AF_PP_50MHZ);
+
+	// BRR holds PCLK2 / baud rate in 1/16 steps (mantissa and fraction), rounded to the nearest
+	brr = (RCC_PCLK2_HZ + baudRate / 2UL) / baudRate;
+	if (brr < 16UL)
+	{
+		brr = 16UL;
+	}
+
+	USARTx->CR1 = 0;
+	USARTx->CR2 = 0;   // 1 stop bit
+	USARTx->BRR = brr;
+	USARTx->CR3 = (0x01UL << USART_CR3_DMAT);
+	USARTx->CR1 = (0x01UL << USART_CR1_UE) | (0x01UL << USART_CR1_TE);
+
+	DMA_SetCompleteCallback(USART1_TX_DMA_CH, USART1_TxDMA_Callback);
+	USART1_TxBusy = 0;
+
+	return RCC_PCLK2_HZ / brr;
+}
+
+/**
+ * @brief  Starts the DMA transmission of a buffer, which must stay untouched until it completes.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @param  data : Pointer to the bytes to be sent.
+ * @param  length : Number of bytes (1 or more).
+ * @retval 1 if the transmission started, 0 if the previous one is still running
+ */
+u8 USART_SendDMA(volatile USART_TypeDef *USARTx, const u8 *data, u16 length)
+{
+	if (USARTx != USART1 || USART1_TxBusy || length == 0)
+	{
+		return 0;
+	}
+
+	USART1_TxBusy = 1;
+	DMA_Start(USART1_TX_DMA_CH, &USART_TxDMAConfig, &USARTx->DR, (void *)data, length);
+
+	return 1;
+}
+
+/**
+ * @brief  Checks whether a DMA transmission is running.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @retval 1 if the DMA still moves bytes to the USART, 0 otherwise
+ */
+u8 USART_IsBusy(volatile USART_TypeDef *USARTx)
+{
+	return (USARTx == USART1) ? USART1_TxBusy : 0;
+}
+
+/**
+ * @brief  Returns the interrupt line of the transmit DMA channel, to set its priority.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @retval Interrupt number
+ */
+IRQn_Type USART_GetIRQn(volatile USART_TypeDef *USARTx)
+{
+	(void)USARTx;   // Only USART1 is supported
+
+	return DMA_GetIRQn(USART1_TX_DMA_CH);
+}
+
+/**
+ * @brief  Sets the function called when the DMA has written the last byte of a transmission,
+ *         a new one can be started from the callback.
+ * @param  USARTx : Pointer to the USART peripheral (USART1).
+ * @param  functionPtr : Pointer to the callback function.
+ * @retval None
+ */
+void USART_SetTxCompleteCallback(volatile USART_TypeDef *USARTx, void (*functionPtr)(void))
+{
+	if (USARTx == USART1)
+	{
+		USART1_TxComplete_Callback_Ptr = functionPtr;
+	}
+}
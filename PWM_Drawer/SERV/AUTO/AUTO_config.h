@@ -0,0 +1,28 @@
+/**
+ ******************************************************************************
+ * @file    AUTO_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for AUTO module.
+ ******************************************************************************
+ */
+#ifndef AUTO_AUTO_CONFIG_H_
+#define AUTO_AUTO_CONFIG_H_
+
+/* Mode selection configurations -----------------------------------------------*/
+#define AUTO_GATED_MIN_HZ       (50000UL)    // Inputs at or above this frequency are counted over a gate
+#define AUTO_GATE_COUNT_TARGET  (32768UL)    // Edges counted per gate in gated mode, within the 16-bit counter
+#define AUTO_GATE_TIME_MAX_US   (100000UL)
+
+/* Reciprocal mode configurations ----------------------------------------------*/
+#define AUTO_TIM_DIVIDERS       { 1U, 8U, 64U, 512U, 4096U }  // Timer clock dividers tried, finest first
+#define AUTO_TIM_DIVIDER_COUNT  (5U)
+#define AUTO_PERIOD_MAX_TICKS   (TIM_MAX_PERIOD / 2UL) // Half the counter range, margin for a slower input
+#define AUTO_CAPTURE_RATE_MAX_HZ (10000UL)   // Capture interrupts per second above which the capture prescaler is used
+
+/* Timebase configurations -----------------------------------------------------*/
+#define AUTO_SCREEN_DIVS        (8U)         // Divisions across the GLCD
+#define AUTO_CYCLES_MIN         (2U)         // The 1-2-5 timebase steps show 2 to 5 cycles
+#define AUTO_TIMEBASE_MIN_US    (2UL)
+#define AUTO_TIMEBASE_MAX_US    (100000UL)
+
+#endif /* AUTO_AUTO_CONFIG_H_ */
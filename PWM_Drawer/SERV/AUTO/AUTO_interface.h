@@ -0,0 +1,82 @@
+/**
+ ******************************************************************************
+ * @file    AUTO_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of AUTO (autoset decision) module.
+ ******************************************************************************
+ */
+#ifndef AUTO_AUTO_INTERFACE_H_
+#define AUTO_AUTO_INTERFACE_H_
+
+#include "STD_TYPES.h"
+#include "../../MCAL/TIM/TIM_interface.h"
+
+#include "AUTO_config.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef AUTO_Mode_t
+ * @brief Enumeration of frequency measurement modes.
+ */
+typedef enum
+{
+	AUTO_MODE_RECIPROCAL = 0, /*!< Period measured between captured rising edges */
+	AUTO_MODE_GATED           /*!< Rising edges counted over a gate time */
+} AUTO_Mode_t;
+
+/**
+ * @typedef AUTO_Setting_t
+ * @brief Measurement and display setting selected for an input.
+ */
+typedef struct
+{
+	AUTO_Mode_t mode;       /*!< Frequency measurement mode */
+	u16 timerDivider;       /*!< Capture timer clock divider (prescaler + 1) in reciprocal mode */
+	u8 capturePrescaler;    /*!< Rising edges per capture in reciprocal mode (1, 2, 4, or 8) */
+	u32 gateTime_us;        /*!< Gate time in gated mode */
+	u32 timePerDiv_us;      /*!< Timebase showing 2 to 5 cycles, 0 if the frequency is unknown */
+	f32 frequency_Hz;       /*!< Estimated frequency, 0 if no edge was seen */
+} AUTO_Setting_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Selects a setting from the number of rising edges counted over a probe gate.
+ * @note   In reciprocal mode the timer divider is chosen for the slowest frequency
+ *         the count allows, to be refined with AUTO_FromPeriod.
+ * @param  setting : Pointer to the setting to be filled.
+ * @param  count : Rising edges counted.
+ * @param  gateTime_us : Probe gate time in us.
+ * @retval None
+ */
+void AUTO_FromGatedCount(AUTO_Setting_t *setting, u32 count, u32 gateTime_us);
+
+/**
+ * @brief  Refines a reciprocal mode setting from a period captured with it.
+ * @param  setting : Pointer to the setting used for the capture.
+ * @param  periodTicks : Captured period in ticks of the setting timer divider.
+ * @retval 1 if the timer divider changed and the period should be captured again, 0 otherwise
+ */
+u8 AUTO_FromPeriod(AUTO_Setting_t *setting, u32 periodTicks);
+
+/**
+ * @brief  Selects the smallest 1-2-5 timebase showing at least AUTO_CYCLES_MIN cycles.
+ * @param  frequency_Hz : Input frequency.
+ * @retval Time per division in us (AUTO_TIMEBASE_MIN_US to AUTO_TIMEBASE_MAX_US)
+ */
+u32 AUTO_SelectTimebase(f32 frequency_Hz);
+
+/**
+ * @brief  Returns the capture timer counter clock of a setting.
+ * @param  setting : Pointer to the setting.
+ * @retval Counter clock in Hz
+ */
+u32 AUTO_GetTickRate(const AUTO_Setting_t *setting);
+
+/**
+ * @brief  Returns the input capture prescaler of a setting.
+ * @param  setting : Pointer to the setting.
+ * @retval Input capture prescaler from @ref TIM_IC_Prescaler_t
+ */
+TIM_IC_Prescaler_t AUTO_GetCapturePrescaler(const AUTO_Setting_t *setting);
+
+#endif /* AUTO_AUTO_INTERFACE_H_ */
@@ -0,0 +1,218 @@
+/**
+ ******************************************************************************
+ * @file    AUTO_program.c
+ * @author  Salma Faragalla
+ * @brief   AUTO (autoset decision) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "AUTO_interface.h"
+
+/* Private functions prototypes ----------------------------------------------*/
+/**
+ * @brief  Selects the finest timer divider keeping a period within AUTO_PERIOD_MAX_TICKS.
+ * @param  minFrequency_Hz : Slowest expected frequency, 0 if unknown.
+ * @retval Timer divider
+ */
+static u16 AUTO_SelectDivider(f32 minFrequency_Hz);
+
+/**
+ * @brief  Selects the capture prescaler keeping the capture rate within AUTO_CAPTURE_RATE_MAX_HZ.
+ * @param  frequency_Hz : Input frequency.
+ * @param  timerDivider : Timer divider used for the capture.
+ * @retval Rising edges per capture (1, 2, 4, or 8)
+ */
+static u8 AUTO_SelectCapturePrescaler(f32 frequency_Hz, u16 timerDivider);
+
+/* Private variables --------------------------------------------------------*/
+static const u16 timerDividers[AUTO_TIM_DIVIDER_COUNT] = AUTO_TIM_DIVIDERS;
+
+/* Private functions --------------------------------------------------------*/
+/**
+ * @brief  Selects the finest timer divider keeping a period within AUTO_PERIOD_MAX_TICKS.
+ * @param  minFrequency_Hz : Slowest expected frequency, 0 if unknown.
+ * @retval Timer divider
+ */
+static u16 AUTO_SelectDivider(f32 minFrequency_Hz)
+{
+	if (minFrequency_Hz <= 0)
+	{
+		return timerDividers[AUTO_TIM_DIVIDER_COUNT - 1];
+	}
+
+	for (u8 i = 0; i < AUTO_TIM_DIVIDER_COUNT; i++)
+	{
+		if ((f32)TIM_CLK / ((f32)timerDividers[i] * minFrequency_Hz) <= (f32)AUTO_PERIOD_MAX_TICKS)
+		{
+			return timerDividers[i];
+		}
+	}
+
+	return timerDividers[AUTO_TIM_DIVIDER_COUNT - 1];
+}
+
+/**
+ * @brief  Selects the capture prescaler keeping the capture rate within AUTO_CAPTURE_RATE_MAX_HZ.
+ * @param  frequency_Hz : Input frequency.
+ * @param  timerDivider : Timer divider used for the capture.
+ * @retval Rising edges per capture (1, 2, 4, or 8)
+ */
+static u8 AUTO_SelectCapturePrescaler(f32 frequency_Hz, u16 timerDivider)
+{
+	f32 periodTicks;
+	u8 events = 1;
+
+	if (frequency_Hz <= 0)
+	{
+		return 1;
+	}
+
+	periodTicks = (f32)TIM_CLK / ((f32)timerDivider * frequency_Hz);
+
+	// The captured span of several periods must stay within the counter range
+	while (events < 8 && frequency_Hz / events > (f32)AUTO_CAPTURE_RATE_MAX_HZ &&
+			periodTicks * (events * 2) <= (f32)AUTO_PERIOD_MAX_TICKS)
+	{
+		events *= 2;
+	}
+
+	return events;
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Selects a setting from the number of rising edges counted over a probe gate.
+ * @note   In reciprocal mode the timer divider is chosen for the slowest frequency
+ *         the count allows, to be refined with AUTO_FromPeriod.
+ * @param  setting : Pointer to the setting to be filled.
+ * @param  count : Rising edges counted.
+ * @param  gateTime_us : Probe gate time in us.
+ * @retval None
+ */
+void AUTO_FromGatedCount(AUTO_Setting_t *setting, u32 count, u32 gateTime_us)
+{
+	f32 frequency = ((f32)count * 1000000.0f) / (f32)gateTime_us;
+	f32 minFrequency;
+	u32 gateTime;
+
+	setting->frequency_Hz = frequency;
+	setting->timePerDiv_us = (count != 0) ? AUTO_SelectTimebase(frequency) : 0;
+	setting->timerDivider = 1;
+	setting->capturePrescaler = 1;
+	setting->gateTime_us = 0;
+
+	if (frequency >= (f32)AUTO_GATED_MIN_HZ)
+	{
+		// Enough edges for a count to beat the timer resolution, the gate is sized
+		// for AUTO_GATE_COUNT_TARGET edges so that the count fits the counter
+		gateTime = (u32)(((f32)AUTO_GATE_COUNT_TARGET * 1000000.0f) / frequency);
+		setting->mode = AUTO_MODE_GATED;
+		setting->gateTime_us = (gateTime > AUTO_GATE_TIME_MAX_US) ? AUTO_GATE_TIME_MAX_US : gateTime;
+		return;
+	}
+
+	// A gate holding a single edge bounds the period from below only
+	minFrequency = (count >= 2) ? (((f32)(count - 1) * 1000000.0f) / (f32)gateTime_us) : 0;
+
+	setting->mode = AUTO_MODE_RECIPROCAL;
+	setting->timerDivider = AUTO_SelectDivider(minFrequency);
+	setting->capturePrescaler = AUTO_SelectCapturePrescaler(((f32)(count + 1) * 1000000.0f) / (f32)gateTime_us,
+			setting->timerDivider);
+}
+
+/**
+ * @brief  Refines a reciprocal mode setting from a period captured with it.
+ * @param  setting : Pointer to the setting used for the capture.
+ * @param  periodTicks : Captured period in ticks of the setting timer divider.
+ * @retval 1 if the timer divider changed and the period should be captured again, 0 otherwise
+ */
+u8 AUTO_FromPeriod(AUTO_Setting_t *setting, u32 periodTicks)
+{
+	u16 divider;
+
+	if (periodTicks == 0)
+	{
+		return 0;
+	}
+
+	setting->frequency_Hz = (f32)AUTO_GetTickRate(setting) / (f32)periodTicks;
+	setting->timePerDiv_us = AUTO_SelectTimebase(setting->frequency_Hz);
+
+	// Keep a 25% margin for a slowing input before the period overflows the counter
+	divider = AUTO_SelectDivider(setting->frequency_Hz * 0.8f);
+	setting->capturePrescaler = AUTO_SelectCapturePrescaler(setting->frequency_Hz, divider);
+
+	if (divider == setting->timerDivider)
+	{
+		return 0;
+	}
+
+	setting->timerDivider = divider;
+	return 1;
+}
+
+/**
+ * @brief  Selects the smallest 1-2-5 timebase showing at least AUTO_CYCLES_MIN cycles.
+ * @param  frequency_Hz : Input frequency.
+ * @retval Time per division in us (AUTO_TIMEBASE_MIN_US to AUTO_TIMEBASE_MAX_US)
+ */
+u32 AUTO_SelectTimebase(f32 frequency_Hz)
+{
+	const u8 steps[3] = { 1, 2, 5 };
+	f32 target;
+	u32 timePerDiv;
+
+	if (frequency_Hz <= 0)
+	{
+		return AUTO_TIMEBASE_MAX_US;
+	}
+
+	target = ((f32)AUTO_CYCLES_MIN * 1000000.0f) / (frequency_Hz * AUTO_SCREEN_DIVS);
+
+	for (u32 decade = 1; decade <= AUTO_TIMEBASE_MAX_US; decade *= 10)
+	{
+		for (u8 i = 0; i < 3; i++)
+		{
+			timePerDiv = steps[i] * decade;
+			if (timePerDiv >= AUTO_TIMEBASE_MIN_US && (f32)timePerDiv >= target)
+			{
+				return (timePerDiv > AUTO_TIMEBASE_MAX_US) ? AUTO_TIMEBASE_MAX_US : timePerDiv;
+			}
+		}
+	}
+
+	return AUTO_TIMEBASE_MAX_US;
+}
+
+/**
+ * @brief  Returns the capture timer counter clock of a setting.
+ * @param  setting : Pointer to the setting.
+ * @retval Counter clock in Hz
+ */
+u32 AUTO_GetTickRate(const AUTO_Setting_t *setting)
+{
+	return TIM_CLK / setting->timerDivider;
+}
+
+/**
+ * @brief  Returns the input capture prescaler of a setting.
+ * @param  setting : Pointer to the setting.
+ * @retval Input capture prescaler from @ref TIM_IC_Prescaler_t
+ */
+TIM_IC_Prescaler_t AUTO_GetCapturePrescaler(const AUTO_Setting_t *setting)
+{
+	switch (setting->capturePrescaler)
+	{
+	case 2:
+		return TIM_IC_PSC_DIV2;
+
+	case 4:
+		return TIM_IC_PSC_DIV4;
+
+	case 8:
+		return TIM_IC_PSC_DIV8;
+
+	default:
+		return TIM_IC_PSC_DIV1;
+	}
+}
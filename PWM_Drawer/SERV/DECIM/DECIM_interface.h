@@ -0,0 +1,90 @@
+/**
+ ******************************************************************************
+ * @file    DECIM_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of DECIM (min/max peak-detect decimation) module.
+ ******************************************************************************
+ */
+#ifndef DECIM_DECIM_INTERFACE_H_
+#define DECIM_DECIM_INTERFACE_H_
+
+#include "STD_TYPES.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef DECIM_t
+ * @brief Min/max decimator reducing a record to one (min, max) pair per display column,
+ *        so that a glitch shorter than a column stays visible.
+ */
+typedef struct
+{
+	u16 *mins;      /*!< Minimum of each column, provided by the user (columns elements) */
+	u16 *maxs;      /*!< Maximum of each column, provided by the user (columns elements) */
+	u16 columns;    /*!< Number of columns */
+	u16 filled;     /*!< Number of columns holding data */
+	u16 column;     /*!< Column receiving the next point */
+	u32 points;     /*!< Number of points of the record being decimated */
+	u32 pushed;     /*!< Number of points pushed since DECIM_Begin */
+	u32 nextStart;  /*!< Index of the first point of the next column */
+	u16 last;       /*!< Last value added */
+	u16 min;        /*!< Minimum of the whole record */
+	u16 max;        /*!< Maximum of the whole record */
+} DECIM_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Initializes a decimator.
+ * @param  decim : Pointer to the decimator.
+ * @param  mins : Pointer to the column minimums storage (columns elements).
+ * @param  maxs : Pointer to the column maximums storage (columns elements).
+ * @param  columns : Number of columns.
+ * @retval None
+ */
+void DECIM_Init(DECIM_t *decim, u16 *mins, u16 *maxs, u16 columns);
+
+/**
+ * @brief  Starts the decimation of a new record.
+ * @param  decim : Pointer to the decimator.
+ * @param  points : Number of points that will be pushed with DECIM_Push
+ *                  (unused when the points are placed with DECIM_AddAt).
+ * @retval None
+ */
+void DECIM_Begin(DECIM_t *decim, u32 points);
+
+/**
+ * @brief  Adds the next point of an evenly spaced record, in a single streaming pass.
+ * @note   Columns without any point hold the value of the following point.
+ * @param  decim : Pointer to the decimator.
+ * @param  value : Value of the point.
+ * @retval None
+ */
+void DECIM_Push(DECIM_t *decim, u16 value);
+
+/**
+ * @brief  Adds a point to a given column, for records whose points carry their own time.
+ * @note   Columns must be given in increasing order, skipped columns hold the last value.
+ * @param  decim : Pointer to the decimator.
+ * @param  column : Column of the point (0 to columns - 1).
+ * @param  value : Value of the point.
+ * @retval None
+ */
+void DECIM_AddAt(DECIM_t *decim, u16 column, u16 value);
+
+/**
+ * @brief  Ends the record, the columns after the last point hold the last value.
+ * @param  decim : Pointer to the decimator.
+ * @retval Number of columns holding data (0 if no point was added)
+ */
+u16 DECIM_End(DECIM_t *decim);
+
+/**
+ * @brief  Maps a value to a pixel row, full scale at the top row.
+ * @param  value : Value to be mapped (0 to fullScale).
+ * @param  fullScale : Value drawn on the top row (must not be zero).
+ * @param  yTop : Row of the full scale value.
+ * @param  yBottom : Row of the zero value.
+ * @retval Pixel row
+ */
+u8 DECIM_ValueToRow(u16 value, u16 fullScale, u8 yTop, u8 yBottom);
+
+#endif /* DECIM_DECIM_INTERFACE_H_ */
@@ -0,0 +1,181 @@
+/**
+ ******************************************************************************
+ * @file    DECIM_program.c
+ * @author  Salma Faragalla
+ * @brief   DECIM (min/max peak-detect decimation) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "DECIM_interface.h"
+
+/* Private functions prototypes ----------------------------------------------*/
+/**
+ * @brief  Adds a value to the current column, opening the columns up to it if needed.
+ * @param  decim : Pointer to the decimator.
+ * @param  value : Value of the point.
+ * @param  holdValue : Value of the skipped columns.
+ * @retval None
+ */
+static void DECIM_AddToColumn(DECIM_t *decim, u16 value, u16 holdValue);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief  Adds a value to the current column, opening the columns up to it if needed.
+ * @param  decim : Pointer to the decimator.
+ * @param  value : Value of the point.
+ * @param  holdValue : Value of the skipped columns.
+ * @retval None
+ */
+static void DECIM_AddToColumn(DECIM_t *decim, u16 value, u16 holdValue)
+{
+	if (decim->filled <= decim->column)
+	{
+		// Skipped columns hold a flat level, the current one opens with this value
+		while (decim->filled < decim->column)
+		{
+			decim->mins[decim->filled] = holdValue;
+			decim->maxs[decim->filled] = holdValue;
+			decim->filled++;
+		}
+		decim->mins[decim->column] = value;
+		decim->maxs[decim->column] = value;
+		decim->filled++;
+	}
+	else if (value < decim->mins[decim->column])
+	{
+		decim->mins[decim->column] = value;
+	}
+	else if (value > decim->maxs[decim->column])
+	{
+		decim->maxs[decim->column] = value;
+	}
+
+	if (value < decim->min)
+	{
+		decim->min = value;
+	}
+	if (value > decim->max)
+	{
+		decim->max = value;
+	}
+
+	decim->last = value;
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Initializes a decimator.
+ * @param  decim : Pointer to the decimator.
+ * @param  mins : Pointer to the column minimums storage (columns elements).
+ * @param  maxs : Pointer to the column maximums storage (columns elements).
+ * @param  columns : Number of columns.
+ * @retval None
+ */
+void DECIM_Init(DECIM_t *decim, u16 *mins, u16 *maxs, u16 columns)
+{
+	decim->mins = mins;
+	decim->maxs = maxs;
+	decim->columns = columns;
+
+	DECIM_Begin(decim, 0);
+}
+
+/**
+ * @brief  Starts the decimation of a new record.
+ * @param  decim : Pointer to the decimator.
+ * @param  points : Number of points that will be pushed with DECIM_Push
+ *                  (unused when the points are placed with DECIM_AddAt).
+ * @retval None
+ */
+void DECIM_Begin(DECIM_t *decim, u32 points)
+{
+	decim->filled = 0;
+	decim->column = 0;
+	decim->points = points;
+	decim->pushed = 0;
+	decim->nextStart = points / decim->columns;
+	decim->last = 0;
+	decim->min = 0xFFFF;
+	decim->max = 0;
+}
+
+/**
+ * @brief  Adds the next point of an evenly spaced record, in a single streaming pass.
+ * @note   Columns without any point hold the value of the following point.
+ * @param  decim : Pointer to the decimator.
+ * @param  value : Value of the point.
+ * @retval None
+ */
+void DECIM_Push(DECIM_t *decim, u16 value)
+{
+	// Column c covers the points [c * points / columns, (c + 1) * points / columns),
+	// one division per column instead of one per point
+	while (decim->pushed >= decim->nextStart && decim->column + 1U < decim->columns)
+	{
+		decim->column++;
+		decim->nextStart = ((u32)(decim->column + 1U) * decim->points) / decim->columns;
+	}
+
+	DECIM_AddToColumn(decim, value, value);
+	decim->pushed++;
+}
+
+/**
+ * @brief  Adds a point to a given column, for records whose points carry their own time.
+ * @note   Columns must be given in increasing order, skipped columns hold the last value.
+ * @param  decim : Pointer to the decimator.
+ * @param  column : Column of the point (0 to columns - 1).
+ * @param  value : Value of the point.
+ * @retval None
+ */
+void DECIM_AddAt(DECIM_t *decim, u16 column, u16 value)
+{
+	if (column >= decim->columns || column < decim->column)
+	{
+		return;
+	}
+
+	decim->column = column;
+	DECIM_AddToColumn(decim, value, (decim->filled != 0) ? decim->last : value);
+}
+
+/**
+ * @brief  Ends the record, the columns after the last point hold the last value.
+ * @param  decim : Pointer to the decimator.
+ * @retval Number of columns holding data (0 if no point was added)
+ */
+u16 DECIM_End(DECIM_t *decim)
+{
+	if (decim->filled == 0)
+	{
+		return 0;
+	}
+
+	while (decim->filled < decim->columns)
+	{
+		decim->mins[decim->filled] = decim->last;
+		decim->maxs[decim->filled] = decim->last;
+		decim->filled++;
+	}
+
+	return decim->filled;
+}
+
+/**
+ * @brief  Maps a value to a pixel row, full scale at the top row.
+ * @param  value : Value to be mapped (0 to fullScale).
+ * @param  fullScale : Value drawn on the top row (must not be zero).
+ * @param  yTop : Row of the full scale value.
+ * @param  yBottom : Row of the zero value.
+ * @retval Pixel row
+ */
+u8 DECIM_ValueToRow(u16 value, u16 fullScale, u8 yTop, u8 yBottom)
+{
+	if (value > fullScale)
+	{
+		value = fullScale;
+	}
+
+	// Rounded to the nearest row
+	return (u8)(yBottom - (((u32)value * (yBottom - yTop) + fullScale / 2U) / fullScale));
+}
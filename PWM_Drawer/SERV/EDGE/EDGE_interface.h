@@ -0,0 +1,160 @@
+/**
+ ******************************************************************************
+ * @file    EDGE_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of EDGE (raw edge time stamp capture) module.
+ ******************************************************************************
+ */
+#ifndef EDGE_EDGE_INTERFACE_H_
+#define EDGE_EDGE_INTERFACE_H_
+
+#include "STD_TYPES.h"
+#include "../../MCAL/TIM/TIM_interface.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef EDGE_State_t
+ * @brief Enumeration of the edge capture states.
+ */
+typedef enum
+{
+	EDGE_IDLE = 0,  /*!< Not capturing */
+	EDGE_ARMED,     /*!< Recording edges */
+	EDGE_DONE       /*!< Record complete and frozen */
+}EDGE_State_t;
+
+/**
+ * @typedef EDGE_Mode_t
+ * @brief Enumeration of the edge capture modes.
+ */
+typedef enum
+{
+	EDGE_MODE_SINGLE = 0,  /*!< Record from the start until the buffer is full */
+	EDGE_MODE_TRIGGER      /*!< Record continuously in a circular buffer, freeze around a trigger */
+}EDGE_Mode_t;
+
+/**
+ * @typedef EDGE_TriggerType_t
+ * @brief Enumeration of the trigger conditions, evaluated on every edge.
+ */
+typedef enum
+{
+	EDGE_TRIG_PERIOD = 0,  /*!< Rising to rising edge time outside [min, max] */
+	EDGE_TRIG_WIDTH,       /*!< Rising to falling edge time outside [min, max] */
+	EDGE_TRIG_MISSING      /*!< Time between two edges above max (detected on the edge ending the gap) */
+}EDGE_TriggerType_t;
+
+/**
+ * @typedef EDGE_Trigger_t
+ * @brief Trigger condition of a circular edge capture.
+ */
+typedef struct
+{
+	EDGE_TriggerType_t type; /*!< Trigger condition */
+	u32 min;                 /*!< Lowest accepted time in timer ticks */
+	u32 max;                 /*!< Highest accepted time in timer ticks */
+} EDGE_Trigger_t;
+
+/**
+ * @typedef EDGE_Capture_t
+ * @brief Raw edge time stamps record of one timer input.
+ *        Both edges are captured on a single channel by toggling its polarity after
+ *        every capture, so recorded edges alternate between rising and falling.
+ */
+typedef struct
+{
+	volatile TIM_TypeDef *TIMx;   /*!< Capture timer (TIM1, TIM2, or TIM3) */
+	TIM_CH_t channel;             /*!< Capture channel */
+	u16 *times;                   /*!< Time stamps storage, provided by the user */
+	u16 size;                     /*!< Number of time stamps the storage can hold */
+
+	volatile u16 count;           /*!< Number of time stamps in the record (up to size) */
+	u16 head;                     /*!< Next storage index written */
+	u32 written;                  /*!< Edges written since the start, the first one being rising */
+	volatile EDGE_State_t state;  /*!< Capture state */
+	EDGE_Mode_t mode;             /*!< Capture mode */
+	TIM_IC_Edge_t nextEdge;       /*!< Polarity of the next edge to be captured */
+
+	EDGE_Trigger_t trigger;       /*!< Trigger condition (trigger mode only) */
+	u16 preTrigger;               /*!< Edges kept before the trigger edge */
+	u16 postRemaining;            /*!< Edges still to be recorded after the trigger */
+	volatile u8 triggered;        /*!< Trigger condition met */
+	u32 triggerWritten;           /*!< Value of written at the trigger edge */
+	u8 hasRising;                 /*!< A rising edge was recorded */
+	u16 lastRising;               /*!< Time stamp of the latest rising edge */
+	u16 lastEdge;                 /*!< Time stamp of the latest edge */
+} EDGE_Capture_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Initializes an edge capture record.
+ * @param  capture : Pointer to the edge capture.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Capture channel, already started with TIM_IC_Start.
+ * @param  times : Pointer to the time stamps storage.
+ * @param  size : Number of time stamps the storage can hold.
+ * @retval None
+ */
+void EDGE_Init(EDGE_Capture_t *capture, volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u16 *times, u16 size);
+
+/**
+ * @brief  Clears the record and starts recording from the next rising edge until the buffer is full.
+ * @param  capture : Pointer to the edge capture.
+ * @retval None
+ */
+void EDGE_Start(EDGE_Capture_t *capture);
+
+/**
+ * @brief  Clears the record and starts recording continuously in the circular buffer.
+ *         The trigger is evaluated once the pre-trigger edges are recorded. Once its
+ *         condition is met, recording goes on until the trigger edge sits at the requested
+ *         pre-trigger position, then the record is frozen.
+ * @param  capture : Pointer to the edge capture.
+ * @param  trigger : Pointer to the trigger condition.
+ * @param  preTriggerPercent : Share of the buffer kept before the trigger (0-100).
+ * @retval None
+ */
+void EDGE_StartTriggered(EDGE_Capture_t *capture, const EDGE_Trigger_t *trigger, u8 preTriggerPercent);
+
+/**
+ * @brief  Stores the captured edge and arms the opposite edge, to be called from the timer capture event callback.
+ * @note   Constant time per edge. The channel is set back to rising edge capture once the
+ *         record is complete.
+ * @param  capture : Pointer to the edge capture.
+ * @param  time : Capture of the channel passed with the event.
+ * @retval 1 if the record just became complete, 0 otherwise
+ */
+u8 EDGE_Capture(EDGE_Capture_t *capture, u16 time);
+
+/**
+ * @brief  Returns a time stamp of the record, the oldest one having index 0.
+ * @param  capture : Pointer to the edge capture.
+ * @param  index : Index of the edge in the record.
+ * @retval Time stamp in timer ticks
+ */
+u16 EDGE_GetTime(const EDGE_Capture_t *capture, u16 index);
+
+/**
+ * @brief  Returns whether the oldest edge of the record is a rising edge.
+ * @param  capture : Pointer to the edge capture.
+ * @retval 1 for a rising edge, 0 for a falling edge
+ */
+u8 EDGE_IsFirstRising(const EDGE_Capture_t *capture);
+
+/**
+ * @brief  Returns the index of the trigger edge in the record.
+ * @param  capture : Pointer to the edge capture.
+ * @retval Index of the trigger edge, or the record length if not triggered
+ */
+u16 EDGE_GetTriggerIndex(const EDGE_Capture_t *capture);
+
+/**
+ * @brief  Returns the time between the first recorded edge and a recorded edge.
+ * @note   Edges are assumed to be less than one counter period apart.
+ * @param  capture : Pointer to the edge capture.
+ * @param  index : Index of the edge in the record.
+ * @retval Elapsed time in timer ticks
+ */
+u32 EDGE_GetElapsed(const EDGE_Capture_t *capture, u16 index);
+
+#endif /* EDGE_EDGE_INTERFACE_H_ */
@@ -0,0 +1,305 @@
+/**
+ ******************************************************************************
+ * @file    EDGE_program.c
+ * @author  Salma Faragalla
+ * @brief   EDGE (raw edge time stamp capture) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "EDGE_interface.h"
+
+/* Private functions prototypes ----------------------------------------------*/
+/**
+ * @brief  Clears the record and arms the rising edge capture.
+ * @param  capture : Pointer to the edge capture.
+ * @param  mode : Capture mode.
+ * @retval None
+ */
+static void EDGE_Arm(EDGE_Capture_t *capture, EDGE_Mode_t mode);
+/**
+ * @brief  Evaluates the trigger condition on a new edge.
+ * @param  capture : Pointer to the edge capture.
+ * @param  time : Time stamp of the new edge.
+ * @param  isRising : 1 if the new edge is a rising edge.
+ * @retval 1 if the trigger condition is met, 0 otherwise
+ */
+static u8 EDGE_IsTrigger(EDGE_Capture_t *capture, u16 time, u8 isRising);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief  Clears the record and arms the rising edge capture.
+ * @param  capture : Pointer to the edge capture.
+ * @param  mode : Capture mode.
+ * @retval None
+ */
+static void EDGE_Arm(EDGE_Capture_t *capture, EDGE_Mode_t mode)
+{
+	capture->state = EDGE_IDLE;
+
+	capture->count = 0;
+	capture->head = 0;
+	capture->written = 0;
+	capture->mode = mode;
+	capture->triggered = 0;
+	capture->hasRising = 0;
+
+	capture->nextEdge = TIM_IC_RISING_EDGE;
+	TIM_IC_SetEdge(capture->TIMx, capture->channel, TIM_IC_RISING_EDGE);
+
+	// Discard a capture latched before the record was started
+	(void)TIM_IC_GetCapture(capture->TIMx, capture->channel);
+
+	capture->state = EDGE_ARMED;
+}
+
+/**
+ * @brief  Evaluates the trigger condition on a new edge.
+ * @param  capture : Pointer to the edge capture.
+ * @param  time : Time stamp of the new edge.
+ * @param  isRising : 1 if the new edge is a rising edge.
+ * @retval 1 if the trigger condition is met, 0 otherwise
+ */
+static u8 EDGE_IsTrigger(EDGE_Capture_t *capture, u16 time, u8 isRising)
+{
+	u32 elapsed;
+	u8 isTrigger = 0;
+
+	switch (capture->trigger.type)
+	{
+	case EDGE_TRIG_PERIOD:
+		if (isRising && capture->hasRising)
+		{
+			elapsed = (time - capture->lastRising) & TIM_MAX_PERIOD;
+			isTrigger = (elapsed < capture->trigger.min || elapsed > capture->trigger.max);
+		}
+		break;
+
+	case EDGE_TRIG_WIDTH:
+		if (!isRising && capture->hasRising)
+		{
+			elapsed = (time - capture->lastRising) & TIM_MAX_PERIOD;
+			isTrigger = (elapsed < capture->trigger.min || elapsed > capture->trigger.max);
+		}
+		break;
+
+	case EDGE_TRIG_MISSING:
+		if (capture->written > 1)
+		{
+			elapsed = (time - capture->lastEdge) & TIM_MAX_PERIOD;
+			isTrigger = (elapsed > capture->trigger.max);
+		}
+		break;
+	}
+
+	return isTrigger;
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Initializes an edge capture record.
+ * @param  capture : Pointer to the edge capture.
+ * @param  TIMx : Pointer to the timer peripheral (TIM1, TIM2, or TIM3).
+ * @param  TIM_CHx : Capture channel, already started with TIM_IC_Start.
+ * @param  times : Pointer to the time stamps storage.
+ * @param  size : Number of time stamps the storage can hold.
+ * @retval None
+ */
+void EDGE_Init(EDGE_Capture_t *capture, volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u16 *times, u16 size)
+{
+	capture->TIMx = TIMx;
+	capture->channel = TIM_CHx;
+	capture->times = times;
+	capture->size = size;
+	capture->count = 0;
+	capture->head = 0;
+	capture->written = 0;
+	capture->state = EDGE_IDLE;
+	capture->mode = EDGE_MODE_SINGLE;
+	capture->nextEdge = TIM_IC_RISING_EDGE;
+	capture->triggered = 0;
+}
+
+/**
+ * @brief  Clears the record and starts recording from the next rising edge until the buffer is full.
+ * @param  capture : Pointer to the edge capture.
+ * @retval None
+ */
+void EDGE_Start(EDGE_Capture_t *capture)
+{
+	EDGE_Arm(capture, EDGE_MODE_SINGLE);
+}
+
+/**
+ * @brief  Clears the record and starts recording continuously in the circular buffer.
+ *         The trigger is evaluated once the pre-trigger edges are recorded. Once its
+ *         condition is met, recording goes on until the trigger edge sits at the requested
+ *         pre-trigger position, then the record is frozen.
+ * @param  capture : Pointer to the edge capture.
+ * @param  trigger : Pointer to the trigger condition.
+ * @param  preTriggerPercent : Share of the buffer kept before the trigger (0-100).
+ * @retval None
+ */
+void EDGE_StartTriggered(EDGE_Capture_t *capture, const EDGE_Trigger_t *trigger, u8 preTriggerPercent)
+{
+	if (preTriggerPercent > 100)
+	{
+		preTriggerPercent = 100;
+	}
+
+	capture->trigger = *trigger;
+	capture->preTrigger = ((u32)(capture->size - 1) * preTriggerPercent) / 100;
+
+	EDGE_Arm(capture, EDGE_MODE_TRIGGER);
+}
+
+/**
+ * @brief  Stores the captured edge and arms the opposite edge, to be called from the timer capture event callback.
+ * @note   Constant time per edge. The channel is set back to rising edge capture once the
+ *         record is complete.
+ * @param  capture : Pointer to the edge capture.
+ * @param  time : Capture of the channel passed with the event.
+ * @retval 1 if the record just became complete, 0 otherwise
+ */
+u8 EDGE_Capture(EDGE_Capture_t *capture, u16 time)
+{
+	u8 isRising = (capture->nextEdge == TIM_IC_RISING_EDGE);
+	u8 isComplete = 0;
+
+	if (capture->state != EDGE_ARMED)
+	{
+		return 0;
+	}
+
+	// Arm the opposite edge first to keep the time until the next edge as short as possible
+	capture->nextEdge = isRising ? TIM_IC_FALLING_EDGE : TIM_IC_RISING_EDGE;
+	TIM_IC_SetEdge(capture->TIMx, capture->channel, capture->nextEdge);
+
+	// Store the time stamp, overwriting the oldest one once the buffer is full
+	capture->times[capture->head] = time;
+	capture->head++;
+	if (capture->head == capture->size)
+	{
+		capture->head = 0;
+	}
+	if (capture->count < capture->size)
+	{
+		capture->count++;
+	}
+	capture->written++;
+
+	if (capture->mode == EDGE_MODE_SINGLE)
+	{
+		isComplete = (capture->count == capture->size);
+	}
+	else if (capture->triggered)
+	{
+		capture->postRemaining--;
+		isComplete = (capture->postRemaining == 0);
+	}
+	else if (capture->written > capture->preTrigger && EDGE_IsTrigger(capture, time, isRising))
+	{
+		// Armed once the pre-trigger edges are recorded, so that the trigger edge sits at its
+		// configured position of a full record
+		capture->triggered = 1;
+		capture->triggerWritten = capture->written;
+		capture->postRemaining = capture->size - 1 - capture->preTrigger;
+		isComplete = (capture->postRemaining == 0);
+	}
+
+	// Keep the references used by the trigger evaluation
+	if (isRising)
+	{
+		capture->lastRising = time;
+		capture->hasRising = 1;
+	}
+	capture->lastEdge = time;
+
+	if (!isComplete)
+	{
+		return 0;
+	}
+
+	// Record complete: freeze it and restore the rising edge capture
+	TIM_IC_SetEdge(capture->TIMx, capture->channel, TIM_IC_RISING_EDGE);
+	capture->state = EDGE_DONE;
+
+	return 1;
+}
+
+/**
+ * @brief  Returns a time stamp of the record, the oldest one having index 0.
+ * @param  capture : Pointer to the edge capture.
+ * @param  index : Index of the edge in the record.
+ * @retval Time stamp in timer ticks
+ */
+u16 EDGE_GetTime(const EDGE_Capture_t *capture, u16 index)
+{
+	u32 position = (u32)capture->head + capture->size - capture->count + index;
+
+	if (position >= capture->size)
+	{
+		position -= capture->size;
+	}
+	if (position >= capture->size)
+	{
+		position -= capture->size;
+	}
+
+	return capture->times[position];
+}
+
+/**
+ * @brief  Returns whether the oldest edge of the record is a rising edge.
+ * @param  capture : Pointer to the edge capture.
+ * @retval 1 for a rising edge, 0 for a falling edge
+ */
+u8 EDGE_IsFirstRising(const EDGE_Capture_t *capture)
+{
+	// The first edge written is rising and edges alternate
+	return ((capture->written - capture->count) % 2) == 0;
+}
+
+/**
+ * @brief  Returns the index of the trigger edge in the record.
+ * @param  capture : Pointer to the edge capture.
+ * @retval Index of the trigger edge, or the record length if not triggered
+ */
+u16 EDGE_GetTriggerIndex(const EDGE_Capture_t *capture)
+{
+	if (!capture->triggered)
+	{
+		return capture->count;
+	}
+
+	// Edges written after the trigger edge are the newest of the record
+	return capture->count - 1 - (capture->written - capture->triggerWritten);
+}
+
+/**
+ * @brief  Returns the time between the first recorded edge and a recorded edge.
+ * @note   Edges are assumed to be less than one counter period apart.
+ * @param  capture : Pointer to the edge capture.
+ * @param  index : Index of the edge in the record.
+ * @retval Elapsed time in timer ticks
+ */
+u32 EDGE_GetElapsed(const EDGE_Capture_t *capture, u16 index)
+{
+	u32 elapsed = 0;
+	u16 previous, current;
+
+	if (capture->count == 0)
+	{
+		return 0;
+	}
+
+	// Accumulate the differences modulo the counter period to handle the counter overflow
+	previous = EDGE_GetTime(capture, 0);
+	for (u16 i = 1; i <= index && i < capture->count; i++)
+	{
+		current = EDGE_GetTime(capture, i);
+		elapsed += (current - previous) & TIM_MAX_PERIOD;
+		previous = current;
+	}
+
+	return elapsed;
+}
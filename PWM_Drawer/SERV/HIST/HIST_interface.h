@@ -0,0 +1,67 @@
+/**
+ ******************************************************************************
+ * @file    HIST_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of HIST (fixed-bin histogram) module.
+ ******************************************************************************
+ */
+#ifndef HIST_HIST_INTERFACE_H_
+#define HIST_HIST_INTERFACE_H_
+
+#include "STD_TYPES.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define HIST_BIN_MAX_COUNT (0xFFFFU)
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef HIST_t
+ * @brief Fixed-bin histogram accumulator.
+ *        Bins are kept as u16 and saturate at HIST_BIN_MAX_COUNT.
+ */
+typedef struct
+{
+	u16 *bins;      /*!< Bins storage, provided by the user (binCount elements) */
+	u16 binCount;   /*!< Number of bins */
+	u32 rangeMin;   /*!< Lowest value counted by the first bin */
+	u32 binWidth;   /*!< Width of a single bin (value units) */
+	u32 underflow;  /*!< Number of values below rangeMin */
+	u32 overflow;   /*!< Number of values above the last bin */
+	u32 total;      /*!< Number of values added since the last clear */
+} HIST_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Initializes a histogram over [rangeMin, rangeMin + binCount * binWidth) and clears it.
+ * @param  hist : Pointer to the histogram.
+ * @param  bins : Pointer to the bins storage (binCount elements).
+ * @param  binCount : Number of bins.
+ * @param  rangeMin : Lowest value counted by the first bin.
+ * @param  binWidth : Width of a single bin (must not be zero).
+ * @retval None
+ */
+void HIST_Init(HIST_t *hist, u16 *bins, u16 binCount, u32 rangeMin, u32 binWidth);
+
+/**
+ * @brief  Clears all bins and counters of a histogram.
+ * @param  hist : Pointer to the histogram.
+ * @retval None
+ */
+void HIST_Clear(HIST_t *hist);
+
+/**
+ * @brief  Adds one value to the histogram (single bin increment, safe to call from an ISR).
+ * @param  hist : Pointer to the histogram.
+ * @param  value : Value to be counted.
+ * @retval None
+ */
+void HIST_Add(HIST_t *hist, u32 value);
+
+/**
+ * @brief  Returns the count of the fullest bin.
+ * @param  hist : Pointer to the histogram.
+ * @retval Count of the fullest bin
+ */
+u16 HIST_GetPeak(const HIST_t *hist);
+
+#endif /* HIST_HIST_INTERFACE_H_ */
@@ -0,0 +1,96 @@
+/**
+ ******************************************************************************
+ * @file    HIST_program.c
+ * @author  Salma Faragalla
+ * @brief   HIST (fixed-bin histogram) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "HIST_interface.h"
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Initializes a histogram over [rangeMin, rangeMin + binCount * binWidth) and clears it.
+ * @param  hist : Pointer to the histogram.
+ * @param  bins : Pointer to the bins storage (binCount elements).
+ * @param  binCount : Number of bins.
+ * @param  rangeMin : Lowest value counted by the first bin.
+ * @param  binWidth : Width of a single bin (must not be zero).
+ * @retval None
+ */
+void HIST_Init(HIST_t *hist, u16 *bins, u16 binCount, u32 rangeMin, u32 binWidth)
+{
+	hist->bins = bins;
+	hist->binCount = binCount;
+	hist->rangeMin = rangeMin;
+	hist->binWidth = (binWidth == 0) ? 1 : binWidth; // Avoid division by zero
+
+	HIST_Clear(hist);
+}
+
+/**
+ * @brief  Clears all bins and counters of a histogram.
+ * @param  hist : Pointer to the histogram.
+ * @retval None
+ */
+void HIST_Clear(HIST_t *hist)
+{
+	for (u16 i = 0; i < hist->binCount; i++)
+	{
+		hist->bins[i] = 0;
+	}
+
+	hist->underflow = 0;
+	hist->overflow = 0;
+	hist->total = 0;
+}
+
+/**
+ * @brief  Adds one value to the histogram (single bin increment, safe to call from an ISR).
+ * @param  hist : Pointer to the histogram.
+ * @param  value : Value to be counted.
+ * @retval None
+ */
+void HIST_Add(HIST_t *hist, u32 value)
+{
+	u32 index;
+
+	hist->total++;
+
+	if (value < hist->rangeMin)
+	{
+		hist->underflow++;
+		return;
+	}
+
+	index = (value - hist->rangeMin) / hist->binWidth;
+
+	if (index >= hist->binCount)
+	{
+		hist->overflow++;
+	}
+	else if (hist->bins[index] != HIST_BIN_MAX_COUNT)
+	{
+		hist->bins[index]++; // Saturate instead of wrapping around
+	}
+}
+
+/**
+ * @brief  Returns the count of the fullest bin.
+ * @param  hist : Pointer to the histogram.
+ * @retval Count of the fullest bin
+ */
+u16 HIST_GetPeak(const HIST_t *hist)
+{
+	u16 peak = 0;
+
+	for (u16 i = 0; i < hist->binCount; i++)
+	{
+		if (hist->bins[i] > peak)
+		{
+			peak = hist->bins[i];
+		}
+	}
+
+	return peak;
+}
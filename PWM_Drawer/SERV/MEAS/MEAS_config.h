@@ -0,0 +1,15 @@
+/**
+ ******************************************************************************
+ * @file    MEAS_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for MEAS module.
+ ******************************************************************************
+ */
+#ifndef MEAS_MEAS_CONFIG_H_
+#define MEAS_MEAS_CONFIG_H_
+
+/* Ring buffer configurations -------------------------------------------------*/
+#define MEAS_RING_SIZE (16U)                 // Number of capture records per channel (power of 2)
+#define MEAS_RING_MASK (MEAS_RING_SIZE - 1U)
+
+#endif /* MEAS_MEAS_CONFIG_H_ */
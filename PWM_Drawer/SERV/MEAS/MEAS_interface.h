@@ -0,0 +1,132 @@
+/**
+ ******************************************************************************
+ * @file    MEAS_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of MEAS (PWM measurement channel) module.
+ ******************************************************************************
+ */
+#ifndef MEAS_MEAS_INTERFACE_H_
+#define MEAS_MEAS_INTERFACE_H_
+
+#include "STD_TYPES.h"
+#include "../../MCAL/TIM/TIM_interface.h"
+
+#include "MEAS_config.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define MEAS_DUTY_FULL (10000UL)   // Duty cycles are fixed-point in 0.01% units, 10000 being 100%
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef MEAS_Config_t
+ * @brief Timer and channel pair used by a measurement channel.
+ */
+typedef struct
+{
+	volatile TIM_TypeDef *TIMx; /*!< Capture timer (TIM1, TIM2, or TIM3) */
+	TIM_CH_t periodCh;          /*!< Channel capturing the rising edges, source of the capture interrupt */
+	TIM_CH_t dutyCh;            /*!< Channel capturing the falling edges */
+	u8 dutyCCS;                 /*!< Input of the duty channel from @defgroup CCS_DIRECTION (direct or indirect) */
+} MEAS_Config_t;
+
+/**
+ * @typedef MEAS_Record_t
+ * @brief One captured PWM period.
+ */
+typedef struct
+{
+	u32 periodTicks; /*!< Rising to rising edge time in timer ticks (averaged over the events per capture) */
+	u32 highTicks;   /*!< Rising to falling edge time in timer ticks (of the last period) */
+} MEAS_Record_t;
+
+/**
+ * @typedef MEAS_Channel_t
+ * @brief State of a measurement channel.
+ */
+typedef struct
+{
+	MEAS_Config_t config;                   /*!< Timer and channels used */
+	u32 tickRate;                           /*!< Counter clock of the timer in Hz */
+	u8 eventsPerCapture;                    /*!< Rising edges per period capture (input capture prescaler) */
+
+	u8 isFirstCapture;                      /*!< No previous rising edge captured yet */
+	u32 lastRisingEdge;                     /*!< Previous rising edge time stamp */
+
+	MEAS_Record_t ring[MEAS_RING_SIZE];     /*!< Records waiting to be read */
+	volatile u16 head;                      /*!< Next slot written by the ISR */
+	volatile u16 tail;                      /*!< Next slot read by MEAS_Read */
+	volatile u32 overruns;                  /*!< Records dropped because the ring was full */
+	volatile u32 lateFalls;                 /*!< Periods dropped because the falling edge was read after the next rising edge */
+
+	volatile u32 periodTicks;               /*!< Latest period in timer ticks */
+	volatile u32 highTicks;                 /*!< Latest high time in timer ticks */
+	volatile u32 captures;                  /*!< Number of periods measured */
+} MEAS_Channel_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Initializes a measurement channel state.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  config : Timer and channels to be used.
+ * @retval None
+ */
+void MEAS_Init(MEAS_Channel_t *channel, const MEAS_Config_t *config);
+
+/**
+ * @brief  Starts input capture on the timer channels of a measurement channel.
+ * @note   The timer clock must be enabled with TIM_Init and the capture event of the
+ *         period channel routed to MEAS_Capture by the user.
+ * @param  channel : Pointer to the measurement channel.
+ * @retval None
+ */
+void MEAS_Start(MEAS_Channel_t *channel);
+
+/**
+ * @brief  Sets the counter clock and input capture prescaler the channel timer runs with.
+ * @note   The prescalers are set on the timer by the user, the period measurement restarts.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  tickRate : Counter clock of the timer in Hz.
+ * @param  eventsPerCapture : Rising edges per capture of the period channel (1, 2, 4, or 8).
+ * @retval None
+ */
+void MEAS_SetTiming(MEAS_Channel_t *channel, u32 tickRate, u8 eventsPerCapture);
+
+/**
+ * @brief  Discards the previous rising edge, the next capture restarts the period measurement.
+ * @note   To be used after the channel capture was used by another module.
+ * @param  channel : Pointer to the measurement channel.
+ * @retval None
+ */
+void MEAS_Resync(MEAS_Channel_t *channel);
+
+/**
+ * @brief  Processes a rising edge capture, to be called from the timer capture event callback.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  risingEdge : Capture of the period channel passed with the event.
+ * @retval 1 if a new period record was produced, 0 otherwise
+ */
+u8 MEAS_Capture(MEAS_Channel_t *channel, u32 risingEdge);
+
+/**
+ * @brief  Reads the oldest record from the ring buffer of a channel.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  record : Pointer to the record to be filled.
+ * @retval 1 if a record was read, 0 if the ring buffer is empty
+ */
+u8 MEAS_Read(MEAS_Channel_t *channel, MEAS_Record_t *record);
+
+/**
+ * @brief  Returns the latest measured frequency of a channel.
+ * @param  channel : Pointer to the measurement channel.
+ * @retval Frequency in HZ (0 if nothing measured yet)
+ */
+f32 MEAS_GetFreq_HZ(const MEAS_Channel_t *channel);
+
+/**
+ * @brief  Returns the latest measured duty cycle of a channel.
+ * @param  channel : Pointer to the measurement channel.
+ * @retval Duty in 0.01% units (0 to MEAS_DUTY_FULL)
+ */
+u32 MEAS_GetDuty(const MEAS_Channel_t *channel);
+
+#endif /* MEAS_MEAS_INTERFACE_H_ */
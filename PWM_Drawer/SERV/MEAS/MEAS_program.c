@@ -0,0 +1,195 @@
+/**
+ ******************************************************************************
+ * @file    MEAS_program.c
+ * @author  Salma Faragalla
+ * @brief   MEAS (PWM measurement channel) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "MEAS_interface.h"
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Initializes a measurement channel state.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  config : Timer and channels to be used.
+ * @retval None
+ */
+void MEAS_Init(MEAS_Channel_t *channel, const MEAS_Config_t *config)
+{
+	channel->config = *config;
+	channel->tickRate = TIM_CLK;
+	channel->eventsPerCapture = 1;
+
+	channel->isFirstCapture = 1;
+	channel->lastRisingEdge = 0;
+
+	channel->head = 0;
+	channel->tail = 0;
+	channel->overruns = 0;
+	channel->lateFalls = 0;
+
+	channel->periodTicks = 0;
+	channel->highTicks = 0;
+	channel->captures = 0;
+}
+
+/**
+ * @brief  Starts input capture on the timer channels of a measurement channel.
+ * @note   The timer clock must be enabled with TIM_Init and the capture event of the
+ *         period channel routed to MEAS_Capture by the user.
+ * @param  channel : Pointer to the measurement channel.
+ * @retval None
+ */
+void MEAS_Start(MEAS_Channel_t *channel)
+{
+	// Rising edges generate the interrupt, falling edges are only latched
+	TIM_IC_Start(channel->config.TIMx, channel->config.periodCh, CCS_IP_DIRECT, TIM_IC_RISING_EDGE, TIM_INT_ENABLE);
+	TIM_IC_Start(channel->config.TIMx, channel->config.dutyCh, channel->config.dutyCCS, TIM_IC_FALLING_EDGE, TIM_INT_DISABLE);
+}
+
+/**
+ * @brief  Sets the counter clock and input capture prescaler the channel timer runs with.
+ * @note   The prescalers are set on the timer by the user, the period measurement restarts.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  tickRate : Counter clock of the timer in Hz.
+ * @param  eventsPerCapture : Rising edges per capture of the period channel (1, 2, 4, or 8).
+ * @retval None
+ */
+void MEAS_SetTiming(MEAS_Channel_t *channel, u32 tickRate, u8 eventsPerCapture)
+{
+	channel->tickRate = tickRate;
+	channel->eventsPerCapture = (eventsPerCapture == 0) ? 1 : eventsPerCapture;
+	channel->isFirstCapture = 1;
+}
+
+/**
+ * @brief  Discards the previous rising edge, the next capture restarts the period measurement.
+ * @note   To be used after the channel capture was used by another module.
+ * @param  channel : Pointer to the measurement channel.
+ * @retval None
+ */
+void MEAS_Resync(MEAS_Channel_t *channel)
+{
+	channel->isFirstCapture = 1;
+}
+
+/**
+ * @brief  Processes a rising edge capture, to be called from the timer capture event callback.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  risingEdge : Capture of the period channel passed with the event.
+ * @retval 1 if a new period record was produced, 0 otherwise
+ */
+u8 MEAS_Capture(MEAS_Channel_t *channel, u32 risingEdge)
+{
+	// The falling edge channel only latches, its capture is read here
+	u32 fallingEdge = TIM_IC_GetCapture(channel->config.TIMx, channel->config.dutyCh);
+	u32 spanTicks, fallOffset, periodTicks, highTicks;
+	u16 nextHead;
+
+	// The first rising edge only gives the reference time stamp
+	if (channel->isFirstCapture)
+	{
+		channel->lastRisingEdge = risingEdge;
+		channel->isFirstCapture = 0;
+		return 0;
+	}
+
+	// Differences modulo the counter period handle the counter overflow; with a capture
+	// prescaler the rising edges are several periods apart while the falling edge channel
+	// still latches every falling edge, the last one being in the last period
+	spanTicks = (risingEdge - channel->lastRisingEdge) & TIM_MAX_PERIOD;
+	fallOffset = (fallingEdge - channel->lastRisingEdge) & TIM_MAX_PERIOD;
+	periodTicks = spanTicks / channel->eventsPerCapture;
+	channel->lastRisingEdge = risingEdge;
+
+	// Ignore insignificant periods
+	if (periodTicks <= 1)
+	{
+		return 0;
+	}
+
+	// The falling edge is read late, after the callbacks served before this one: if the
+	// next falling edge was already latched it is outside the last period, and the high
+	// time would exceed the period
+	if (fallOffset > spanTicks || fallOffset < (channel->eventsPerCapture - 1) * periodTicks)
+	{
+		channel->lateFalls++;
+		return 0;
+	}
+	highTicks = fallOffset - (channel->eventsPerCapture - 1) * periodTicks;
+
+	channel->periodTicks = periodTicks;
+	channel->highTicks = highTicks;
+	channel->captures++;
+
+	// Push the record, dropping it if the reader is too slow
+	nextHead = (channel->head + 1) & MEAS_RING_MASK;
+	if (nextHead == channel->tail)
+	{
+		channel->overruns++;
+	}
+	else
+	{
+		channel->ring[channel->head].periodTicks = periodTicks;
+		channel->ring[channel->head].highTicks = highTicks;
+		channel->head = nextHead;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief  Reads the oldest record from the ring buffer of a channel.
+ * @param  channel : Pointer to the measurement channel.
+ * @param  record : Pointer to the record to be filled.
+ * @retval 1 if a record was read, 0 if the ring buffer is empty
+ */
+u8 MEAS_Read(MEAS_Channel_t *channel, MEAS_Record_t *record)
+{
+	if (channel->tail == channel->head)
+	{
+		return 0;
+	}
+
+	*record = channel->ring[channel->tail];
+	channel->tail = (channel->tail + 1) & MEAS_RING_MASK;
+
+	return 1;
+}
+
+/**
+ * @brief  Returns the latest measured frequency of a channel.
+ * @param  channel : Pointer to the measurement channel.
+ * @retval Frequency in HZ (0 if nothing measured yet)
+ */
+f32 MEAS_GetFreq_HZ(const MEAS_Channel_t *channel)
+{
+	u32 periodTicks = channel->periodTicks;
+
+	if (periodTicks == 0)
+	{
+		return 0;
+	}
+
+	return (f32)channel->tickRate / (f32)periodTicks;
+}
+
+/**
+ * @brief  Returns the latest measured duty cycle of a channel.
+ * @param  channel : Pointer to the measurement channel.
+ * @retval Duty in 0.01% units (0 to MEAS_DUTY_FULL)
+ */
+u32 MEAS_GetDuty(const MEAS_Channel_t *channel)
+{
+	u32 periodTicks = channel->periodTicks;
+	u32 highTicks = channel->highTicks;
+
+	if (periodTicks == 0 || highTicks > periodTicks)
+	{
+		return 0;
+	}
+
+	// Rounded to the nearest unit, a 16-bit high time times MEAS_DUTY_FULL fits 32 bits
+	return (highTicks * MEAS_DUTY_FULL + periodTicks / 2) / periodTicks;
+}
@@ -0,0 +1,78 @@
+/**
+ ******************************************************************************
+ * @file    PHASE_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of PHASE (two-input phase and delay) module.
+ ******************************************************************************
+ */
+#ifndef PHASE_PHASE_INTERFACE_H_
+#define PHASE_PHASE_INTERFACE_H_
+
+#include "STD_TYPES.h"
+#include "../../MCAL/TIM/TIM_interface.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef PHASE_t
+ * @brief State of a phase/delay measurement between a reference input A and an input B.
+ *        Both inputs must be captured on the same timer so their time stamps share one counter.
+ */
+typedef struct
+{
+	u32 tickRate;               /*!< Counter clock of the timer in Hz */
+	u8 eventsPerEdgeA;          /*!< Periods of input A between two processed edges (capture prescaler) */
+	u8 hasEdgeA;                /*!< A rising edge of input A was captured */
+	u32 lastEdgeA;              /*!< Time stamp of the latest rising edge of input A */
+	volatile u32 periodTicks;   /*!< Period of input A in timer ticks */
+	volatile u32 delayTicks;    /*!< Rising edge of A to rising edge of B in timer ticks (0 to period - 1) */
+	volatile u32 measurements;  /*!< Number of delays measured */
+} PHASE_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Initializes a phase/delay measurement.
+ * @param  phase : Pointer to the phase measurement.
+ * @retval None
+ */
+void PHASE_Init(PHASE_t *phase);
+
+/**
+ * @brief  Sets the counter clock and the input A capture prescaler of the shared timer.
+ * @param  phase : Pointer to the phase measurement.
+ * @param  tickRate : Counter clock of the timer in Hz.
+ * @param  eventsPerEdgeA : Periods of input A between two processed edges (1, 2, 4, or 8).
+ * @retval None
+ */
+void PHASE_SetTiming(PHASE_t *phase, u32 tickRate, u8 eventsPerEdgeA);
+
+/**
+ * @brief  Processes a rising edge of the reference input A, to be called from the timer interrupt.
+ * @param  phase : Pointer to the phase measurement.
+ * @param  timeStamp : Captured counter value of the edge.
+ * @retval None
+ */
+void PHASE_EdgeA(PHASE_t *phase, u32 timeStamp);
+
+/**
+ * @brief  Processes a rising edge of input B, to be called from the timer interrupt.
+ * @param  phase : Pointer to the phase measurement.
+ * @param  timeStamp : Captured counter value of the edge.
+ * @retval None
+ */
+void PHASE_EdgeB(PHASE_t *phase, u32 timeStamp);
+
+/**
+ * @brief  Returns the latest rising-to-rising delay from input A to input B.
+ * @param  phase : Pointer to the phase measurement.
+ * @retval Delay in us
+ */
+f32 PHASE_GetDelay_us(const PHASE_t *phase);
+
+/**
+ * @brief  Returns the latest phase of input B relative to input A.
+ * @param  phase : Pointer to the phase measurement.
+ * @retval Phase in degrees (0-360)
+ */
+f32 PHASE_GetPhase_deg(const PHASE_t *phase);
+
+#endif /* PHASE_PHASE_INTERFACE_H_ */
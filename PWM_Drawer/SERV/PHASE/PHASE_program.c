@@ -0,0 +1,123 @@
+/**
+ ******************************************************************************
+ * @file    PHASE_program.c
+ * @author  Salma Faragalla
+ * @brief   PHASE (two-input phase and delay) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "PHASE_interface.h"
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Initializes a phase/delay measurement.
+ * @param  phase : Pointer to the phase measurement.
+ * @retval None
+ */
+void PHASE_Init(PHASE_t *phase)
+{
+	phase->tickRate = TIM_CLK;
+	phase->eventsPerEdgeA = 1;
+	phase->hasEdgeA = 0;
+	phase->lastEdgeA = 0;
+	phase->periodTicks = 0;
+	phase->delayTicks = 0;
+	phase->measurements = 0;
+}
+
+/**
+ * @brief  Sets the counter clock and the input A capture prescaler of the shared timer.
+ * @param  phase : Pointer to the phase measurement.
+ * @param  tickRate : Counter clock of the timer in Hz.
+ * @param  eventsPerEdgeA : Periods of input A between two processed edges (1, 2, 4, or 8).
+ * @retval None
+ */
+void PHASE_SetTiming(PHASE_t *phase, u32 tickRate, u8 eventsPerEdgeA)
+{
+	phase->tickRate = tickRate;
+	phase->eventsPerEdgeA = (eventsPerEdgeA == 0) ? 1 : eventsPerEdgeA;
+	phase->hasEdgeA = 0;
+	phase->periodTicks = 0;
+}
+
+/**
+ * @brief  Processes a rising edge of the reference input A, to be called from the timer interrupt.
+ * @param  phase : Pointer to the phase measurement.
+ * @param  timeStamp : Captured counter value of the edge.
+ * @retval None
+ */
+void PHASE_EdgeA(PHASE_t *phase, u32 timeStamp)
+{
+	if (phase->hasEdgeA)
+	{
+		// Difference modulo the counter period handles the counter overflow
+		phase->periodTicks = ((timeStamp - phase->lastEdgeA) & TIM_MAX_PERIOD) / phase->eventsPerEdgeA;
+	}
+
+	phase->lastEdgeA = timeStamp;
+	phase->hasEdgeA = 1;
+}
+
+/**
+ * @brief  Processes a rising edge of input B, to be called from the timer interrupt.
+ * @param  phase : Pointer to the phase measurement.
+ * @param  timeStamp : Captured counter value of the edge.
+ * @retval None
+ */
+void PHASE_EdgeB(PHASE_t *phase, u32 timeStamp)
+{
+	u32 periodTicks = phase->periodTicks;
+	u32 raw;
+	u32 delay;
+
+	// The period of A is needed to bring the delay back into one cycle
+	if (periodTicks == 0)
+	{
+		return;
+	}
+
+	// Difference modulo the counter period, B may also have been stamped just before the
+	// edge of A processed first. Below one period the edge of B is taken as after A, so
+	// periods above half the counter range are not folded as negative delays.
+	raw = (timeStamp - phase->lastEdgeA) & TIM_MAX_PERIOD;
+
+	if (raw >= periodTicks && raw > TIM_MAX_PERIOD - periodTicks)
+	{
+		// B before A by (TIM_MAX_PERIOD + 1 - raw) ticks, 1 to periodTicks
+		delay = (periodTicks - (TIM_MAX_PERIOD + 1UL - raw)) % periodTicks;
+	}
+	else
+	{
+		delay = raw % periodTicks;
+	}
+
+	phase->delayTicks = delay;
+	phase->measurements++;
+}
+
+/**
+ * @brief  Returns the latest rising-to-rising delay from input A to input B.
+ * @param  phase : Pointer to the phase measurement.
+ * @retval Delay in us
+ */
+f32 PHASE_GetDelay_us(const PHASE_t *phase)
+{
+	return ((f32)phase->delayTicks * 1000000.0f) / (f32)phase->tickRate;
+}
+
+/**
+ * @brief  Returns the latest phase of input B relative to input A.
+ * @param  phase : Pointer to the phase measurement.
+ * @retval Phase in degrees (0-360)
+ */
+f32 PHASE_GetPhase_deg(const PHASE_t *phase)
+{
+	u32 periodTicks = phase->periodTicks;
+
+	if (periodTicks == 0)
+	{
+		return 0;
+	}
+
+	return ((f32)phase->delayTicks * 360.0f) / (f32)periodTicks;
+}
@@ -0,0 +1,14 @@
+/**
+ ******************************************************************************
+ * @file    SCHED_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for SCHED module.
+ ******************************************************************************
+ */
+#ifndef SCHED_SCHED_CONFIG_H_
+#define SCHED_SCHED_CONFIG_H_
+
+/* Task table configurations ---------------------------------------------------*/
+#define SCHED_MAX_TASKS (6U)   // Tasks a scheduler holds, each one takes 20 bytes
+
+#endif /* SCHED_SCHED_CONFIG_H_ */
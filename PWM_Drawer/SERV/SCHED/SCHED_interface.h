@@ -0,0 +1,94 @@
+/**
+ ******************************************************************************
+ * @file    SCHED_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of SCHED (cooperative periodic task scheduler) module.
+ ******************************************************************************
+ */
+#ifndef SCHED_SCHED_INTERFACE_H_
+#define SCHED_SCHED_INTERFACE_H_
+
+#include "STD_TYPES.h"
+
+#include "SCHED_config.h"
+
+/* Exported defines ----------------------------------------------------------*/
+#define SCHED_INVALID_TASK (0xFFU)
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef SCHED_Task_t
+ * @brief Periodic task. Its deadline is the start of its next period: a task that
+ *        could not start before it misses the deadline and its late runs are dropped.
+ */
+typedef struct
+{
+	void (*function)(void);   /*!< Task body, runs to completion */
+	u32 period_ms;            /*!< Time between two runs */
+	u32 due_ms;               /*!< Time of the next run */
+	u32 runs;                 /*!< Runs since the task was added */
+	u32 misses;               /*!< Deadlines missed since the task was added */
+} SCHED_Task_t;
+
+/**
+ * @typedef SCHED_t
+ * @brief Cooperative scheduler, the tasks run from the main loop in the order they were added.
+ */
+typedef struct
+{
+	SCHED_Task_t tasks[SCHED_MAX_TASKS];
+	u8 count;                 /*!< Number of tasks added */
+} SCHED_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Initializes a scheduler without tasks.
+ * @param  sched : Pointer to the scheduler.
+ * @retval None
+ */
+void SCHED_Init(SCHED_t *sched);
+
+/**
+ * @brief  Adds a periodic task.
+ * @param  sched : Pointer to the scheduler.
+ * @param  function : Task body.
+ * @param  period_ms : Time between two runs (1 ms or more).
+ * @param  firstRun_ms : Time of the first run, to spread tasks of the same period.
+ * @retval Task index, SCHED_INVALID_TASK if the table is full
+ */
+u8 SCHED_AddTask(SCHED_t *sched, void (*function)(void), u32 period_ms, u32 firstRun_ms);
+
+/**
+ * @brief  Changes the period of a task, taking effect after its next run.
+ * @param  sched : Pointer to the scheduler.
+ * @param  task : Task index returned by SCHED_AddTask.
+ * @param  period_ms : Time between two runs (1 ms or more).
+ * @retval None
+ */
+void SCHED_SetPeriod(SCHED_t *sched, u8 task, u32 period_ms);
+
+/**
+ * @brief  Runs the tasks that are due, each one at most once, to be called from the main loop.
+ * @param  sched : Pointer to the scheduler.
+ * @param  now_ms : Current time.
+ * @retval Number of tasks run
+ */
+u8 SCHED_Dispatch(SCHED_t *sched, u32 now_ms);
+
+/**
+ * @brief  Returns the time left until the next task is due.
+ * @param  sched : Pointer to the scheduler.
+ * @param  now_ms : Current time.
+ * @retval Time in ms, 0 if a task is due, 0xFFFFFFFF without tasks
+ */
+u32 SCHED_GetIdleTime(const SCHED_t *sched, u32 now_ms);
+
+/**
+ * @brief  Returns a task of the scheduler, to read its run and miss counters.
+ * @param  sched : Pointer to the scheduler.
+ * @param  task : Task index returned by SCHED_AddTask.
+ * @retval Pointer to the task, 0 if the index is invalid
+ */
+const SCHED_Task_t* SCHED_GetTask(const SCHED_t *sched, u8 task);
+
+#endif /* SCHED_SCHED_INTERFACE_H_ */
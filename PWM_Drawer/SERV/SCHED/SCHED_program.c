@@ -0,0 +1,143 @@
+/**
+ ******************************************************************************
+ * @file    SCHED_program.c
+ * @author  Salma Faragalla
+ * @brief   SCHED (cooperative periodic task scheduler) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "SCHED_interface.h"
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Initializes a scheduler without tasks.
+ * @param  sched : Pointer to the scheduler.
+ * @retval None
+ */
+void SCHED_Init(SCHED_t *sched)
+{
+	sched->count = 0;
+}
+
+/**
+ * @brief  Adds a periodic task.
+ * @param  sched : Pointer to the scheduler.
+ * @param  function : Task body.
+ * @param  period_ms : Time between two runs (1 ms or more).
+ * @param  firstRun_ms : Time of the first run, to spread tasks of the same period.
+ * @retval Task index, SCHED_INVALID_TASK if the table is full
+ */
+u8 SCHED_AddTask(SCHED_t *sched, void (*function)(void), u32 period_ms, u32 firstRun_ms)
+{
+	SCHED_Task_t *task;
+
+	if (sched->count >= SCHED_MAX_TASKS || function == 0)
+	{
+		return SCHED_INVALID_TASK;
+	}
+
+	task = &sched->tasks[sched->count];
+	task->function = function;
+	task->period_ms = (period_ms == 0) ? 1 : period_ms;
+	task->due_ms = firstRun_ms;
+	task->runs = 0;
+	task->misses = 0;
+
+	return sched->count++;
+}
+
+/**
+ * @brief  Changes the period of a task, taking effect after its next run.
+ * @param  sched : Pointer to the scheduler.
+ * @param  task : Task index returned by SCHED_AddTask.
+ * @param  period_ms : Time between two runs (1 ms or more).
+ * @retval None
+ */
+void SCHED_SetPeriod(SCHED_t *sched, u8 task, u32 period_ms)
+{
+	if (task < sched->count)
+	{
+		sched->tasks[task].period_ms = (period_ms == 0) ? 1 : period_ms;
+	}
+}
+
+/**
+ * @brief  Runs the tasks that are due, each one at most once, to be called from the main loop.
+ * @param  sched : Pointer to the scheduler.
+ * @param  now_ms : Current time.
+ * @retval Number of tasks run
+ */
+u8 SCHED_Dispatch(SCHED_t *sched, u32 now_ms)
+{
+	SCHED_Task_t *task;
+	u8 ran = 0;
+
+	for (u8 i = 0; i < sched->count; i++)
+	{
+		task = &sched->tasks[i];
+
+		// Differences handle the wrap of the time
+		if ((s32)(now_ms - task->due_ms) < 0)
+		{
+			continue;
+		}
+
+		task->function();
+		task->runs++;
+		ran++;
+
+		// Periods keep their phase; a start later than the deadline drops the late runs
+		// instead of running them back to back
+		task->due_ms += task->period_ms;
+		if ((s32)(now_ms - task->due_ms) >= 0)
+		{
+			task->misses++;
+			task->due_ms = now_ms + task->period_ms;
+		}
+	}
+
+	return ran;
+}
+
+/**
+ * @brief  Returns the time left until the next task is due.
+ * @param  sched : Pointer to the scheduler.
+ * @param  now_ms : Current time.
+ * @retval Time in ms, 0 if a task is due, 0xFFFFFFFF without tasks
+ */
+u32 SCHED_GetIdleTime(const SCHED_t *sched, u32 now_ms)
+{
+	u32 idle = 0xFFFFFFFFUL;
+	s32 left;
+
+	for (u8 i = 0; i < sched->count; i++)
+	{
+		left = (s32)(sched->tasks[i].due_ms - now_ms);
+		if (left <= 0)
+		{
+			return 0;
+		}
+		if ((u32)left < idle)
+		{
+			idle = (u32)left;
+		}
+	}
+
+	return idle;
+}
+
+/**
+ * @brief  Returns a task of the scheduler, to read its run and miss counters.
+ * @param  sched : Pointer to the scheduler.
+ * @param  task : Task index returned by SCHED_AddTask.
+ * @retval Pointer to the task, 0 if the index is invalid
+ */
+const SCHED_Task_t* SCHED_GetTask(const SCHED_t *sched, u8 task)
+{
+	if (task >= sched->count)
+	{
+		return 0;
+	}
+
+	return &sched->tasks[task];
+}
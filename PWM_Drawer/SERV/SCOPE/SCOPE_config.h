@@ -0,0 +1,31 @@
+/**
+ ******************************************************************************
+ * @file    SCOPE_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for SCOPE module.
+ ******************************************************************************
+ */
+#ifndef SCOPE_SCOPE_CONFIG_H_
+#define SCOPE_SCOPE_CONFIG_H_
+
+/* ADC configurations ----------------------------------------------------------*/
+#define SCOPE_ADCx       (ADC1)
+#define SCOPE_ADC_CH     (ADC_CH1)             // Analog input on PA1
+#define SCOPE_ADC_SMP    (ADC_SMP_13_5)        // 13.5 + 12.5 cycles of the 12 MHz ADC clock (RCC_ADC_HZ) per conversion
+#define SCOPE_ADC_EXTSEL (ADC_EXTSEL_TIM1_CC1) // Conversions started by the trigger timer channel
+
+/* Trigger timer configurations ------------------------------------------------*/
+#define SCOPE_TRIG_TIMx (TIM1)
+#define SCOPE_TRIG_CHx  (TIM_CH1)              // Compare events only, PA8 is not driven
+
+/* DMA configurations ----------------------------------------------------------*/
+#define SCOPE_DMA_CH (DMA_CH1)                 // ADC1 requests are served by DMA1 channel 1
+
+/* Acquisition configurations --------------------------------------------------*/
+#define SCOPE_FRAME_SIZE  (512U)               // Samples per half of the double buffer, 4 per display column
+#define SCOPE_RATE_MIN_HZ (1UL)
+#define SCOPE_RATE_MAX_HZ (100000UL)           // Below the 461 kHz conversion rate of the ADC, bounded by the DMA interrupt load
+#define SCOPE_VREF_MV     (3300UL)             // Voltage of the full scale sample
+#define SCOPE_READ_RETRIES (3U)                // Copies of a frame overwritten by the DMA before giving up
+
+#endif /* SCOPE_SCOPE_CONFIG_H_ */
@@ -0,0 +1,87 @@
+/**
+ ******************************************************************************
+ * @file    SCOPE_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of SCOPE (analog sampling) module.
+ ******************************************************************************
+ */
+#ifndef SCOPE_SCOPE_INTERFACE_H_
+#define SCOPE_SCOPE_INTERFACE_H_
+
+#include "STD_TYPES.h"
+#include "../../MCAL/ADC/ADC_interface.h"
+#include "../../MCAL/DMA/DMA_interface.h"
+#include "../../MCAL/TIM/TIM_interface.h"
+#include "../DECIM/DECIM_interface.h"
+
+#include "SCOPE_config.h"
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Starts the analog acquisition: the trigger timer starts the ADC conversions
+ *         and the DMA moves them into a circular double buffer of two frames.
+ * @note   The trigger timer is reprogrammed, it can't be used for input capture meanwhile.
+ * @param  sampleRate : Requested sample rate in Hz (SCOPE_RATE_MIN_HZ to SCOPE_RATE_MAX_HZ).
+ * @retval Achieved sample rate in Hz
+ */
+u32 SCOPE_Start(u32 sampleRate);
+
+/**
+ * @brief  Stops the analog acquisition.
+ * @param  None
+ * @retval None
+ */
+void SCOPE_Stop(void);
+
+/**
+ * @brief  Checks whether the acquisition is running.
+ * @param  None
+ * @retval 1 if running, 0 otherwise
+ */
+u8 SCOPE_IsRunning(void);
+
+/**
+ * @brief  Returns the achieved sample rate of the acquisition.
+ * @param  None
+ * @retval Sample rate in Hz
+ */
+u32 SCOPE_GetSampleRate(void);
+
+/**
+ * @brief  Copies the last complete frame, while the DMA is filling the other half of the buffer.
+ * @param  frame : Destination of SCOPE_FRAME_SIZE samples.
+ * @retval 1 if a new frame was copied since the last call, 0 otherwise
+ */
+u8 SCOPE_ReadFrame(u16 *frame);
+
+/**
+ * @brief  Converts a sample to millivolts.
+ * @param  sample : ADC sample (0-4095).
+ * @retval Voltage in mV
+ */
+u32 SCOPE_ToMillivolts(u16 sample);
+
+/**
+ * @brief  Decimates the last complete frame to min/max columns, reading it in place
+ *         while the DMA is filling the other half of the buffer.
+ * @param  decim : Pointer to the decimator receiving the frame.
+ * @retval 1 if a new frame was decimated since the last call, 0 otherwise
+ */
+u8 SCOPE_DecimateFrame(DECIM_t *decim);
+
+/* Callback functions --------------------------------------------------------*/
+/**
+ * @brief  Half transfer callback: the first frame of the buffer is complete.
+ * @param  None
+ * @retval None
+ */
+void SCOPE_HalfCallback(void);
+
+/**
+ * @brief  Transfer complete callback: the second frame of the buffer is complete.
+ * @param  None
+ * @retval None
+ */
+void SCOPE_CompleteCallback(void);
+
+#endif /* SCOPE_SCOPE_INTERFACE_H_ */
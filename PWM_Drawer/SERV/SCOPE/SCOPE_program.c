@@ -0,0 +1,211 @@
+/**
+ ******************************************************************************
+ * @file    SCOPE_program.c
+ * @author  Salma Faragalla
+ * @brief   SCOPE (analog sampling) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "SCOPE_interface.h"
+
+/* Private variables ---------------------------------------------------------*/
+static u16 buffer[2U * SCOPE_FRAME_SIZE];  // Double buffer, the DMA fills one frame while the other is read
+
+static const DMA_Config_t dmaConfig = {
+	DMA_PERIPH_TO_MEM, DMA_MODE_CIRCULAR, DMA_SIZE_16BIT, DMA_SIZE_16BIT, 0, 1, DMA_PRIORITY_HIGH
+};
+
+static volatile u8 readyFrame;   // Index of the last complete frame
+static volatile u32 frames;      // Completed frames, written by the DMA callbacks
+static u32 readFrames;           // Completed frames already returned by SCOPE_ReadFrame
+static u32 sampleRateHz;
+static u8 running;
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Starts the analog acquisition: the trigger timer starts the ADC conversions
+ *         and the DMA moves them into a circular double buffer of two frames.
+ * @note   The trigger timer is reprogrammed, it can't be used for input capture meanwhile.
+ * @param  sampleRate : Requested sample rate in Hz (SCOPE_RATE_MIN_HZ to SCOPE_RATE_MAX_HZ).
+ * @retval Achieved sample rate in Hz
+ */
+u32 SCOPE_Start(u32 sampleRate)
+{
+	if (sampleRate < SCOPE_RATE_MIN_HZ)
+	{
+		sampleRate = SCOPE_RATE_MIN_HZ;
+	}
+	else if (sampleRate > SCOPE_RATE_MAX_HZ)
+	{
+		sampleRate = SCOPE_RATE_MAX_HZ;
+	}
+
+	if (running)
+	{
+		SCOPE_Stop();
+	}
+
+	readyFrame = 0;
+	frames = 0;
+	readFrames = 0;
+
+	// DMA first, so that no conversion is lost
+	DMA_Init();
+	DMA_SetHalfCallback(SCOPE_DMA_CH, SCOPE_HalfCallback);
+	DMA_SetCompleteCallback(SCOPE_DMA_CH, SCOPE_CompleteCallback);
+	DMA_Start(SCOPE_DMA_CH, &dmaConfig, ADC_GetDataAddress(SCOPE_ADCx), buffer, 2U * SCOPE_FRAME_SIZE);
+
+	ADC_Init(SCOPE_ADCx);
+	ADC_StartTriggered(SCOPE_ADCx, SCOPE_ADC_CH, SCOPE_ADC_SMP, SCOPE_ADC_EXTSEL);
+
+	TIM_Init(SCOPE_TRIG_TIMx);
+	sampleRateHz = TIM_OC_Trigger_Start(SCOPE_TRIG_TIMx, SCOPE_TRIG_CHx, sampleRate);
+
+	running = 1;
+
+	return sampleRateHz;
+}
+
+/**
+ * @brief  Stops the analog acquisition.
+ * @param  None
+ * @retval None
+ */
+void SCOPE_Stop(void)
+{
+	// The trigger timer is left stopped and its channel disabled for its next user
+	TIM_OC_Trigger_Stop(SCOPE_TRIG_TIMx, SCOPE_TRIG_CHx);
+	ADC_Stop(SCOPE_ADCx);
+	DMA_Stop(SCOPE_DMA_CH);
+
+	running = 0;
+}
+
+/**
+ * @brief  Checks whether the acquisition is running.
+ * @param  None
+ * @retval 1 if running, 0 otherwise
+ */
+u8 SCOPE_IsRunning(void)
+{
+	return running;
+}
+
+/**
+ * @brief  Returns the achieved sample rate of the acquisition.
+ * @param  None
+ * @retval Sample rate in Hz
+ */
+u32 SCOPE_GetSampleRate(void)
+{
+	return sampleRateHz;
+}
+
+/**
+ * @brief  Copies the last complete frame, while the DMA is filling the other half of the buffer.
+ * @param  frame : Destination of SCOPE_FRAME_SIZE samples.
+ * @retval 1 if a new frame was copied since the last call, 0 otherwise
+ */
+u8 SCOPE_ReadFrame(u16 *frame)
+{
+	u32 count;
+	u16 i;
+	u8 retries;
+	const u16 *source;
+
+	for (retries = 0; retries < SCOPE_READ_RETRIES; retries++)
+	{
+		count = frames;
+		if (count == readFrames)
+		{
+			return 0;
+		}
+
+		source = &buffer[readyFrame * SCOPE_FRAME_SIZE];
+		for (i = 0; i < SCOPE_FRAME_SIZE; i++)
+		{
+			frame[i] = source[i];
+		}
+
+		// The copy is valid if the DMA did not complete another frame meanwhile
+		if (count == frames)
+		{
+			readFrames = count;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Decimates the last complete frame to min/max columns, reading it in place
+ *         while the DMA is filling the other half of the buffer.
+ * @param  decim : Pointer to the decimator receiving the frame.
+ * @retval 1 if a new frame was decimated since the last call, 0 otherwise
+ */
+u8 SCOPE_DecimateFrame(DECIM_t *decim)
+{
+	u32 count;
+	u16 i;
+	u8 retries;
+	const u16 *source;
+
+	for (retries = 0; retries < SCOPE_READ_RETRIES; retries++)
+	{
+		count = frames;
+		if (count == readFrames)
+		{
+			return 0;
+		}
+
+		source = &buffer[readyFrame * SCOPE_FRAME_SIZE];
+		DECIM_Begin(decim, SCOPE_FRAME_SIZE);
+		for (i = 0; i < SCOPE_FRAME_SIZE; i++)
+		{
+			DECIM_Push(decim, source[i]);
+		}
+		DECIM_End(decim);
+
+		// The columns are valid if the DMA did not complete another frame meanwhile
+		if (count == frames)
+		{
+			readFrames = count;
+			return 1;
+		}
+	}
+
+	return 0;
+}
+
+/**
+ * @brief  Converts a sample to millivolts.
+ * @param  sample : ADC sample (0-4095).
+ * @retval Voltage in mV
+ */
+u32 SCOPE_ToMillivolts(u16 sample)
+{
+	return ((u32)sample * SCOPE_VREF_MV) / ADC_RESOLUTION_MAX;
+}
+
+/**
+ * @brief  Half transfer callback: the first frame of the buffer is complete.
+ * @param  None
+ * @retval None
+ */
+void SCOPE_HalfCallback(void)
+{
+	readyFrame = 0;
+	frames++;
+}
+
+/**
+ * @brief  Transfer complete callback: the second frame of the buffer is complete.
+ * @param  None
+ * @retval None
+ */
+void SCOPE_CompleteCallback(void)
+{
+	readyFrame = 1;
+	frames++;
+}
@@ -0,0 +1,18 @@
+/**
+ ******************************************************************************
+ * @file    SEQ_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for SEQ module.
+ ******************************************************************************
+ */
+#ifndef SEQ_SEQ_CONFIG_H_
+#define SEQ_SEQ_CONFIG_H_
+
+/* PWM timer configurations ----------------------------------------------------*/
+#define SEQ_TIMx    (TIM2)                    // Same output as APP_TIM_PWM_TIMx
+#define SEQ_TIM_CHx (TIM_CH3)                 // PWM output on PA2
+
+/* DMA configurations ----------------------------------------------------------*/
+#define SEQ_DMA_CH (DMA_CH2)                  // TIM2 update requests are served by DMA1 channel 2
+
+#endif /* SEQ_SEQ_CONFIG_H_ */
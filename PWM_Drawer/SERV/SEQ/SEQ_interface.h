@@ -0,0 +1,71 @@
+/**
+ ******************************************************************************
+ * @file    SEQ_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of SEQ (PWM duty sequence) module.
+ ******************************************************************************
+ */
+#ifndef SEQ_SEQ_INTERFACE_H_
+#define SEQ_SEQ_INTERFACE_H_
+
+#include "STD_TYPES.h"
+#include "../../MCAL/DMA/DMA_interface.h"
+#include "../../MCAL/TIM/TIM_interface.h"
+
+#include "SEQ_config.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef SEQ_Mode_t
+ * @brief Enumeration of sequence playback modes.
+ */
+typedef enum
+{
+	SEQ_MODE_ONESHOT = 0,  /*!< Played once, the output keeps the last duty cycle */
+	SEQ_MODE_LOOP          /*!< Played again from the first step after the last one */
+}SEQ_Mode_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Converts a duty cycle to the compare value of a sequence step.
+ * @param  setting : Pointer to the setting the PWM output was started with.
+ * @param  duty : Duty cycle in 0.01% units (0 to TIM_DUTY_FULL).
+ * @retval Compare value, a full duty at a 65536 ticks period being one tick short
+ */
+u16 SEQ_DutyToCompare(const TIM_PWM_Setting_t *setting, u32 duty);
+
+/**
+ * @brief  Starts feeding the compare register of the PWM output from a table, one step per
+ *         PWM period: the timer update event requests the DMA to copy the next step.
+ * @note   The output must have been started by TIM_PWM_StartFine, each step takes effect
+ *         one period after it is copied since the compare register is preloaded.
+ * @param  compares : Table of compare values, must stay valid while the sequence is playing.
+ * @param  count : Number of steps in the table.
+ * @param  mode : SEQ_MODE_ONESHOT or SEQ_MODE_LOOP.
+ * @retval None
+ */
+void SEQ_Start(const u16 *compares, u16 count, SEQ_Mode_t mode);
+
+/**
+ * @brief  Stops the sequence, the output keeps the last duty cycle.
+ * @param  None
+ * @retval None
+ */
+void SEQ_Stop(void);
+
+/**
+ * @brief  Checks whether a sequence is playing.
+ * @param  None
+ * @retval 1 if playing, 0 otherwise
+ */
+u8 SEQ_IsRunning(void);
+
+/* Callback functions --------------------------------------------------------*/
+/**
+ * @brief  Transfer complete callback: the last step of a one-shot sequence is copied.
+ * @param  None
+ * @retval None
+ */
+void SEQ_CompleteCallback(void);
+
+#endif /* SEQ_SEQ_INTERFACE_H_ */
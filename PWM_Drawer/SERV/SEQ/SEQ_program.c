@@ -0,0 +1,111 @@
+/**
+ ******************************************************************************
+ * @file    SEQ_program.c
+ * @author  Salma Faragalla
+ * @brief   SEQ (PWM duty sequence) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "SEQ_interface.h"
+
+/* Private variables ---------------------------------------------------------*/
+static volatile u8 running;
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Converts a duty cycle to the compare value of a sequence step.
+ * @param  setting : Pointer to the setting the PWM output was started with.
+ * @param  duty : Duty cycle in 0.01% units (0 to TIM_DUTY_FULL).
+ * @retval Compare value, a full duty at a 65536 ticks period being one tick short
+ */
+u16 SEQ_DutyToCompare(const TIM_PWM_Setting_t *setting, u32 duty)
+{
+	u32 period = setting->reload + 1UL;
+	u32 compare;
+
+	if (duty > TIM_DUTY_FULL)
+	{
+		duty = TIM_DUTY_FULL;
+	}
+
+	compare = (duty * period + TIM_DUTY_FULL / 2UL) / TIM_DUTY_FULL;
+
+	return (compare > 0xFFFFUL) ? 0xFFFFU : (u16)compare;
+}
+
+/**
+ * @brief  Starts feeding the compare register of the PWM output from a table, one step per
+ *         PWM period: the timer update event requests the DMA to copy the next step.
+ * @note   The output must have been started by TIM_PWM_StartFine, each step takes effect
+ *         one period after it is copied since the compare register is preloaded.
+ * @param  compares : Table of compare values, must stay valid while the sequence is playing.
+ * @param  count : Number of steps in the table.
+ * @param  mode : SEQ_MODE_ONESHOT or SEQ_MODE_LOOP.
+ * @retval None
+ */
+void SEQ_Start(const u16 *compares, u16 count, SEQ_Mode_t mode)
+{
+	DMA_Config_t dmaConfig = {
+		DMA_MEM_TO_PERIPH, DMA_MODE_NORMAL, DMA_SIZE_16BIT, DMA_SIZE_16BIT, 0, 1, DMA_PRIORITY_MEDIUM
+	};
+
+	SEQ_Stop();
+
+	if (count == 0)
+	{
+		return;
+	}
+
+	// A looping sequence runs without interrupts, a one-shot one only to stop the requests
+	if (mode == SEQ_MODE_LOOP)
+	{
+		dmaConfig.mode = DMA_MODE_CIRCULAR;
+		DMA_SetCompleteCallback(SEQ_DMA_CH, 0);
+	}
+	else
+	{
+		DMA_SetCompleteCallback(SEQ_DMA_CH, SEQ_CompleteCallback);
+	}
+	DMA_SetHalfCallback(SEQ_DMA_CH, 0);
+
+	running = 1;
+
+	DMA_Init();
+	DMA_Start(SEQ_DMA_CH, &dmaConfig, TIM_GetCompareAddress(SEQ_TIMx, SEQ_TIM_CHx), (void *)compares, count);
+
+	TIM_DMA_SetUpdateRequest(SEQ_TIMx, TIM_INT_ENABLE);
+}
+
+/**
+ * @brief  Stops the sequence, the output keeps the last duty cycle.
+ * @param  None
+ * @retval None
+ */
+void SEQ_Stop(void)
+{
+	TIM_DMA_SetUpdateRequest(SEQ_TIMx, TIM_INT_DISABLE);
+	DMA_Stop(SEQ_DMA_CH);
+
+	running = 0;
+}
+
+/**
+ * @brief  Checks whether a sequence is playing.
+ * @param  None
+ * @retval 1 if playing, 0 otherwise
+ */
+u8 SEQ_IsRunning(void)
+{
+	return running;
+}
+
+/* Callback functions --------------------------------------------------------*/
+/**
+ * @brief  Transfer complete callback: the last step of a one-shot sequence is copied.
+ * @param  None
+ * @retval None
+ */
+void SEQ_CompleteCallback(void)
+{
+	SEQ_Stop();
+}
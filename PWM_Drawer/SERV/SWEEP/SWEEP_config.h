@@ -0,0 +1,23 @@
+/**
+ ******************************************************************************
+ * @file    SWEEP_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for SWEEP module.
+ ******************************************************************************
+ */
+#ifndef SWEEP_SWEEP_CONFIG_H_
+#define SWEEP_SWEEP_CONFIG_H_
+
+/* Sweep plan configurations ---------------------------------------------------*/
+/* Every duty cycle is generated at every frequency, frequencies stay below
+ * AUTO_GATED_MIN_HZ so that the duty cycle is captured too */
+#define SWEEP_FREQS_MHZ    { 100000UL, 1000000UL, 5000000UL, 10000000UL, 20000000UL, 40000000UL }
+#define SWEEP_FREQ_COUNT   (6U)
+#define SWEEP_DUTIES       { 1000UL, 5000UL, 9000UL }   // 0.01% units
+#define SWEEP_DUTY_COUNT   (3U)
+#define SWEEP_POINT_COUNT  (SWEEP_FREQ_COUNT * SWEEP_DUTY_COUNT)
+
+/* Measurement configurations --------------------------------------------------*/
+#define SWEEP_WINDOW_US    (100000UL)   // Captures of a point are collected over this window
+
+#endif /* SWEEP_SWEEP_CONFIG_H_ */
@@ -0,0 +1,116 @@
+/**
+ ******************************************************************************
+ * @file    SWEEP_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of SWEEP (loopback self-test) module.
+ ******************************************************************************
+ */
+#ifndef SWEEP_SWEEP_INTERFACE_H_
+#define SWEEP_SWEEP_INTERFACE_H_
+
+#include "STD_TYPES.h"
+#include "../../MCAL/TIM/TIM_interface.h"
+#include "../MEAS/MEAS_interface.h"
+
+#include "SWEEP_config.h"
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef SWEEP_Status_t
+ * @brief Enumeration of sweep point results.
+ */
+typedef enum
+{
+	SWEEP_POINT_OK = 0,     /*!< Frequency and duty cycle captured */
+	SWEEP_POINT_NO_SIGNAL,  /*!< No period captured, the loopback is open */
+	SWEEP_POINT_SKIPPED     /*!< Frequency not generated or not captured in reciprocal mode */
+}SWEEP_Status_t;
+
+/**
+ * @typedef SWEEP_Acc_t
+ * @brief Captures accumulated over the window of a sweep point.
+ */
+typedef struct
+{
+	u64 periodTicks;   /*!< Sum of the captured periods */
+	u64 highTicks;     /*!< Sum of the captured high times */
+	u32 records;       /*!< Periods read from the measurement channel */
+	u32 isrCycles;     /*!< Core cycles spent in the capture interrupt over the window */
+	u32 isrCalls;      /*!< Capture interrupts over the window */
+}SWEEP_Acc_t;
+
+/**
+ * @typedef SWEEP_Point_t
+ * @brief Generated and measured values of a sweep point.
+ */
+typedef struct
+{
+	SWEEP_Status_t status;
+	u32 frequency_mHz;      /*!< Generated frequency in mHz */
+	u32 duty;               /*!< Generated duty cycle in 0.01% units */
+	u32 measFrequency_mHz;  /*!< Mean measured frequency in mHz */
+	u32 measDuty;           /*!< Mean measured duty cycle in 0.01% units */
+	s32 frequencyError_ppm; /*!< Measured minus generated frequency, in ppm of the generated one */
+	s32 dutyError;          /*!< Measured minus generated duty cycle in 0.01% units */
+	u32 isrCycles;          /*!< Mean core cycles per capture interrupt */
+	u32 isrLoad;            /*!< Share of the core time spent in the capture interrupt, 0.01% units */
+	u32 expected;           /*!< Periods expected over the window */
+	u32 records;            /*!< Periods read over the window */
+	u32 missed;             /*!< Expected periods not read (lost edges or ring overruns) */
+}SWEEP_Point_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Returns the generator target of a sweep point.
+ * @param  index : Point index (0 to SWEEP_POINT_COUNT - 1), duty cycles vary fastest.
+ * @param  frequency_mHz : Pointer to the frequency in mHz to be filled.
+ * @param  duty : Pointer to the duty cycle in 0.01% units to be filled.
+ * @retval None
+ */
+void SWEEP_GetTarget(u8 index, u32 *frequency_mHz, u32 *duty);
+
+/**
+ * @brief  Clears the accumulated captures of a point.
+ * @param  acc : Pointer to the accumulator.
+ * @retval None
+ */
+void SWEEP_ResetAcc(SWEEP_Acc_t *acc);
+
+/**
+ * @brief  Adds a captured period to the accumulated captures of a point.
+ * @param  acc : Pointer to the accumulator.
+ * @param  record : Pointer to the captured period.
+ * @retval None
+ */
+void SWEEP_Accumulate(SWEEP_Acc_t *acc, const MEAS_Record_t *record);
+
+/**
+ * @brief  Computes the errors, interrupt time and missed periods of a point.
+ * @param  point : Pointer to the point, its status and generated values set by the user.
+ * @param  acc : Pointer to the captures accumulated over the window.
+ * @param  tickRate : Counter clock of the capture timer in Hz.
+ * @param  eventsPerCapture : Rising edges per capture of the period channel.
+ * @param  window_us : Length of the window in us.
+ * @retval None
+ */
+void SWEEP_Evaluate(SWEEP_Point_t *point, const SWEEP_Acc_t *acc, u32 tickRate, u8 eventsPerCapture, u32 window_us);
+
+/**
+ * @brief  Formats a point as a CSV line (frequency_mHz, duty, measured frequency_mHz, measured duty,
+ *         frequency error ppm, duty error, ISR cycles, ISR load, expected, read, missed, status).
+ * @param  point : Pointer to the point.
+ * @param  line : Destination of the line, terminated by "\r\n" and a null character.
+ * @param  size : Size of the destination, lines are cut to fit.
+ * @retval Length of the line without the null character
+ */
+u16 SWEEP_FormatCsv(const SWEEP_Point_t *point, char *line, u16 size);
+
+/**
+ * @brief  Formats the CSV header line naming the columns of SWEEP_FormatCsv.
+ * @param  line : Destination of the line, terminated by "\r\n" and a null character.
+ * @param  size : Size of the destination, lines are cut to fit.
+ * @retval Length of the line without the null character
+ */
+u16 SWEEP_FormatCsvHeader(char *line, u16 size);
+
+#endif /* SWEEP_SWEEP_INTERFACE_H_ */
@@ -0,0 +1,254 @@
+/**
+ ******************************************************************************
+ * @file    SWEEP_program.c
+ * @author  Salma Faragalla
+ * @brief   SWEEP (loopback self-test) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "SWEEP_interface.h"
+
+/* Private functions prototypes ----------------------------------------------*/
+/**
+ * @brief  Appends a string to a line, cut to fit.
+ * @param  line : Destination line, kept null terminated.
+ * @param  length : Current length of the line.
+ * @param  size : Size of the destination.
+ * @param  str : String to append.
+ * @retval New length of the line
+ */
+static u16 SWEEP_AppendString(char *line, u16 length, u16 size, const char *str);
+
+/**
+ * @brief  Appends an unsigned number and a separator to a line, cut to fit.
+ * @param  line : Destination line, kept null terminated.
+ * @param  length : Current length of the line.
+ * @param  size : Size of the destination.
+ * @param  num : Number to append.
+ * @param  sign : Character printed before the digits, 0 for none.
+ * @retval New length of the line
+ */
+static u16 SWEEP_AppendNum(char *line, u16 length, u16 size, u32 num, char sign);
+
+/**
+ * @brief  Appends a signed number and a separator to a line, cut to fit.
+ * @param  line : Destination line, kept null terminated.
+ * @param  length : Current length of the line.
+ * @param  size : Size of the destination.
+ * @param  num : Number to append.
+ * @retval New length of the line
+ */
+static u16 SWEEP_AppendSigned(char *line, u16 length, u16 size, s32 num);
+
+/* Private variables --------------------------------------------------------*/
+static const u32 frequencies_mHz[SWEEP_FREQ_COUNT] = SWEEP_FREQS_MHZ;
+static const u32 duties[SWEEP_DUTY_COUNT] = SWEEP_DUTIES;
+
+/* Private functions --------------------------------------------------------*/
+/**
+ * @brief  Appends a string to a line, cut to fit.
+ * @param  line : Destination line, kept null terminated.
+ * @param  length : Current length of the line.
+ * @param  size : Size of the destination.
+ * @param  str : String to append.
+ * @retval New length of the line
+ */
+static u16 SWEEP_AppendString(char *line, u16 length, u16 size, const char *str)
+{
+	while (*str != 0 && length + 1U < size)
+	{
+		line[length++] = *str++;
+	}
+	line[length] = 0;
+
+	return length;
+}
+
+/**
+ * @brief  Appends an unsigned number and a separator to a line, cut to fit.
+ * @param  line : Destination line, kept null terminated.
+ * @param  length : Current length of the line.
+ * @param  size : Size of the destination.
+ * @param  num : Number to append.
+ * @param  sign : Character printed before the digits, 0 for none.
+ * @retval New length of the line
+ */
+static u16 SWEEP_AppendNum(char *line, u16 length, u16 size, u32 num, char sign)
+{
+	char digits[13];
+	u8 i = sizeof(digits) - 1U;
+
+	digits[i] = 0;
+	digits[--i] = ',';
+	do
+	{
+		digits[--i] = (char)('0' + num % 10UL);
+		num /= 10UL;
+	} while (num != 0);
+
+	if (sign != 0)
+	{
+		digits[--i] = sign;
+	}
+
+	return SWEEP_AppendString(line, length, size, &digits[i]);
+}
+
+/**
+ * @brief  Appends a signed number and a separator to a line, cut to fit.
+ * @param  line : Destination line, kept null terminated.
+ * @param  length : Current length of the line.
+ * @param  size : Size of the destination.
+ * @param  num : Number to append.
+ * @retval New length of the line
+ */
+static u16 SWEEP_AppendSigned(char *line, u16 length, u16 size, s32 num)
+{
+	if (num < 0)
+	{
+		return SWEEP_AppendNum(line, length, size, (u32)(-(s64)num), '-');
+	}
+
+	return SWEEP_AppendNum(line, length, size, (u32)num, 0);
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Returns the generator target of a sweep point.
+ * @param  index : Point index (0 to SWEEP_POINT_COUNT - 1), duty cycles vary fastest.
+ * @param  frequency_mHz : Pointer to the frequency in mHz to be filled.
+ * @param  duty : Pointer to the duty cycle in 0.01% units to be filled.
+ * @retval None
+ */
+void SWEEP_GetTarget(u8 index, u32 *frequency_mHz, u32 *duty)
+{
+	*frequency_mHz = frequencies_mHz[(index / SWEEP_DUTY_COUNT) % SWEEP_FREQ_COUNT];
+	*duty = duties[index % SWEEP_DUTY_COUNT];
+}
+
+/**
+ * @brief  Clears the accumulated captures of a point.
+ * @param  acc : Pointer to the accumulator.
+ * @retval None
+ */
+void SWEEP_ResetAcc(SWEEP_Acc_t *acc)
+{
+	acc->periodTicks = 0;
+	acc->highTicks = 0;
+	acc->records = 0;
+	acc->isrCycles = 0;
+	acc->isrCalls = 0;
+}
+
+/**
+ * @brief  Adds a captured period to the accumulated captures of a point.
+ * @param  acc : Pointer to the accumulator.
+ * @param  record : Pointer to the captured period.
+ * @retval None
+ */
+void SWEEP_Accumulate(SWEEP_Acc_t *acc, const MEAS_Record_t *record)
+{
+	acc->periodTicks += record->periodTicks;
+	acc->highTicks += record->highTicks;
+	acc->records++;
+}
+
+/**
+ * @brief  Computes the errors, interrupt time and missed periods of a point.
+ * @param  point : Pointer to the point, its status and generated values set by the user.
+ * @param  acc : Pointer to the captures accumulated over the window.
+ * @param  tickRate : Counter clock of the capture timer in Hz.
+ * @param  eventsPerCapture : Rising edges per capture of the period channel.
+ * @param  window_us : Length of the window in us.
+ * @retval None
+ */
+void SWEEP_Evaluate(SWEEP_Point_t *point, const SWEEP_Acc_t *acc, u32 tickRate, u8 eventsPerCapture, u32 window_us)
+{
+	u64 windowCycles = (u64)window_us * (FCPU / 1000000UL);
+
+	point->measFrequency_mHz = 0;
+	point->measDuty = 0;
+	point->frequencyError_ppm = 0;
+	point->dutyError = 0;
+	point->records = acc->records;
+
+	// Captured periods expected from the generated frequency, one record per eventsPerCapture edges
+	point->expected = (u32)(((u64)point->frequency_mHz * window_us) / (1000000000ULL * eventsPerCapture));
+	point->missed = (point->expected > acc->records) ? (point->expected - acc->records) : 0;
+
+	point->isrCycles = (acc->isrCalls != 0) ? (acc->isrCycles / acc->isrCalls) : 0;
+	point->isrLoad = (windowCycles != 0) ? (u32)(((u64)acc->isrCycles * 10000ULL) / windowCycles) : 0;
+
+	if (point->status == SWEEP_POINT_OK && (acc->records == 0 || acc->periodTicks == 0))
+	{
+		point->status = SWEEP_POINT_NO_SIGNAL;
+	}
+	if (point->status != SWEEP_POINT_OK)
+	{
+		return;
+	}
+
+	point->measFrequency_mHz = (u32)(((u64)tickRate * 1000ULL * acc->records + acc->periodTicks / 2ULL) / acc->periodTicks);
+	point->measDuty = (u32)((acc->highTicks * MEAS_DUTY_FULL + acc->periodTicks / 2ULL) / acc->periodTicks);
+
+	point->frequencyError_ppm = (s32)((((s64)point->measFrequency_mHz - (s64)point->frequency_mHz) * 1000000LL) / (s64)point->frequency_mHz);
+	point->dutyError = (s32)point->measDuty - (s32)point->duty;
+}
+
+/**
+ * @brief  Formats a point as a CSV line (frequency_mHz, duty, measured frequency_mHz, measured duty,
+ *         frequency error ppm, duty error, ISR cycles, ISR load, expected, read, missed, status).
+ * @param  point : Pointer to the point.
+ * @param  line : Destination of the line, terminated by "\r\n" and a null character.
+ * @param  size : Size of the destination, lines are cut to fit.
+ * @retval Length of the line without the null character
+ */
+u16 SWEEP_FormatCsv(const SWEEP_Point_t *point, char *line, u16 size)
+{
+	u16 length = 0;
+
+	if (size == 0)
+	{
+		return 0;
+	}
+	line[0] = 0;
+
+	length = SWEEP_AppendNum(line, length, size, point->frequency_mHz, 0);
+	length = SWEEP_AppendNum(line, length, size, point->duty, 0);
+	length = SWEEP_AppendNum(line, length, size, point->measFrequency_mHz, 0);
+	length = SWEEP_AppendNum(line, length, size, point->measDuty, 0);
+	length = SWEEP_AppendSigned(line, length, size, point->frequencyError_ppm);
+	length = SWEEP_AppendSigned(line, length, size, point->dutyError);
+	length = SWEEP_AppendNum(line, length, size, point->isrCycles, 0);
+	length = SWEEP_AppendNum(line, length, size, point->isrLoad, 0);
+	length = SWEEP_AppendNum(line, length, size, point->expected, 0);
+	length = SWEEP_AppendNum(line, length, size, point->records, 0);
+	length = SWEEP_AppendNum(line, length, size, point->missed, 0);
+
+	// The status is the last column, without a separator
+	length = SWEEP_AppendNum(line, length, size, point->status, 0);
+	if (length != 0 && line[length - 1U] == ',')
+	{
+		line[--length] = 0;
+	}
+
+	return SWEEP_AppendString(line, length, size, "\r\n");
+}
+
+/**
+ * @brief  Formats the CSV header line naming the columns of SWEEP_FormatCsv.
+ * @param  line : Destination of the line, terminated by "\r\n" and a null character.
+ * @param  size : Size of the destination, lines are cut to fit.
+ * @retval Length of the line without the null character
+ */
+u16 SWEEP_FormatCsvHeader(char *line, u16 size)
+{
+	if (size == 0)
+	{
+		return 0;
+	}
+	line[0] = 0;
+
+	return SWEEP_AppendString(line, 0, size,
+			"freq_mHz,duty,meas_freq_mHz,meas_duty,freq_err_ppm,duty_err,isr_cycles,isr_load,expected,read,missed,status\r\n");
+}
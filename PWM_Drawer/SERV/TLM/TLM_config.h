@@ -0,0 +1,22 @@
+/**
+ ******************************************************************************
+ * @file    TLM_config.h
+ * @author  Salma Faragalla
+ * @brief   Configuration file for TLM module.
+ ******************************************************************************
+ */
+#ifndef TLM_TLM_CONFIG_H_
+#define TLM_TLM_CONFIG_H_
+
+/* Frame pool configurations -----------------------------------------------------*/
+#define TLM_RECORDS_PER_FRAME (16U)   // Records batched in a frame, 151 bytes on the link
+#define TLM_FRAME_COUNT       (4U)    // Frames of the pool: one being filled, the others waiting or sent
+
+#if (TLM_RECORDS_PER_FRAME * 9U > 255U)
+#error "The payload of a record frame must fit its 8-bit length"
+#endif
+#if (TLM_RECORDS_PER_FRAME * 9U < 3U + 129U)
+#error "The payload of a record frame must hold an encoded screenshot page of 128 columns"
+#endif
+
+#endif /* TLM_TLM_CONFIG_H_ */
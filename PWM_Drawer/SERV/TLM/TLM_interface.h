@@ -0,0 +1,182 @@
+/**
+ ******************************************************************************
+ * @file    TLM_interface.h
+ * @author  Salma Faragalla
+ * @brief   Header file of TLM (binary telemetry framing) module.
+ *
+ *          Frame, multi-byte fields little-endian:
+ *            0xA5 0x5A | type (u8) | sequence (u8) | length (u8) | payload | CRC (u16)
+ *          The CRC-16/CCITT-FALSE (polynomial 0x1021, initial 0xFFFF) covers the type,
+ *          sequence, length and payload. The sequence counts every closed frame, a gap
+ *          shows frames dropped before being sent.
+ *
+ *          TLM_FRAME_RECORDS payload: length / TLM_RECORD_SIZE records of
+ *            timestamp (u32) | period ticks (u16) | high ticks (u16) | flags (u8)
+ *          TLM_FRAME_INFO payload:
+ *            timestamp clock in Hz (u32) | records lost (u32) | interrupt load in 0.1% (u16) |
+ *            channel count (u8) | per channel: tick rate in Hz (u32), overcaptures (u32)
+ *          TLM_FRAME_SCREEN payload, a page of 8 pixel rows of a monochrome screen:
+ *            page (u8) | page count (u8) | width in columns (u8) | PackBits of the columns
+ *          A column byte holds the 8 pixels of the page, bit 0 at the top. PackBits
+ *          control byte n: 0-127 n + 1 literal bytes follow, 129-255 the next byte is
+ *          repeated 257 - n times, 128 is not used.
+ ******************************************************************************
+ */
+#ifndef TLM_TLM_INTERFACE_H_
+#define TLM_TLM_INTERFACE_H_
+
+#include "STD_TYPES.h"
+
+#include "TLM_config.h"
+
+/* Exported constants --------------------------------------------------------*/
+#define TLM_SYNC_0 (0xA5U)
+#define TLM_SYNC_1 (0x5AU)
+
+#define TLM_HEADER_SIZE  (5U)
+#define TLM_LENGTH_INDEX (4U)
+#define TLM_CRC_SIZE     (2U)
+#define TLM_RECORD_SIZE  (9U)
+#define TLM_PAYLOAD_MAX  (TLM_RECORDS_PER_FRAME * TLM_RECORD_SIZE)
+#define TLM_FRAME_MAX    (TLM_HEADER_SIZE + TLM_PAYLOAD_MAX + TLM_CRC_SIZE)
+
+#define TLM_MAX_CHANNELS (4U)
+
+#define TLM_SCREEN_HEADER_SIZE (3U)
+#define TLM_SCREEN_WIDTH_MAX   (128U)   // Columns of a page, encoded in 129 bytes at worst
+
+/** @defgroup TLM_FLAGS flags of a record */
+#define TLM_FLAG_CH_MASK  (0x03U)   // Measurement channel of the record
+#define TLM_FLAG_DROPPED  (0x04U)   // Records were dropped just before this one
+#define TLM_FLAG_OVERLOAD (0x08U)   // The instrument was overloaded when the record was taken
+
+/* Exported types ------------------------------------------------------------*/
+/**
+ * @typedef TLM_FrameType_t
+ * @brief Enumeration of frame types.
+ */
+typedef enum
+{
+	TLM_FRAME_RECORDS = 1,   /*!< Batch of capture records */
+	TLM_FRAME_INFO,          /*!< Clocks and counters needed to decode the records */
+	TLM_FRAME_SCREEN         /*!< Page of a screenshot */
+}TLM_FrameType_t;
+
+/**
+ * @typedef TLM_Record_t
+ * @brief Capture record of a measurement channel.
+ */
+typedef struct
+{
+	u32 timestamp;     /*!< Time of the capture in timestamp clock cycles, wrapping */
+	u16 periodTicks;   /*!< Rising to rising edge time in ticks of the channel */
+	u16 highTicks;     /*!< Rising to falling edge time in ticks of the channel */
+	u8 flags;          /*!< Channel and flags from @defgroup TLM_FLAGS */
+}TLM_Record_t;
+
+/**
+ * @typedef TLM_Info_t
+ * @brief Contents of an information frame.
+ */
+typedef struct
+{
+	u32 clockHz;                             /*!< Clock of the record time stamps */
+	u16 isrLoad;                             /*!< Share of the core in interrupts in 0.1% */
+	u8 channelCount;                         /*!< Channels described, up to TLM_MAX_CHANNELS */
+	u32 tickRates[TLM_MAX_CHANNELS];         /*!< Tick rate of each channel in Hz */
+	u32 overcaptures[TLM_MAX_CHANNELS];      /*!< Captures of each channel overwritten before being served */
+}TLM_Info_t;
+
+/**
+ * @typedef TLM_t
+ * @brief Pool of frames: records are added by one producer, complete frames are
+ *        taken in order by one consumer which releases them once sent.
+ */
+typedef struct
+{
+	u8 frames[TLM_FRAME_COUNT][TLM_FRAME_MAX];
+	volatile u8 head;     /*!< Frame being filled */
+	volatile u8 tail;     /*!< Oldest complete frame */
+	u8 fill;              /*!< Records in the frame being filled */
+	u8 seq;               /*!< Sequence number of the next frame */
+	u8 dropped;           /*!< Records dropped since the last record added */
+	volatile u32 lost;    /*!< Records dropped because no frame was free */
+}TLM_t;
+
+/* Exported functions --------------------------------------------------------*/
+/**
+ * @brief  Initializes an empty frame pool.
+ * @param  tlm : Pointer to the frame pool.
+ * @retval None
+ */
+void TLM_Init(TLM_t *tlm);
+
+/**
+ * @brief  Adds a record to the frame being filled, the frame is closed when full.
+ * @note   Records of a full frame are dropped when no other frame is free, the next
+ *         record added is flagged TLM_FLAG_DROPPED.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  record : Pointer to the record.
+ * @retval 1 if a frame was closed and is ready to be sent, 0 otherwise
+ */
+u8 TLM_AddRecord(TLM_t *tlm, const TLM_Record_t *record);
+
+/**
+ * @brief  Closes the frame being filled if it holds records, so that it can be sent.
+ * @param  tlm : Pointer to the frame pool.
+ * @retval 1 if a frame was closed, 0 otherwise
+ */
+u8 TLM_Flush(TLM_t *tlm);
+
+/**
+ * @brief  Closes the frame being filled, then adds an information frame.
+ * @note   Same producer as TLM_AddRecord.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  info : Pointer to the information.
+ * @retval 1 if the frame was added, 0 if no frame was free
+ */
+u8 TLM_AddInfo(TLM_t *tlm, const TLM_Info_t *info);
+
+/**
+ * @brief  Closes the frame being filled, then adds a screenshot page run-length encoded.
+ * @note   Same producer as TLM_AddRecord.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  page : Index of the page, from the top of the screen.
+ * @param  pageCount : Pages of the screen.
+ * @param  columns : Pointer to the column bytes of the page.
+ * @param  width : Number of columns, up to TLM_SCREEN_WIDTH_MAX
+ * @retval 1 if the frame was added, 0 if no frame was free
+ */
+u8 TLM_AddScreenPage(TLM_t *tlm, u8 page, u8 pageCount, const u8 *columns, u8 width);
+
+/**
+ * @brief  Returns the frames that can still be closed before the pool is full.
+ * @param  tlm : Pointer to the frame pool.
+ * @retval Number of free frames, besides the frame being filled
+ */
+u8 TLM_GetFreeFrames(const TLM_t *tlm);
+
+/**
+ * @brief  Returns the oldest complete frame, kept until TLM_Release.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  size : Pointer to the frame size in bytes to be filled.
+ * @retval Pointer to the frame, 0 if no frame is ready
+ */
+const u8* TLM_Peek(const TLM_t *tlm, u16 *size);
+
+/**
+ * @brief  Frees the oldest complete frame once it was sent.
+ * @param  tlm : Pointer to the frame pool.
+ * @retval None
+ */
+void TLM_Release(TLM_t *tlm);
+
+/**
+ * @brief  Computes the CRC-16/CCITT-FALSE of a buffer.
+ * @param  data : Pointer to the bytes.
+ * @param  length : Number of bytes.
+ * @retval CRC
+ */
+u16 TLM_Crc16(const u8 *data, u16 length);
+
+#endif /* TLM_TLM_INTERFACE_H_ */
@@ -0,0 +1,377 @@
+/**
+ ******************************************************************************
+ * @file    TLM_program.c
+ * @author  Salma Faragalla
+ * @brief   TLM (binary telemetry framing) module
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include "TLM_interface.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define TLM_CRC_INIT (0xFFFFU)
+
+#define TLM_INFO_SIZE(channels) (11U + 8U * (channels))
+
+#define TLM_PACKBITS_MAX (128U)   // Longest literal or repeated run of a control byte
+
+/* Private variables ---------------------------------------------------------*/
+/* CRC of a nibble for polynomial 0x1021, two lookups per byte */
+static const u16 TLM_CrcTable[16] =
+{
+	0x0000U, 0x1021U, 0x2042U, 0x3063U, 0x4084U, 0x50A5U, 0x60C6U, 0x70E7U,
+	0x8108U, 0x9129U, 0xA14AU, 0xB16BU, 0xC18CU, 0xD1ADU, 0xE1CEU, 0xF1EFU
+};
+
+/* Private functions prototypes ----------------------------------------------*/
+/**
+ * @brief  Writes a 16-bit value little-endian.
+ * @param  dest : Destination of the 2 bytes.
+ * @param  value : Value to be written.
+ * @retval None
+ */
+static void TLM_PutU16(u8 *dest, u16 value);
+/**
+ * @brief  Writes a 32-bit value little-endian.
+ * @param  dest : Destination of the 4 bytes.
+ * @param  value : Value to be written.
+ * @retval None
+ */
+static void TLM_PutU32(u8 *dest, u32 value);
+/**
+ * @brief  Writes the header and CRC of the frame being filled and makes it ready to be sent.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  type : Frame type (from @ref TLM_FrameType_t)
+ * @param  length : Payload length in bytes.
+ * @retval 1 if the frame was closed, 0 if it is the last free frame
+ */
+static u8 TLM_Commit(TLM_t *tlm, TLM_FrameType_t type, u8 length);
+/**
+ * @brief  Encodes bytes with PackBits, only runs of 3 bytes or more are repeated.
+ * @param  dest : Destination of the encoded bytes, length + 1 bytes at worst for up to 128 bytes.
+ * @param  src : Bytes to be encoded.
+ * @param  length : Number of bytes.
+ * @retval Number of encoded bytes
+ */
+static u16 TLM_PackBits(u8 *dest, const u8 *src, u16 length);
+/**
+ * @brief  Counts the bytes equal to the first one, up to the longest PackBits run.
+ * @param  src : Bytes to be checked.
+ * @param  length : Number of bytes, at least 1.
+ * @retval Length of the run
+ */
+static u8 TLM_RunLength(const u8 *src, u16 length);
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief  Writes a 16-bit value little-endian.
+ * @param  dest : Destination of the 2 bytes.
+ * @param  value : Value to be written.
+ * @retval None
+ */
+static void TLM_PutU16(u8 *dest, u16 value)
+{
+	dest[0] = (u8)value;
+	dest[1] = (u8)(value >> 8);
+}
+
+/**
+ * @brief  Writes a 32-bit value little-endian.
+ * @param  dest : Destination of the 4 bytes.
+ * @param  value : Value to be written.
+ * @retval None
+ */
+static void TLM_PutU32(u8 *dest, u32 value)
+{
+	dest[0] = (u8)value;
+	dest[1] = (u8)(value >> 8);
+	dest[2] = (u8)(value >> 16);
+	dest[3] = (u8)(value >> 24);
+}
+
+/**
+ * @brief  Writes the header and CRC of the frame being filled and makes it ready to be sent.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  type : Frame type (from @ref TLM_FrameType_t)
+ * @param  length : Payload length in bytes.
+ * @retval 1 if the frame was closed, 0 if it is the last free frame
+ */
+static u8 TLM_Commit(TLM_t *tlm, TLM_FrameType_t type, u8 length)
+{
+	u8 next = (tlm->head + 1U) % TLM_FRAME_COUNT;
+	u8 *frame = tlm->frames[tlm->head];
+
+	// The sequence also counts the dropped frames, the receiver sees the gap
+	u8 seq = tlm->seq++;
+
+	if (next == tlm->tail)
+	{
+		return 0;
+	}
+
+	frame[0] = TLM_SYNC_0;
+	frame[1] = TLM_SYNC_1;
+	frame[2] = (u8)type;
+	frame[3] = seq;
+	frame[TLM_LENGTH_INDEX] = length;
+	TLM_PutU16(&frame[TLM_HEADER_SIZE + length], TLM_Crc16(&frame[2], 3U + length));
+
+	// Published once complete, the consumer only reads frames before head
+	tlm->head = next;
+
+	return 1;
+}
+
+/**
+ * @brief  Encodes bytes with PackBits, only runs of 3 bytes or more are repeated.
+ * @param  dest : Destination of the encoded bytes, length + 1 bytes at worst for up to 128 bytes.
+ * @param  src : Bytes to be encoded.
+ * @param  length : Number of bytes.
+ * @retval Number of encoded bytes
+ */
+static u16 TLM_PackBits(u8 *dest, const u8 *src, u16 length)
+{
+	u16 in = 0;
+	u16 out = 0;
+	u16 header;
+	u8 count;
+
+	while (in < length)
+	{
+		count = TLM_RunLength(&src[in], length - in);
+		if (count >= 3U)
+		{
+			dest[out++] = (u8)(257U - count);
+			dest[out++] = src[in];
+			in += count;
+			continue;
+		}
+
+		// Literals up to the next run worth repeating, a shorter run costs as much as literals
+		header = out++;
+		count = 0;
+		while (in < length && count < TLM_PACKBITS_MAX && TLM_RunLength(&src[in], length - in) < 3U)
+		{
+			dest[out++] = src[in++];
+			count++;
+		}
+		dest[header] = count - 1U;
+	}
+
+	return out;
+}
+
+/**
+ * @brief  Counts the bytes equal to the first one, up to the longest PackBits run.
+ * @param  src : Bytes to be checked.
+ * @param  length : Number of bytes, at least 1.
+ * @retval Length of the run
+ */
+static u8 TLM_RunLength(const u8 *src, u16 length)
+{
+	u8 count = 1;
+
+	while (count < length && count < TLM_PACKBITS_MAX && src[count] == src[0])
+	{
+		count++;
+	}
+
+	return count;
+}
+
+/* Public functions ----------------------------------------------------------*/
+/**
+ * @brief  Initializes an empty frame pool.
+ * @param  tlm : Pointer to the frame pool.
+ * @retval None
+ */
+void TLM_Init(TLM_t *tlm)
+{
+	tlm->head = 0;
+	tlm->tail = 0;
+	tlm->fill = 0;
+	tlm->seq = 0;
+	tlm->dropped = 0;
+	tlm->lost = 0;
+}
+
+/**
+ * @brief  Adds a record to the frame being filled, the frame is closed when full.
+ * @note   Records of a full frame are dropped when no other frame is free, the next
+ *         record added is flagged TLM_FLAG_DROPPED.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  record : Pointer to the record.
+ * @retval 1 if a frame was closed and is ready to be sent, 0 otherwise
+ */
+u8 TLM_AddRecord(TLM_t *tlm, const TLM_Record_t *record)
+{
+	u8 *dest = &tlm->frames[tlm->head][TLM_HEADER_SIZE + tlm->fill * TLM_RECORD_SIZE];
+	u8 flags = record->flags;
+
+	if (tlm->dropped)
+	{
+		flags |= TLM_FLAG_DROPPED;
+		tlm->dropped = 0;
+	}
+
+	TLM_PutU32(&dest[0], record->timestamp);
+	TLM_PutU16(&dest[4], record->periodTicks);
+	TLM_PutU16(&dest[6], record->highTicks);
+	dest[8] = flags;
+
+	if (++tlm->fill < TLM_RECORDS_PER_FRAME)
+	{
+		return 0;
+	}
+
+	return TLM_Flush(tlm);
+}
+
+/**
+ * @brief  Closes the frame being filled if it holds records, so that it can be sent.
+ * @param  tlm : Pointer to the frame pool.
+ * @retval 1 if a frame was closed, 0 otherwise
+ */
+u8 TLM_Flush(TLM_t *tlm)
+{
+	u8 count = tlm->fill;
+
+	if (count == 0)
+	{
+		return 0;
+	}
+
+	tlm->fill = 0;
+	if (!TLM_Commit(tlm, TLM_FRAME_RECORDS, count * TLM_RECORD_SIZE))
+	{
+		// Every other frame waits for the link, the frame is reused
+		tlm->lost += count;
+		tlm->dropped = 1;
+		return 0;
+	}
+
+	return 1;
+}
+
+/**
+ * @brief  Closes the frame being filled, then adds an information frame.
+ * @note   Same producer as TLM_AddRecord.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  info : Pointer to the information.
+ * @retval 1 if the frame was added, 0 if no frame was free
+ */
+u8 TLM_AddInfo(TLM_t *tlm, const TLM_Info_t *info)
+{
+	u8 channels = (info->channelCount > TLM_MAX_CHANNELS) ? TLM_MAX_CHANNELS : info->channelCount;
+	u8 *dest;
+
+	TLM_Flush(tlm);
+
+	dest = &tlm->frames[tlm->head][TLM_HEADER_SIZE];
+	TLM_PutU32(&dest[0], info->clockHz);
+	TLM_PutU32(&dest[4], tlm->lost);
+	TLM_PutU16(&dest[8], info->isrLoad);
+	dest[10] = channels;
+
+	for (u8 i = 0; i < channels; i++)
+	{
+		TLM_PutU32(&dest[11U + 8U * i], info->tickRates[i]);
+		TLM_PutU32(&dest[15U + 8U * i], info->overcaptures[i]);
+	}
+
+	return TLM_Commit(tlm, TLM_FRAME_INFO, TLM_INFO_SIZE(channels));
+}
+
+/**
+ * @brief  Closes the frame being filled, then adds a screenshot page run-length encoded.
+ * @note   Same producer as TLM_AddRecord.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  page : Index of the page, from the top of the screen.
+ * @param  pageCount : Pages of the screen.
+ * @param  columns : Pointer to the column bytes of the page.
+ * @param  width : Number of columns, up to TLM_SCREEN_WIDTH_MAX
+ * @retval 1 if the frame was added, 0 if no frame was free
+ */
+u8 TLM_AddScreenPage(TLM_t *tlm, u8 page, u8 pageCount, const u8 *columns, u8 width)
+{
+	u8 *dest;
+	u16 length;
+
+	if (width > TLM_SCREEN_WIDTH_MAX)
+	{
+		width = TLM_SCREEN_WIDTH_MAX;
+	}
+
+	TLM_Flush(tlm);
+
+	dest = &tlm->frames[tlm->head][TLM_HEADER_SIZE];
+	dest[0] = page;
+	dest[1] = pageCount;
+	dest[2] = width;
+	length = TLM_SCREEN_HEADER_SIZE + TLM_PackBits(&dest[TLM_SCREEN_HEADER_SIZE], columns, width);
+
+	return TLM_Commit(tlm, TLM_FRAME_SCREEN, (u8)length);
+}
+
+/**
+ * @brief  Returns the frames that can still be closed before the pool is full.
+ * @param  tlm : Pointer to the frame pool.
+ * @retval Number of free frames, besides the frame being filled
+ */
+u8 TLM_GetFreeFrames(const TLM_t *tlm)
+{
+	return (tlm->tail + TLM_FRAME_COUNT - tlm->head - 1U) % TLM_FRAME_COUNT;
+}
+
+/**
+ * @brief  Returns the oldest complete frame, kept until TLM_Release.
+ * @param  tlm : Pointer to the frame pool.
+ * @param  size : Pointer to the frame size in bytes to be filled.
+ * @retval Pointer to the frame, 0 if no frame is ready
+ */
+const u8* TLM_Peek(const TLM_t *tlm, u16 *size)
+{
+	const u8 *frame;
+
+	if (tlm->tail == tlm->head)
+	{
+		return 0;
+	}
+
+	frame = tlm->frames[tlm->tail];
+	*size = TLM_HEADER_SIZE + frame[TLM_LENGTH_INDEX] + TLM_CRC_SIZE;
+
+	return frame;
+}
+
+/**
+ * @brief  Frees the oldest complete frame once it was sent.
+ * @param  tlm : Pointer to the frame pool.
+ * @retval None
+ */
+void TLM_Release(TLM_t *tlm)
+{
+	if (tlm->tail != tlm->head)
+	{
+		tlm->tail = (tlm->tail + 1U) % TLM_FRAME_COUNT;
+	}
+}
+
+/**
+ * @brief  Computes the CRC-16/CCITT-FALSE of a buffer.
+ * @param  data : Pointer to the bytes.
+ * @param  length : Number of bytes.
+ * @retval CRC
+ */
+u16 TLM_Crc16(const u8 *data, u16 length)
+{
+	u16 crc = TLM_CRC_INIT;
+
+	for (u16 i = 0; i < length; i++)
+	{
+		crc = (u16)(crc << 4) ^ TLM_CrcTable[((crc >> 12) ^ (data[i] >> 4)) & 0x0FU];
+		crc = (u16)(crc << 4) ^ TLM_CrcTable[((crc >> 12) ^ data[i]) & 0x0FU];
+	}
+
+	return crc;
+}
@@ -12,13 +12,14 @@ int main()
 {
 	APP_Init();
 	APP_IC_Start();
-	APP_PWM_Start(79, 600);
+	APP_TLM_Start();
+	APP_PWM_StartFine(600000UL, 7900UL, 0);
+	APP_Autoset(0);
 	APP_GLCD_Print_Init();
 
 	while (1)
 	{
-		APP_GLCD_Update();
-
+		APP_Run();
 	}
 
 }
@@ -0,0 +1,80 @@
+/**
+ ******************************************************************************
+ * @file    PhaseCheck.c
+ * @author  Salma Faragalla
+ * @brief   Host program checking the delay folding of the PHASE module on
+ *          edge time stamps of a 16-bit counter.
+ *
+ *          Build and run from this directory:
+ *            gcc -std=gnu11 -fshort-enums -I../../PWM_Drawer/Inc \
+ *                PhaseCheck.c ../../PWM_Drawer/SERV/PHASE/PHASE_program.c -o PhaseCheck
+ *            ./PhaseCheck
+ *
+ *          Periods below and above half the counter range are checked, with the
+ *          counter wrapping between the edges and with input B stamped just before
+ *          the edge of input A it is compared with.
+ *          The exit code is the number of failed checks.
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <stdio.h>
+
+#include "STD_TYPES.h"
+#include "../../PWM_Drawer/SERV/PHASE/PHASE_interface.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define CHECK_COUNTER_MASK (0xFFFFUL)
+
+/* Private variables ---------------------------------------------------------*/
+static int failures;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief  Feeds two edges of A one period apart, then an edge of B at an offset
+ *         from the last edge of A, and checks the delay measured.
+ */
+static void Check_Delay(u32 periodTicks, u32 firstEdgeA, long offsetB, u32 expected, const char *message)
+{
+	PHASE_t phase;
+	u32 edgeA = (firstEdgeA + periodTicks) & CHECK_COUNTER_MASK;
+
+	PHASE_Init(&phase);
+	PHASE_SetTiming(&phase, 1000000UL, 1);
+	PHASE_EdgeA(&phase, firstEdgeA);
+	PHASE_EdgeA(&phase, edgeA);
+	PHASE_EdgeB(&phase, (u32)((long)edgeA + offsetB) & CHECK_COUNTER_MASK);
+
+	if (phase.periodTicks != periodTicks || phase.measurements != 1 || phase.delayTicks != expected)
+	{
+		printf("FAIL: %s (period %lu, delay %lu, expected %lu)\n", message,
+				(unsigned long)phase.periodTicks, (unsigned long)phase.delayTicks, (unsigned long)expected);
+		failures++;
+	}
+}
+
+int main(void)
+{
+	PHASE_t phase;
+
+	Check_Delay(1000, 100, 250, 250, "short period, B after A");
+	Check_Delay(1000, 65000, 250, 250, "short period, counter wrap");
+	Check_Delay(1000, 100, -10, 990, "short period, B stamped before A");
+	Check_Delay(40000, 100, 35000, 35000, "long period, delay above half the counter");
+	Check_Delay(40000, 50000, 35000, 35000, "long period, delay across the counter wrap");
+	Check_Delay(40000, 100, 20000, 20000, "long period, delay below half the counter");
+	Check_Delay(40000, 1000, -100, 39900, "long period, B stamped before A");
+	Check_Delay(50000, 30000, 0, 0, "long period, edges together");
+	Check_Delay(65000, 0, 64000, 64000, "period near the counter range");
+
+	PHASE_Init(&phase);
+	PHASE_EdgeB(&phase, 1234);
+	if (phase.measurements != 0)
+	{
+		printf("FAIL: delay measured before the period of A\n");
+		failures++;
+	}
+
+	printf("%d failed checks\n", failures);
+
+	return failures;
+}
@@ -0,0 +1,301 @@
+/**
+ ******************************************************************************
+ * @file    ScopeMock.c
+ * @author  Salma Faragalla
+ * @brief   Host program running the SCOPE module on mocked ADC, DMA and TIM
+ *          drivers, so that the acquisition pipeline can be checked off-target.
+ *
+ *          Build and run from this directory:
+ *            gcc -std=gnu11 -fshort-enums -I../../PWM_Drawer/Inc \
+ *                ScopeMock.c ../../PWM_Drawer/SERV/SCOPE/SCOPE_program.c \
+ *                ../../PWM_Drawer/SERV/DECIM/DECIM_program.c -lm -o ScopeMock
+ *            ./ScopeMock
+ *
+ *          The mocked DMA writes a generated sine wave into the SCOPE double
+ *          buffer and calls the half/complete callbacks like DMA1 would. The
+ *          frames read back and their min/max decimation to the 128 display
+ *          columns are checked, and the last one is printed as text.
+ *          The exit code is the number of failed checks.
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <math.h>
+#include <stdio.h>
+
+#include "STD_TYPES.h"
+#include "../../PWM_Drawer/SERV/SCOPE/SCOPE_interface.h"
+
+/* Defines -------------------------------------------------------------------*/
+#define MOCK_SINE_PERIOD (32U)     // Samples per cycle of the generated wave
+#define MOCK_SINE_MID    (2048.0)
+#define MOCK_SINE_AMP    (1800.0)
+#define MOCK_ROW_TOP     (8U)
+#define MOCK_ROW_BOTTOM  (63U)
+#define MOCK_COLUMNS     (128U)
+#define MOCK_GLITCH_AT   (5U * SCOPE_FRAME_SIZE + 201U)  // Single sample spike, narrower than a column
+#define MOCK_GLITCH      (4000U)
+
+/* Private variables ---------------------------------------------------------*/
+static void (*halfCallback)(void);
+static void (*completeCallback)(void);
+static u16 *dmaMemory;
+static u16 dmaCount;
+static u16 dmaIndex;
+static u8 dmaEnabled;
+static u8 triggerRunning;
+static u32 sampleNumber;
+static int failures;
+
+/* Mocked MCAL ---------------------------------------------------------------*/
+void DMA_Init(void)
+{
+}
+
+void DMA_Start(DMA_CH_t DMA_CHx, const DMA_Config_t *config, volatile void *periphAddress, void *memAddress, u16 count)
+{
+	(void)DMA_CHx;
+	(void)config;
+	(void)periphAddress;
+
+	dmaMemory = memAddress;
+	dmaCount = count;
+	dmaIndex = 0;
+	dmaEnabled = 1;
+}
+
+void DMA_Stop(DMA_CH_t DMA_CHx)
+{
+	(void)DMA_CHx;
+	dmaEnabled = 0;
+}
+
+u16 DMA_GetRemaining(DMA_CH_t DMA_CHx)
+{
+	(void)DMA_CHx;
+	return dmaCount - dmaIndex;
+}
+
+void DMA_SetHalfCallback(DMA_CH_t DMA_CHx, void (*functionPtr)(void))
+{
+	(void)DMA_CHx;
+	halfCallback = functionPtr;
+}
+
+void DMA_SetCompleteCallback(DMA_CH_t DMA_CHx, void (*functionPtr)(void))
+{
+	(void)DMA_CHx;
+	completeCallback = functionPtr;
+}
+
+void ADC_Init(volatile ADC_TypeDef *ADCx)
+{
+	(void)ADCx;
+}
+
+void ADC_StartTriggered(volatile ADC_TypeDef *ADCx, ADC_CH_t ADC_CHx, ADC_SampleTime_t ADC_SampleTime, u8 ADC_ExtSel)
+{
+	(void)ADCx;
+	(void)ADC_CHx;
+	(void)ADC_SampleTime;
+	(void)ADC_ExtSel;
+}
+
+void ADC_Stop(volatile ADC_TypeDef *ADCx)
+{
+	(void)ADCx;
+}
+
+volatile u32* ADC_GetDataAddress(volatile ADC_TypeDef *ADCx)
+{
+	(void)ADCx;
+	return 0;
+}
+
+void TIM_Init(volatile TIM_TypeDef *TIMx)
+{
+	(void)TIMx;
+}
+
+u32 TIM_OC_Trigger_Start(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx, u32 frequency)
+{
+	u32 ticks = TIM_CLK / frequency;
+	u32 prescaler = ticks / (TIM_MAX_PERIOD + 1UL);
+	u32 period = ticks / (prescaler + 1UL);
+
+	(void)TIMx;
+	(void)TIM_CHx;
+	triggerRunning = 1;
+
+	return TIM_CLK / ((prescaler + 1UL) * period);
+}
+
+void TIM_OC_Trigger_Stop(volatile TIM_TypeDef *TIMx, TIM_CH_t TIM_CHx)
+{
+	(void)TIMx;
+	(void)TIM_CHx;
+	triggerRunning = 0;
+}
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief  Sample of the generated wave, as converted by the ADC.
+ */
+static u16 Mock_Sample(u32 n)
+{
+	if (n == MOCK_GLITCH_AT)
+	{
+		return MOCK_GLITCH;
+	}
+	return (u16)lround(MOCK_SINE_MID + MOCK_SINE_AMP * sin(2.0 * M_PI * (f64)n / MOCK_SINE_PERIOD));
+}
+
+/**
+ * @brief  Runs conversions, the DMA moving each one and raising its events.
+ */
+static void Mock_Convert(u32 count)
+{
+	while (count-- && dmaEnabled)
+	{
+		dmaMemory[dmaIndex++] = Mock_Sample(sampleNumber++);
+
+		if (dmaIndex == dmaCount / 2U && halfCallback != 0)
+		{
+			halfCallback();
+		}
+		if (dmaIndex == dmaCount)
+		{
+			dmaIndex = 0;
+			if (completeCallback != 0)
+			{
+				completeCallback();
+			}
+		}
+	}
+}
+
+static void Mock_Check(int condition, const char *message)
+{
+	if (!condition)
+	{
+		printf("FAIL: %s\n", message);
+		failures++;
+	}
+}
+
+/**
+ * @brief  Checks a frame holds the samples first..first+SCOPE_FRAME_SIZE-1 of the wave.
+ */
+static int Mock_FrameMatches(const u16 *frame, u32 first)
+{
+	for (u32 i = 0; i < SCOPE_FRAME_SIZE; i++)
+	{
+		if (frame[i] != Mock_Sample(first + i))
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
+static void Mock_PrintTrace(const DECIM_t *decim)
+{
+	char screen[MOCK_ROW_BOTTOM + 1][MOCK_COLUMNS + 1];
+	u8 prevTop = 0, prevBottom = 0;
+
+	for (u32 y = 0; y <= MOCK_ROW_BOTTOM; y++)
+	{
+		for (u32 x = 0; x < MOCK_COLUMNS; x++)
+		{
+			screen[y][x] = '.';
+		}
+		screen[y][MOCK_COLUMNS] = '\0';
+	}
+
+	// Same spans as the GLCD renderer: min to max, joined to the previous column
+	for (u32 x = 0; x < decim->filled; x++)
+	{
+		u8 top = DECIM_ValueToRow(decim->maxs[x], ADC_RESOLUTION_MAX, MOCK_ROW_TOP, MOCK_ROW_BOTTOM);
+		u8 bottom = DECIM_ValueToRow(decim->mins[x], ADC_RESOLUTION_MAX, MOCK_ROW_TOP, MOCK_ROW_BOTTOM);
+		u8 y1 = top, y2 = bottom;
+
+		if (x != 0 && top > prevBottom)
+		{
+			y1 = prevBottom;
+		}
+		else if (x != 0 && bottom < prevTop)
+		{
+			y2 = prevTop;
+		}
+
+		for (u32 y = y1; y <= y2; y++)
+		{
+			screen[y][x] = '#';
+		}
+		prevTop = top;
+		prevBottom = bottom;
+	}
+
+	for (u32 y = MOCK_ROW_TOP; y <= MOCK_ROW_BOTTOM; y++)
+	{
+		printf("%s\n", screen[y]);
+	}
+}
+
+int main(void)
+{
+	u16 frame[SCOPE_FRAME_SIZE];
+	u16 mins[MOCK_COLUMNS], maxs[MOCK_COLUMNS];
+	DECIM_t decim;
+	u32 rate = SCOPE_Start(10000UL);
+
+	DECIM_Init(&decim, mins, maxs, MOCK_COLUMNS);
+
+	printf("sample rate: %u Hz\n", (unsigned)rate);
+	Mock_Check(rate == 10000UL, "achieved sample rate");
+
+	Mock_Check(SCOPE_ReadFrame(frame) == 0, "no frame before the first half transfer");
+
+	Mock_Convert(SCOPE_FRAME_SIZE);
+	Mock_Check(SCOPE_ReadFrame(frame) == 1, "first frame after the half transfer");
+	Mock_Check(Mock_FrameMatches(frame, 0), "first frame content");
+	Mock_Check(SCOPE_ReadFrame(frame) == 0, "frame returned once");
+
+	Mock_Convert(SCOPE_FRAME_SIZE);
+	Mock_Check(SCOPE_ReadFrame(frame) == 1 && Mock_FrameMatches(frame, SCOPE_FRAME_SIZE), "second frame after the transfer complete");
+
+	// Several frames completed between two reads: the last one is returned
+	Mock_Convert(3U * SCOPE_FRAME_SIZE + 10U);
+	Mock_Check(SCOPE_ReadFrame(frame) == 1 && Mock_FrameMatches(frame, 4U * SCOPE_FRAME_SIZE), "latest frame after an overrun");
+
+	Mock_Check(DECIM_ValueToRow(0, ADC_RESOLUTION_MAX, MOCK_ROW_TOP, MOCK_ROW_BOTTOM) == MOCK_ROW_BOTTOM, "zero sample on the bottom row");
+	Mock_Check(DECIM_ValueToRow(4095, ADC_RESOLUTION_MAX, MOCK_ROW_TOP, MOCK_ROW_BOTTOM) == MOCK_ROW_TOP, "full scale sample on the top row");
+	Mock_Check(SCOPE_ToMillivolts(4095) == SCOPE_VREF_MV, "full scale voltage");
+
+	// The next frame holds the glitch, it must survive the decimation to the display columns
+	Mock_Convert(SCOPE_FRAME_SIZE);
+	Mock_Check(SCOPE_DecimateFrame(&decim) == 1, "decimated frame");
+	Mock_Check(decim.filled == MOCK_COLUMNS, "all columns filled");
+	Mock_Check(decim.max == MOCK_GLITCH, "glitch in the frame maximum");
+	Mock_Check(decim.maxs[((MOCK_GLITCH_AT - 5U * SCOPE_FRAME_SIZE) * MOCK_COLUMNS) / SCOPE_FRAME_SIZE] == MOCK_GLITCH, "glitch kept in its column");
+	Mock_Check(SCOPE_DecimateFrame(&decim) == 0, "decimated frame returned once");
+
+	// Fewer points than columns: every column holds a value
+	DECIM_Begin(&decim, 3);
+	DECIM_Push(&decim, 10);
+	DECIM_Push(&decim, 20);
+	DECIM_Push(&decim, 30);
+	Mock_Check(DECIM_End(&decim) == MOCK_COLUMNS && decim.maxs[MOCK_COLUMNS - 1] == 30 && decim.mins[0] == 10, "short record spread over the columns");
+
+	Mock_Convert(SCOPE_FRAME_SIZE);
+	SCOPE_DecimateFrame(&decim);
+	Mock_PrintTrace(&decim);
+
+	SCOPE_Stop();
+	Mock_Convert(SCOPE_FRAME_SIZE);
+	Mock_Check(SCOPE_ReadFrame(frame) == 0, "no frame once stopped");
+	Mock_Check(!triggerRunning, "trigger timer stopped");
+
+	printf("%s (%d failed)\n", failures ? "FAILED" : "PASSED", failures);
+
+	return failures;
+}
@@ -0,0 +1,440 @@
+/**
+ ******************************************************************************
+ * @file    TlmDecode.c
+ * @author  Salma Faragalla
+ * @brief   Host program decoding the telemetry stream of the APP (TLM frames
+ *          sent on USART1) into CSV lines, one per capture record, and the
+ *          screenshots into PBM images.
+ *
+ *          Build from this directory:
+ *            gcc -std=gnu11 -fshort-enums -I../../PWM_Drawer/Inc \
+ *                TlmDecode.c ../../PWM_Drawer/SERV/TLM/TLM_program.c -o TlmDecode
+ *          Run on a raw serial port, or on a file recorded from it:
+ *            stty -F /dev/ttyUSB0 3000000 raw -echo
+ *            ./TlmDecode /dev/ttyUSB0 > log.csv
+ *          Screenshots (APP_Screenshot) are written to screen000.pbm, screen001.pbm...
+ *          or to <prefix>000.pbm with -s <prefix>, any image tool converts them to PNG:
+ *            ./TlmDecode -s shot capture.bin > log.csv && convert shot000.pbm shot000.png
+ *
+ *          Columns: channel, time in s, period in ticks, high time in ticks,
+ *          frequency in Hz, duty cycle in %, flags. Time and frequency need the
+ *          clocks of an information frame, they are left empty before the first
+ *          one. The 32-bit time stamps are unwrapped, the stream must not pause
+ *          longer than a wrap (about 60 s at 72 MHz).
+ *          Frame, CRC and sequence errors are counted on stderr at the end.
+ ******************************************************************************
+ */
+/* Includes ------------------------------------------------------------------*/
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "STD_TYPES.h"
+#include "../../PWM_Drawer/SERV/TLM/TLM_interface.h"
+
+/* Private defines -----------------------------------------------------------*/
+#define SCREEN_PAGES_MAX (255U)
+
+/* Private types -------------------------------------------------------------*/
+/**
+ * @brief Receiver state, from the sync bytes to the CRC.
+ */
+typedef struct
+{
+	uint8_t frame[TLM_FRAME_MAX];
+	uint16_t received;        /*!< Bytes of the current frame received */
+	uint16_t expected;        /*!< Frame size, known once the length is received */
+
+	int haveInfo;
+	uint32_t clockHz;
+	uint32_t tickRates[TLM_MAX_CHANNELS];
+	uint8_t channelCount;
+
+	int haveTime;
+	uint64_t time;            /*!< Unwrapped time stamp of the last record */
+
+	int haveSeq;
+	uint8_t nextSeq;
+
+	const char *screenPrefix;
+	uint8_t screen[SCREEN_PAGES_MAX][TLM_SCREEN_WIDTH_MAX];
+	uint8_t screenPageCount;
+	uint8_t screenWidth;
+	uint16_t screenNextPage;  /*!< Pages received in order since page 0 */
+	unsigned long screens;
+	unsigned long screenErrors;
+
+	unsigned long frames;
+	unsigned long records;
+	unsigned long crcErrors;
+	unsigned long seqGaps;
+	unsigned long dropped;    /*!< Records flagged TLM_FLAG_DROPPED */
+	uint32_t lost;            /*!< Records lost reported by the last information frame */
+} Decoder_t;
+
+/* Private functions ---------------------------------------------------------*/
+/**
+ * @brief  Reads a 16-bit little-endian value.
+ */
+static uint16_t Get_U16(const uint8_t *src)
+{
+	return (uint16_t)(src[0] | (src[1] << 8));
+}
+
+/**
+ * @brief  Reads a 32-bit little-endian value.
+ */
+static uint32_t Get_U32(const uint8_t *src)
+{
+	return (uint32_t)src[0] | ((uint32_t)src[1] << 8) | ((uint32_t)src[2] << 16) | ((uint32_t)src[3] << 24);
+}
+
+/**
+ * @brief  Prints the CSV line of a record.
+ */
+static void Decode_Record(Decoder_t *dec, const uint8_t *src)
+{
+	uint32_t timestamp = Get_U32(&src[0]);
+	uint16_t period = Get_U16(&src[4]);
+	uint16_t high = Get_U16(&src[6]);
+	uint8_t flags = src[8];
+	uint8_t channel = flags & TLM_FLAG_CH_MASK;
+
+	// Forward difference modulo 2^32 from the previous record
+	if (!dec->haveTime)
+	{
+		dec->time = timestamp;
+		dec->haveTime = 1;
+	}
+	else
+	{
+		dec->time += (uint32_t)(timestamp - (uint32_t)dec->time);
+	}
+
+	if (flags & TLM_FLAG_DROPPED)
+	{
+		dec->dropped++;
+	}
+	dec->records++;
+
+	printf("%u,", channel);
+	if (dec->haveInfo && dec->clockHz != 0)
+	{
+		printf("%.9f", (double)dec->time / dec->clockHz);
+	}
+	printf(",%u,%u,", period, high);
+	if (dec->haveInfo && channel < dec->channelCount && period != 0)
+	{
+		printf("%.3f", (double)dec->tickRates[channel] / period);
+	}
+	printf(",%.2f,0x%02X\n", (period != 0) ? (100.0 * high / period) : 0.0, flags);
+}
+
+/**
+ * @brief  Applies an information frame.
+ */
+static void Decode_Info(Decoder_t *dec, const uint8_t *payload, uint8_t length)
+{
+	uint8_t channels;
+
+	if (length < 11U)
+	{
+		return;
+	}
+
+	channels = payload[10];
+	if (channels > TLM_MAX_CHANNELS || length < 11U + 8U * channels)
+	{
+		return;
+	}
+
+	dec->clockHz = Get_U32(&payload[0]);
+	dec->lost = Get_U32(&payload[4]);
+	dec->channelCount = channels;
+	for (uint8_t i = 0; i < channels; i++)
+	{
+		dec->tickRates[i] = Get_U32(&payload[11U + 8U * i]);
+	}
+	dec->haveInfo = 1;
+
+	fprintf(stderr, "info: clock %u Hz, ISR load %.1f%%, lost %u", (unsigned)dec->clockHz,
+			Get_U16(&payload[8]) / 10.0, (unsigned)dec->lost);
+	for (uint8_t i = 0; i < channels; i++)
+	{
+		fprintf(stderr, ", ch%u %u Hz %u overcaptures", i, (unsigned)dec->tickRates[i],
+				(unsigned)Get_U32(&payload[15U + 8U * i]));
+	}
+	fprintf(stderr, "\n");
+}
+
+/**
+ * @brief  Writes the screenshot received as a binary PBM image, 1 being a lit pixel.
+ */
+static void Write_Screen(Decoder_t *dec)
+{
+	char name[256];
+	FILE *file;
+
+	snprintf(name, sizeof(name), "%s%03lu.pbm", dec->screenPrefix, dec->screens);
+	file = fopen(name, "wb");
+	if (file == NULL)
+	{
+		perror(name);
+		return;
+	}
+
+	fprintf(file, "P4\n%u %u\n", dec->screenWidth, dec->screenPageCount * 8U);
+	for (uint16_t row = 0; row < dec->screenPageCount * 8U; row++)
+	{
+		uint8_t packed = 0;
+
+		// The pages hold 8 rows per column byte, PBM rows are packed 8 columns per byte
+		for (uint16_t x = 0; x < dec->screenWidth; x++)
+		{
+			packed = (uint8_t)(packed << 1) | ((dec->screen[row / 8U][x] >> (row % 8U)) & 1U);
+			if (x % 8U == 7U)
+			{
+				fputc(packed, file);
+				packed = 0;
+			}
+		}
+		if (dec->screenWidth % 8U)
+		{
+			fputc((uint8_t)(packed << (8U - dec->screenWidth % 8U)), file);
+		}
+	}
+	fclose(file);
+
+	fprintf(stderr, "screen: %s\n", name);
+	dec->screens++;
+}
+
+/**
+ * @brief  Expands a screenshot page, the screenshot is written once its last page is received.
+ */
+static void Decode_Screen(Decoder_t *dec, const uint8_t *payload, uint8_t length)
+{
+	uint8_t page, pageCount, width;
+	uint16_t in = TLM_SCREEN_HEADER_SIZE;
+	uint16_t out = 0;
+
+	if (length < TLM_SCREEN_HEADER_SIZE)
+	{
+		return;
+	}
+
+	page = payload[0];
+	pageCount = payload[1];
+	width = payload[2];
+	if (page >= pageCount || width == 0 || width > TLM_SCREEN_WIDTH_MAX)
+	{
+		dec->screenErrors++;
+		return;
+	}
+
+	// A screenshot starts over at page 0, pages missing in between invalidate it
+	if (page == 0)
+	{
+		if (dec->screenNextPage != 0)
+		{
+			dec->screenErrors++;
+		}
+		dec->screenPageCount = pageCount;
+		dec->screenWidth = width;
+		dec->screenNextPage = 0;
+	}
+	if (page != dec->screenNextPage || pageCount != dec->screenPageCount || width != dec->screenWidth)
+	{
+		if (dec->screenNextPage != 0)
+		{
+			dec->screenErrors++;
+		}
+		dec->screenNextPage = 0;
+		return;
+	}
+
+	// PackBits: n + 1 literal bytes for n < 128, the next byte 257 - n times for n > 128
+	while (in < length && out < width)
+	{
+		uint8_t control = payload[in++];
+
+		if (control < 128U)
+		{
+			for (uint16_t i = 0; i <= control && in < length && out < width; i++)
+			{
+				dec->screen[page][out++] = payload[in++];
+			}
+		}
+		else if (control > 128U && in < length)
+		{
+			uint8_t value = payload[in++];
+
+			for (uint16_t i = 0; i < 257U - control && out < width; i++)
+			{
+				dec->screen[page][out++] = value;
+			}
+		}
+	}
+	if (out != width || in != length)
+	{
+		dec->screenErrors++;
+		dec->screenNextPage = 0;
+		return;
+	}
+
+	dec->screenNextPage++;
+	if (dec->screenNextPage == pageCount)
+	{
+		Write_Screen(dec);
+		dec->screenNextPage = 0;
+	}
+}
+
+/**
+ * @brief  Checks and decodes a complete frame.
+ * @retval 1 if the frame is valid, 0 otherwise
+ */
+static int Decode_Frame(Decoder_t *dec)
+{
+	uint8_t type = dec->frame[2];
+	uint8_t seq = dec->frame[3];
+	uint8_t length = dec->frame[TLM_LENGTH_INDEX];
+	const uint8_t *payload = &dec->frame[TLM_HEADER_SIZE];
+
+	if (TLM_Crc16(&dec->frame[2], 3U + length) != Get_U16(&payload[length]))
+	{
+		dec->crcErrors++;
+		return 0;
+	}
+
+	if (dec->haveSeq && seq != dec->nextSeq)
+	{
+		dec->seqGaps++;
+	}
+	dec->nextSeq = (uint8_t)(seq + 1U);
+	dec->haveSeq = 1;
+	dec->frames++;
+
+	if (type == TLM_FRAME_RECORDS)
+	{
+		for (uint16_t offset = 0; offset + TLM_RECORD_SIZE <= length; offset += TLM_RECORD_SIZE)
+		{
+			Decode_Record(dec, &payload[offset]);
+		}
+	}
+	else if (type == TLM_FRAME_INFO)
+	{
+		Decode_Info(dec, payload, length);
+	}
+	else if (type == TLM_FRAME_SCREEN)
+	{
+		Decode_Screen(dec, payload, length);
+	}
+
+	return 1;
+}
+
+/**
+ * @brief  Feeds a received byte, the bytes after the sync of a bad frame are searched again.
+ */
+static void Decode_Byte(Decoder_t *dec, uint8_t byte)
+{
+	uint16_t start;
+
+	dec->frame[dec->received++] = byte;
+
+	if (dec->received == 1U && byte != TLM_SYNC_0)
+	{
+		dec->received = 0;
+		return;
+	}
+	if (dec->received == 2U && byte != TLM_SYNC_1)
+	{
+		dec->received = (byte == TLM_SYNC_0) ? 1U : 0U;
+		return;
+	}
+	if (dec->received == TLM_HEADER_SIZE)
+	{
+		if (byte > TLM_PAYLOAD_MAX)
+		{
+			dec->expected = 0;
+		}
+		else
+		{
+			dec->expected = TLM_HEADER_SIZE + byte + TLM_CRC_SIZE;
+		}
+	}
+	if (dec->received < TLM_HEADER_SIZE || (dec->expected != 0 && dec->received < dec->expected))
+	{
+		return;
+	}
+
+	if (dec->expected != 0 && Decode_Frame(dec))
+	{
+		dec->received = 0;
+		return;
+	}
+
+	// Invalid frame: look for the next sync in what was received after the first byte
+	if (dec->expected == 0)
+	{
+		dec->crcErrors++;
+	}
+	start = dec->received;
+	for (uint16_t i = 1; i < start; i++)
+	{
+		if (dec->frame[i] == TLM_SYNC_0)
+		{
+			uint16_t rest = start - i;
+
+			dec->received = 0;
+			dec->expected = 0;
+			for (uint16_t j = 0; j < rest; j++)
+			{
+				uint8_t replay = dec->frame[i + j];
+				Decode_Byte(dec, replay);
+			}
+			return;
+		}
+	}
+	dec->received = 0;
+	dec->expected = 0;
+}
+
+int main(int argc, char **argv)
+{
+	static Decoder_t dec;
+	FILE *input = stdin;
+	int arg = 1;
+	int c;
+
+	dec.screenPrefix = "screen";
+	if (argc > arg + 1 && strcmp(argv[arg], "-s") == 0)
+	{
+		dec.screenPrefix = argv[arg + 1];
+		arg += 2;
+	}
+
+	if (argc > arg)
+	{
+		input = fopen(argv[arg], "rb");
+		if (input == NULL)
+		{
+			perror(argv[arg]);
+			return 1;
+		}
+	}
+
+	printf("channel,time_s,period_ticks,high_ticks,frequency_hz,duty_pct,flags\n");
+
+	while ((c = fgetc(input)) != EOF)
+	{
+		Decode_Byte(&dec, (uint8_t)c);
+	}
+
+	fprintf(stderr, "%lu frames, %lu records, %lu CRC errors, %lu sequence gaps, %lu drops flagged, %u records lost\n",
+			dec.frames, dec.records, dec.crcErrors, dec.seqGaps, dec.dropped, (unsigned)dec.lost);
+	fprintf(stderr, "%lu screenshots, %lu incomplete\n", dec.screens, dec.screenErrors);
+
+	return (dec.crcErrors != 0 || dec.seqGaps != 0) ? 2 : 0;
+}